@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+
+#include <cpuinfo.h>
+
+
+static void get_frequency_sample(benchmark::State& state) {
+	if (cpuinfo_frequency_monitor_start(0) == cpuinfo_frequency_source_none) {
+		state.SkipWithError("frequency monitoring is not supported");
+		return;
+	}
+	cpuinfo_frequency_monitor_sample();
+
+	cpuinfo_frequency_sample sample;
+	while (state.KeepRunning()) {
+		benchmark::DoNotOptimize(cpuinfo_get_frequency_sample(0, &sample));
+	}
+	cpuinfo_frequency_monitor_stop();
+}
+BENCHMARK(get_frequency_sample);
+
+static void get_frequency_history(benchmark::State& state) {
+	if (cpuinfo_frequency_monitor_start(0) == cpuinfo_frequency_source_none) {
+		state.SkipWithError("frequency monitoring is not supported");
+		return;
+	}
+	for (uint32_t k = 0; k <= CPUINFO_FREQUENCY_MONITOR_HISTORY; k++) {
+		cpuinfo_frequency_monitor_sample();
+	}
+
+	cpuinfo_frequency_sample samples[CPUINFO_FREQUENCY_MONITOR_HISTORY];
+	while (state.KeepRunning()) {
+		benchmark::DoNotOptimize(cpuinfo_get_frequency_history(0, samples, CPUINFO_FREQUENCY_MONITOR_HISTORY));
+	}
+	cpuinfo_frequency_monitor_stop();
+}
+BENCHMARK(get_frequency_history);
+
+/* Cost of one sampling pass over all logical processors, as paid by the background thread every period */
+static void sample_all_processors(benchmark::State& state) {
+	const cpuinfo_frequency_source source = cpuinfo_frequency_monitor_start(0);
+	if (source == cpuinfo_frequency_source_none) {
+		state.SkipWithError("frequency monitoring is not supported");
+		return;
+	}
+
+	while (state.KeepRunning()) {
+		cpuinfo_frequency_monitor_sample();
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(cpuinfo_processors_count));
+	state.SetLabel(source == cpuinfo_frequency_source_aperf_mperf ? "APERF/MPERF" : "cpufreq");
+	cpuinfo_frequency_monitor_stop();
+}
+BENCHMARK(sample_all_processors)->UseRealTime();
+
+BENCHMARK_MAIN();
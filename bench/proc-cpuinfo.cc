@@ -0,0 +1,34 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstdlib>
+
+#include <cpuinfo.h>
+#include <cpuinfo-mock.h>
+
+
+/* Internal parser entry point. The parsed records are opaque to the benchmark. */
+extern "C" struct proc_cpuinfo* cpuinfo_arm_linux_parse_proc_cpuinfo(uint32_t* processors_count);
+
+static void parse_proc_cpuinfo(benchmark::State& state, const char* path) {
+	cpuinfo_set_proc_cpuinfo_path(path);
+
+	uint32_t processors_count = 0;
+	while (state.KeepRunning()) {
+		struct proc_cpuinfo* processors = cpuinfo_arm_linux_parse_proc_cpuinfo(&processors_count);
+		if (processors == NULL) {
+			state.SkipWithError("failed to parse /proc/cpuinfo log");
+			return;
+		}
+		free(processors);
+	}
+	state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(processors_count));
+}
+/* Logs are found relative to the source root, and the benchmark must run from it */
+BENCHMARK_CAPTURE(parse_proc_cpuinfo, raspberrypi3, "test/cpuinfo/raspberrypi3.log");
+BENCHMARK_CAPTURE(parse_proc_cpuinfo, nexus9, "test/cpuinfo/nexus9.log");
+BENCHMARK_CAPTURE(parse_proc_cpuinfo, galaxy_s8_us, "test/cpuinfo/galaxy-s8-us.log");
+BENCHMARK_CAPTURE(parse_proc_cpuinfo, graviton2, "test/cpuinfo/graviton2.log");
+BENCHMARK_CAPTURE(parse_proc_cpuinfo, graviton3, "test/cpuinfo/graviton3.log");
+
+BENCHMARK_MAIN();
@@ -22,11 +22,11 @@ def main(args):
     build.export_cpath("include", ["cpuinfo.h"])
 
     with build.options(source_dir="src", macros=macros, extra_include_dirs="src"):
-        sources = ["init.c", "cache.c", "log.c"]
+        sources = ["init.c", "arena.c", "cache.c", "blocking.c", "qos.c", "frequency.c", "core-type.c", "isa-level.c", "uarch-info.c", "log.c"]
         if build.target.is_x86_64:
             sources += [
                 "x86/init.c", "x86/info.c", "x86/vendor.c", "x86/uarch.c", "x86/topology.c",
-                "x86/cache/init.c", "x86/cache/descriptor.c", "x86/cache/deterministic.c",
+                "x86/cache/init.c", "x86/cache/descriptor.c", "x86/cache/deterministic.c", "x86/qos.c", "x86/tsc.c", "x86/hypervisor.c", "x86/amx.c", "x86/xsave.c", "x86/cost.c",
             ]
             if build.target.is_macos:
                 sources += ["x86/mach/init.c"]
@@ -38,17 +38,18 @@ def main(args):
             if build.target.is_linux:
                 sources += [
                     "arm/linux/init.c",
-                    "arm/linux/cpuinfo.c"
+                    "arm/linux/cpuinfo.c",
+                    "arm/linux/midr.c"
                 ]
                 if build.target.is_arm:
                     sources.append("arm/linux/arm32-isa.c")
                 elif build.target.is_arm64:
-                    sources.append("arm/linux/arm64-isa.c")
+                    sources += ["arm/linux/arm64-isa.c", "arm/linux/sve.c"]
 
         if build.target.is_macos:
             sources += ["mach/topology.c"]
         if build.target.is_linux:
-            sources += ["linux/cpuset.c"]
+            sources += ["linux/cpuset.c", "linux/sysfs.c", "linux/resctrl.c", "linux/cpufreq.c", "linux/monitor.c", "linux/online.c", "linux/cgroup.c", "linux/isolation.c"]
         build.static_library("cpuinfo", map(build.cc, sources))
 
     with build.options(source_dir="tools", deps=build):
@@ -58,8 +59,24 @@ def main(args):
 
     with build.options(source_dir="test", deps=[build, build.deps.googletest]):
         build.smoketest("init-test", build.cxx("init.cc"))
+        if build.target.is_linux:
+            build.unittest("cpuset-fuzz-test", build.cxx("cpuset-fuzz.cc"))
         if options.mock:
             with build.options(macros={"CPUINFO_MOCK": int(options.mock)}):
+                if build.target.is_linux:
+                    build.unittest("cgroup-test", build.cxx("cgroup.cc"))
+                    build.unittest("isolation-test", build.cxx("isolation.cc"))
+
+                if build.target.is_x86_64 and build.target.is_linux:
+                    build.unittest("xeon-gold-6148-test", build.cxx("xeon-gold-6148.cc"))
+                    build.unittest("core-i7-1065g7-test", build.cxx("core-i7-1065g7.cc"))
+                    build.unittest("xeon-platinum-8480-test", build.cxx("xeon-platinum-8480.cc"))
+                    build.unittest("ryzen-9-7950x-test", build.cxx("ryzen-9-7950x.cc"))
+                    build.unittest("core-i9-12900k-test", build.cxx("core-i9-12900k.cc"))
+                    build.unittest("restricted-cpuset-test", build.cxx("restricted-cpuset.cc"))
+                    build.unittest("online-test", build.cxx("online.cc"))
+                    build.unittest("hypervisor-test", build.cxx("hypervisor.cc"))
+
                 if build.target.is_arm and build.target.is_linux:
                     build.unittest("raspberry-pi-test", build.cxx("raspberry-pi.cc"))
                     build.unittest("raspberry-pi-zero-test", build.cxx("raspberry-pi-zero.cc"))
@@ -79,6 +96,20 @@ def main(args):
                     build.unittest("jetson-tx1-test", build.cxx("jetson-tx1.cc"))
                     build.unittest("nexus9-test", build.cxx("nexus9.cc"))
                     build.unittest("scaleway-test", build.cxx("scaleway.cc"))
+                    build.unittest("galaxy-s8-us-test", build.cxx("galaxy-s8-us.cc"))
+                    build.unittest("msm8996-test", build.cxx("msm8996.cc"))
+                    build.unittest("proc-cpuinfo-fuzz-test", build.cxx("proc-cpuinfo-fuzz.cc"))
+
+                if build.target.is_arm64 and build.target.is_linux:
+                    build.unittest("graviton2-test", build.cxx("graviton2.cc"))
+                    build.unittest("graviton3-test", build.cxx("graviton3.cc"))
+
+    with build.options(source_dir="bench", deps=[build, build.deps.googlebenchmark]):
+        if build.target.is_linux:
+            build.benchmark("frequency-monitor-bench", build.cxx("frequency-monitor.cc"))
+        if options.mock and (build.target.is_arm or build.target.is_arm64) and build.target.is_linux:
+            with build.options(macros={"CPUINFO_MOCK": int(options.mock)}):
+                build.benchmark("proc-cpuinfo-bench", build.cxx("proc-cpuinfo.cc"))
 
     return build
 
@@ -2,6 +2,9 @@
 #ifndef CPUINFO_MOCK_H
 #define CPUINFO_MOCK_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <cpuinfo.h>
 
 #if !defined(CPUINFO_MOCK) || !(CPUINFO_MOCK)
@@ -14,15 +17,46 @@ extern "C" {
 #endif
 
 
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+	struct cpuinfo_mock_cpuid {
+		uint32_t input_eax;
+		uint32_t input_ecx;
+		uint32_t eax;
+		uint32_t ebx;
+		uint32_t ecx;
+		uint32_t edx;
+	};
+
+	void CPUINFO_ABI cpuinfo_set_cpuid(const struct cpuinfo_mock_cpuid* dump, size_t entries);
+	void CPUINFO_ABI cpuinfo_set_xcr0(uint64_t xcr0);
+	/* Overrides the dump on one Linux processor; the library does not pin threads to processors with a dump */
+	void CPUINFO_ABI cpuinfo_set_processor_cpuid(int linux_id, const struct cpuinfo_mock_cpuid* dump, size_t entries);
+#endif /* CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64 */
+
 #if CPUINFO_ARCH_ARM
 	void CPUINFO_ABI cpuinfo_set_fpsid(uint32_t fpsid);
 	void CPUINFO_ABI cpuinfo_set_wcid(uint32_t wcid);
 #endif /* CPUINFO_ARCH_ARM */
 
+#if defined(__linux__)
+	void CPUINFO_ABI cpuinfo_set_resctrl_path(const char* path);
+	void CPUINFO_ABI cpuinfo_set_sysfs_cpu_path(const char* path);
+	void CPUINFO_ABI cpuinfo_set_cgroup_path(const char* path);
+	void CPUINFO_ABI cpuinfo_set_proc_self_cgroup_path(const char* path);
+	void CPUINFO_ABI cpuinfo_set_proc_cmdline_path(const char* path);
+#endif
+
 #if (CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64) && defined(__linux__)
 	void CPUINFO_ABI cpuinfo_set_proc_cpuinfo_path(const char* path);
 #endif
 
+#if CPUINFO_ARCH_ARM64 && defined(__linux__)
+	void CPUINFO_ABI cpuinfo_set_hwcap(uint32_t hwcap);
+	void CPUINFO_ABI cpuinfo_set_hwcap2(uint64_t hwcap2);
+	void CPUINFO_ABI cpuinfo_set_proc_sys_abi_path(const char* path);
+	void CPUINFO_ABI cpuinfo_set_sve_max_vector_length(uint32_t max_vector_length);
+#endif
+
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -138,6 +138,14 @@
 		bool avx512vpopcntdq;
 		bool avx512_4vnniw;
 		bool avx512_4fmaps;
+		bool avx512vbmi2;
+		bool avx512bitalg;
+		bool avx512vnni;
+		bool avx512bf16;
+		bool avx_vnni;
+		bool amx_tile;
+		bool amx_int8;
+		bool amx_bf16;
 		bool hle;
 		bool rtm;
 		bool xtest;
@@ -161,6 +169,9 @@
 		bool adx;
 		bool aes;
 		bool pclmulqdq;
+		bool gfni;
+		bool vaes;
+		bool vpclmulqdq;
 		bool rdrand;
 		bool rdseed;
 		bool sha;
@@ -185,6 +196,152 @@
 		uint32_t extended_family;
 		uint32_t processor_type;
 	};
+
+	/** Time Stamp Counter (TSC) properties */
+	struct cpuinfo_tsc {
+		/** Frequency of the time stamp counter in Hz, or 0 if unknown */
+		uint64_t frequency;
+		/** Frequency of the core crystal clock in Hz, or 0 if not reported */
+		uint64_t crystal_frequency;
+		/** Processor base frequency in Hz, or 0 if not reported */
+		uint64_t base_frequency;
+		/** Maximum processor frequency in Hz, or 0 if not reported */
+		uint64_t max_frequency;
+		/** Bus (reference) frequency in Hz, or 0 if not reported */
+		uint64_t bus_frequency;
+		/** The counter runs at a constant rate in all ACPI P-, C- and T-states */
+		bool invariant;
+		/** The frequency was measured against the system clock rather than reported by the processor */
+		bool calibrated;
+	};
+
+	/** Geometry of Advanced Matrix Extensions (AMX) tiles and tile matrix multiply unit */
+	struct cpuinfo_amx {
+		/** Highest supported tile palette, or 0 if AMX is not supported */
+		uint32_t max_palette;
+		/** Number of tile registers in palette 1 */
+		uint32_t tiles;
+		/** Maximum number of rows in a tile */
+		uint32_t max_rows;
+		/** Maximum number of bytes in a tile row */
+		uint32_t bytes_per_row;
+		/** Size of one tile register in bytes */
+		uint32_t bytes_per_tile;
+		/** Total size of all tile registers in bytes */
+		uint32_t total_tile_bytes;
+		/** Maximum number of rows of the second operand (K dimension) in tile matrix multiply */
+		uint32_t tmul_max_k;
+		/** Maximum number of bytes in a row of the second operand (N dimension) in tile matrix multiply */
+		uint32_t tmul_max_n;
+	};
+
+	/** Maximum number of XSAVE state components */
+	#define CPUINFO_XSAVE_MAX_COMPONENTS 64
+
+	/** Properties of the XSAVE area and instructions */
+	struct cpuinfo_xsave {
+		/** Bitmask of user state components enabled by the OS in XCR0 */
+		uint64_t enabled_components;
+		/** Bitmask of user state components supported by the processor */
+		uint64_t supported_components;
+		/** Bitmask of supervisor state components supported by the processor (managed by the OS via IA32_XSS) */
+		uint64_t supervisor_components;
+		/** Size in bytes of the standard-format XSAVE area for the state components enabled in XCR0 */
+		uint32_t enabled_size;
+		/** Size in bytes of the standard-format XSAVE area for all supported user state components */
+		uint32_t max_size;
+		/** Size in bytes of the compacted-format area written by XSAVEC for the state components enabled in XCR0 */
+		uint32_t compacted_size;
+		/** XSAVEOPT instruction is supported */
+		bool xsaveopt;
+		/** XSAVEC instruction and the compacted format are supported */
+		bool xsavec;
+		/** XGETBV with ECX = 1 (XINUSE bitmap) is supported */
+		bool xgetbv1;
+		/** XSAVES/XRSTORS instructions are supported (usable only by the OS) */
+		bool xsaves;
+		/** Extended feature disable (XFD) is supported */
+		bool xfd;
+	};
+
+	/** Location of one state component in the XSAVE area */
+	struct cpuinfo_xsave_component {
+		/** Size of the state component in bytes, or 0 if the component is not supported */
+		uint32_t size;
+		/** Offset of the state component from the start of the standard-format XSAVE area, 0 for supervisor components */
+		uint32_t offset;
+		/** Offset of the state component in the compacted-format area written by XSAVEC, 0 if not enabled in XCR0 */
+		uint32_t compacted_offset;
+		/** The component is a supervisor state component */
+		bool supervisor;
+		/** The component is aligned on a 64-byte boundary in the compacted format */
+		bool aligned;
+		/** The component supports extended feature disable (XFD) */
+		bool xfd;
+	};
+
+	/** Performance-critical x86 instructions with microarchitecture-dependent cost */
+	enum cpuinfo_x86_instruction {
+		/** POPCNT r64, r64 */
+		cpuinfo_x86_instruction_popcnt_r64 = 0,
+		/** LZCNT r64, r64 */
+		cpuinfo_x86_instruction_lzcnt_r64,
+		/** TZCNT r64, r64 */
+		cpuinfo_x86_instruction_tzcnt_r64,
+		/** PDEP r64, r64, r64 */
+		cpuinfo_x86_instruction_pdep_r64,
+		/** PEXT r64, r64, r64 */
+		cpuinfo_x86_instruction_pext_r64,
+		/** IMUL r64, r64 */
+		cpuinfo_x86_instruction_imul_r64,
+		/** MULX r64, r64, r64 */
+		cpuinfo_x86_instruction_mulx_r64,
+		/** ADCX r64, r64 */
+		cpuinfo_x86_instruction_adcx_r64,
+		/** CRC32 r64, r64 */
+		cpuinfo_x86_instruction_crc32_r64,
+		/** PSHUFB xmm, xmm */
+		cpuinfo_x86_instruction_pshufb_xmm,
+		/** VPSHUFB ymm, ymm, ymm */
+		cpuinfo_x86_instruction_vpshufb_ymm,
+		/** VPERMD ymm, ymm, ymm */
+		cpuinfo_x86_instruction_vpermd_ymm,
+		/** VPERMPS ymm, ymm, ymm */
+		cpuinfo_x86_instruction_vpermps_ymm,
+		/** VPERMB zmm, zmm, zmm */
+		cpuinfo_x86_instruction_vpermb_zmm,
+		/** VPGATHERDD ymm, [vsib ymm], ymm with data in L1 cache */
+		cpuinfo_x86_instruction_vpgatherdd_ymm,
+		/** VFMADD231PS ymm, ymm, ymm */
+		cpuinfo_x86_instruction_vfmadd_ps_ymm,
+		/** VFMADD231PS zmm, zmm, zmm */
+		cpuinfo_x86_instruction_vfmadd_ps_zmm,
+		/** VPMADDUBSW ymm, ymm, ymm */
+		cpuinfo_x86_instruction_vpmaddubsw_ymm,
+		/** VPMADDWD ymm, ymm, ymm */
+		cpuinfo_x86_instruction_vpmaddwd_ymm,
+		/** AESENC xmm, xmm */
+		cpuinfo_x86_instruction_aesenc_xmm,
+		/** PCLMULQDQ xmm, xmm, imm8 */
+		cpuinfo_x86_instruction_pclmulqdq_xmm,
+		/** VDIVPS ymm, ymm, ymm */
+		cpuinfo_x86_instruction_vdivps_ymm,
+		/** Number of instructions in the enumeration (not an instruction) */
+		cpuinfo_x86_instruction_count,
+	};
+
+	/** Execution cost of an instruction on a microarchitecture */
+	struct cpuinfo_x86_instruction_cost {
+		/** Latency from register inputs to the output, in cycles, or 0 if unknown */
+		uint32_t latency;
+		/**
+		 * Reciprocal throughput in hundredths of a cycle (e.g. 50 for two instructions per cycle), or 0 if unknown.
+		 * Both values are for typical inputs where cost depends on input data.
+		 */
+		uint32_t reciprocal_throughput;
+		/** The instruction is implemented in microcode, and its cost may vary widely with input data */
+		bool microcoded;
+	};
 #endif
 
 #if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
@@ -215,8 +372,29 @@
 			bool atomics;
 			bool rdm;
 			bool fp16arith;
+			bool fhm;
+			bool dot;
 			bool jscvt;
 			bool fcma;
+			bool lrcpc;
+			bool lrcpc2;
+			bool dcpop;
+			bool dcpodp;
+			bool flagm;
+			bool flagm2;
+			bool frint;
+			bool sb;
+			bool i8mm;
+			bool bf16;
+			bool sve;
+			bool sve2;
+			bool svebf16;
+			bool svei8mm;
+			bool sme;
+			bool sha3;
+			bool sha512;
+			bool sm3;
+			bool sm4;
 		#endif
 
 		bool aes;
@@ -237,6 +415,8 @@
 #define CPUINFO_CACHE_UNIFIED          0x00000001
 #define CPUINFO_CACHE_INCLUSIVE        0x00000002
 #define CPUINFO_CACHE_COMPLEX_INDEXING 0x00000004
+/** The cache holds only lines evicted from the inner level (victim cache), and never duplicates them */
+#define CPUINFO_CACHE_EXCLUSIVE        0x00000008
 
 enum cpuinfo_cache_level {
 	cpuinfo_cache_level_1i  = 0,
@@ -259,9 +439,10 @@ struct cpuinfo_cache {
 	/** Line size in bytes */
 	uint32_t line_size;
 	/**
-	 * Binary characteristics of the cache (unified cache, inclusive cache, cache with complex indexing).
+	 * Binary characteristics of the cache (unified cache, inclusive cache, cache with complex indexing,
+	 * exclusive cache). Caches with neither inclusive nor exclusive flag are non-inclusive.
 	 *
-	 * @see CPUINFO_CACHE_UNIFIED, CPUINFO_CACHE_INCLUSIVE, CPUINFO_CACHE_COMPLEX_INDEXING
+	 * @see CPUINFO_CACHE_UNIFIED, CPUINFO_CACHE_INCLUSIVE, CPUINFO_CACHE_COMPLEX_INDEXING, CPUINFO_CACHE_EXCLUSIVE
 	 */
 	uint32_t flags;
 	/** Index of the first logical processor that shares this cache */
@@ -280,6 +461,93 @@ struct cpuinfo_trace_cache {
 	uint32_t associativity;
 };
 
+/** Pattern of data reuse within a cache block */
+enum cpuinfo_reuse {
+	/**
+	 * Data in a block is consumed once.
+	 * The block only needs to stay resident while the next block is being brought in.
+	 */
+	cpuinfo_reuse_streaming = 0,
+	/** All streams in a block are repeatedly accessed and must stay resident together. */
+	cpuinfo_reuse_temporal  = 1,
+};
+
+/** Description of the data accessed by a blocked loop nest */
+struct cpuinfo_working_set {
+	/** Size of a single element in bytes */
+	uint32_t element_size;
+	/** Number of arrays (streams) concurrently accessed within a block */
+	uint32_t streams;
+	/** Pattern of data reuse within a block */
+	enum cpuinfo_reuse reuse;
+	/**
+	 * Number of hardware threads on each core that concurrently run the blocked code.
+	 * Zero means that all SMT threads of a core are busy. Ignored on virtual machines with untrusted topology,
+	 * where SMT siblings of a virtual processor are unknown and may run threads of other guests.
+	 */
+	uint32_t smt_threads;
+};
+
+/** Recommended block sizes, in elements per stream, for each cache level */
+struct cpuinfo_blocking {
+	/** Block size for L1 data cache, or 0 if the cache is not present */
+	uint32_t l1;
+	/** Block size for L2 cache, or 0 if the cache is not present */
+	uint32_t l2;
+	/** Block size for L3 cache, or 0 if the cache is not present */
+	uint32_t l3;
+};
+
+/** Cache allocation capabilities (Intel CAT, AMD L3 allocation enforcement) for one cache level */
+struct cpuinfo_cache_allocation {
+	/** Number of classes of service, or 0 if cache allocation is not supported for this cache level */
+	uint32_t classes;
+	/** Number of bits in the capacity bitmask */
+	uint32_t bitmask_length;
+	/** Bitmask of capacity bits which may also be used by other agents, such as I/O devices */
+	uint32_t shareable_bits;
+	/** Number of cache ways controlled by one bit of the capacity bitmask, or 0 if unknown */
+	uint32_t ways_per_bit;
+	/** Number of bytes in one cache instance controlled by one bit of the capacity bitmask, or 0 if unknown */
+	uint32_t bytes_per_bit;
+	/** Separate capacity bitmasks for code and data (Code and Data Prioritization) are supported */
+	bool cdp;
+};
+
+/** Memory bandwidth allocation capabilities (Intel MBA, AMD L3 external bandwidth enforcement) */
+struct cpuinfo_bandwidth_allocation {
+	/** Number of classes of service, or 0 if memory bandwidth allocation is not supported */
+	uint32_t classes;
+	/** Maximum throttling value (percent on Intel), or maximum bandwidth limit value (AMD) */
+	uint32_t max_throttling;
+	/** Granularity of bandwidth settings in percent, or 0 if unknown */
+	uint32_t granularity;
+	/** Throttling values are linear in bandwidth */
+	bool linear;
+};
+
+/** Last-level cache monitoring capabilities (Intel CMT/MBM, AMD L3 monitoring) */
+struct cpuinfo_cache_monitoring {
+	/** Number of resource monitoring IDs, or 0 if monitoring is not supported */
+	uint32_t rmids;
+	/** Multiplier which converts counter values to bytes */
+	uint32_t upscaling_factor;
+	/** Occupancy of the cache can be monitored */
+	bool occupancy;
+	/** Total memory bandwidth can be monitored */
+	bool total_bandwidth;
+	/** Local memory bandwidth can be monitored */
+	bool local_bandwidth;
+};
+
+/** Platform quality of service (resource director) capabilities */
+struct cpuinfo_qos {
+	struct cpuinfo_cache_allocation l2;
+	struct cpuinfo_cache_allocation l3;
+	struct cpuinfo_bandwidth_allocation memory_bandwidth;
+	struct cpuinfo_cache_monitoring l3_monitoring;
+};
+
 #define CPUINFO_PAGE_SIZE_4KB  0x1000
 #define CPUINFO_PAGE_SIZE_1MB  0x100000
 #define CPUINFO_PAGE_SIZE_2MB  0x200000
@@ -440,6 +708,16 @@ enum cpuinfo_uarch {
 	cpuinfo_uarch_sky_lake     = 0x0010020A,
 	/** Intel Kaby Lake microarchitecture. */
 	cpuinfo_uarch_kaby_lake    = 0x0010020B,
+	/** Intel Golden Cove microarchitecture (performance cores of Alder Lake). */
+	cpuinfo_uarch_golden_cove  = 0x0010020C,
+	/** Intel Raptor Cove microarchitecture (performance cores of Raptor Lake). */
+	cpuinfo_uarch_raptor_cove  = 0x0010020D,
+	/** Intel Redwood Cove microarchitecture (performance cores of Meteor Lake). */
+	cpuinfo_uarch_redwood_cove = 0x0010020E,
+	/** Intel Sky Lake server microarchitecture (Xeon Scalable: Skylake-SP, Cascade Lake, Cooper Lake). */
+	cpuinfo_uarch_sky_lake_server = 0x0010020F,
+	/** Intel Golden Cove server microarchitecture (Sapphire Rapids, and Raptor Cove cores of Emerald Rapids). */
+	cpuinfo_uarch_golden_cove_server = 0x00100210,
 
 	/** Pentium 4 with Willamette, Northwood, or Foster cores. */
 	cpuinfo_uarch_willamette = 0x00100300,
@@ -454,6 +732,10 @@ enum cpuinfo_uarch {
 	cpuinfo_uarch_silvermont = 0x00100402,
 	/** Intel Airmont microarchitecture (14 nm out-of-order Atom). */
 	cpuinfo_uarch_airmont    = 0x00100403,
+	/** Intel Gracemont microarchitecture (efficiency cores of Alder Lake and Raptor Lake, Alder Lake-N). */
+	cpuinfo_uarch_gracemont  = 0x00100404,
+	/** Intel Crestmont microarchitecture (efficiency cores of Meteor Lake). */
+	cpuinfo_uarch_crestmont  = 0x00100405,
 
 	/** Intel Knights Ferry HPC boards. */
 	cpuinfo_uarch_knights_ferry   = 0x00100500,
@@ -495,6 +777,10 @@ enum cpuinfo_uarch {
 	cpuinfo_uarch_excavator   = 0x00200108,
 	/** AMD Zen microarchitecture (Ryzen CPUs). */
 	cpuinfo_uarch_zen         = 0x00200109,
+	/** AMD Zen 3 microarchitecture (Ryzen 5000 series, EPYC 7003 series). */
+	cpuinfo_uarch_zen3        = 0x0020010A,
+	/** AMD Zen 4 microarchitecture (Ryzen 7000 series, EPYC 9004 series). */
+	cpuinfo_uarch_zen4        = 0x0020010B,
 
 	/** NSC Geode and AMD Geode GX and LX. */
 	cpuinfo_uarch_geode  = 0x00200200,
@@ -566,6 +852,37 @@ enum cpuinfo_uarch {
 	cpuinfo_uarch_thunderx = 0x00800100,
 };
 
+/**
+ * Core type on hybrid processors, which combine cores of different microarchitectures in one package.
+ */
+enum cpuinfo_core_type {
+	/** Core type is not reported, or the processor is not hybrid. */
+	cpuinfo_core_type_unknown     = 0,
+	/** Performance core (Intel Core on hybrid Intel processors). */
+	cpuinfo_core_type_performance = 1,
+	/** Efficiency core (Intel Atom on hybrid Intel processors). */
+	cpuinfo_core_type_efficiency  = 2,
+};
+
+/**
+ * Performance characteristics of a core microarchitecture, for computed (rather than hard-coded) kernel selection.
+ * Zero values mean that the characteristic is unknown.
+ */
+struct cpuinfo_uarch_info {
+	/** Width, in bits, of the vector execution units */
+	uint32_t vector_width;
+	/** Number of vector_width-wide fused multiply-add operations issued per cycle, 0 if FMA is not supported */
+	uint32_t fma_per_cycle;
+	/** Peak bandwidth of loads from L1 data cache, in bytes per cycle */
+	uint32_t l1d_load_bytes_per_cycle;
+	/** Peak bandwidth of stores to L1 data cache, in bytes per cycle */
+	uint32_t l1d_store_bytes_per_cycle;
+	/** Vector instructions wider than vector_width are split into several vector_width-wide operations */
+	bool split_wide_vectors;
+	/** The widest vector instructions supported by the core reduce its frequency (e.g. AVX-512 frequency licenses) */
+	bool wide_vector_throttling;
+};
+
 struct cpuinfo_topology {
 	/** Thread (hyperthread, or SMT) ID within a core */
 	uint32_t thread_id;
@@ -581,9 +898,110 @@ struct cpuinfo_topology {
 	#endif
 };
 
+/** Group of logical processors which share frequency scaling (a cpufreq policy on Linux) */
+struct cpuinfo_frequency_domain {
+	/** Minimum frequency in Hz, or 0 if unknown */
+	uint64_t min_frequency;
+	/** Maximum frequency in Hz, including turbo frequencies, or 0 if unknown */
+	uint64_t max_frequency;
+	/** Base (guaranteed non-turbo) frequency in Hz, or 0 if unknown */
+	uint64_t base_frequency;
+	/** Number of logical processors in the frequency domain */
+	uint32_t processor_count;
+};
+
+struct cpuinfo_frequency_domains {
+	uint32_t count;
+	const struct cpuinfo_frequency_domain* instances;
+};
+
+#if defined(__linux__)
+	/** Number of most recent frequency samples kept for each logical processor */
+	#define CPUINFO_FREQUENCY_MONITOR_HISTORY 64
+
+	/** Source of effective frequency samples */
+	enum cpuinfo_frequency_source {
+		/** Frequency monitoring is not available */
+		cpuinfo_frequency_source_none = 0,
+		/** Ratio of APERF and MPERF counters, read through the msr device (x86 only) */
+		cpuinfo_frequency_source_aperf_mperf = 1,
+		/** Current frequency of the cpufreq policy (scaling_cur_freq) */
+		cpuinfo_frequency_source_cpufreq = 2,
+	};
+
+	struct cpuinfo_frequency_sample {
+		/** Time of the sample in nanoseconds, as reported by CLOCK_MONOTONIC */
+		uint64_t timestamp;
+		/**
+		 * Effective frequency in Hz.
+		 * With APERF/MPERF it is the average frequency in non-idle state since the previous sample.
+		 */
+		uint64_t frequency;
+	};
+#endif
+
+/** Isolated from scheduler load balancing (isolcpus): only threads pinned to the processor run on it */
+#define CPUINFO_ISOLATION_DOMAIN    0x00000001
+/** Adaptive-tick (nohz_full): the scheduler tick stops while only one task runs on the processor */
+#define CPUINFO_ISOLATION_NOHZ_FULL 0x00000002
+/** RCU callbacks of the processor are offloaded to kernel threads (rcu_nocbs) */
+#define CPUINFO_ISOLATION_RCU_NOCBS 0x00000004
+
+/** Roles of threads for placement by cpuinfo_get_role_processors */
+enum cpuinfo_thread_role {
+	/** Threads which tolerate preemption and interrupts, e.g. I/O, logging, and background work. */
+	cpuinfo_thread_role_housekeeping = 0,
+	/** Latency-critical threads, which should run alone on processors isolated by the kernel. */
+	cpuinfo_thread_role_latency      = 1,
+};
+
+/** Vendor of the hypervisor which runs the system as a virtual machine */
+enum cpuinfo_hypervisor_vendor {
+	/** No hypervisor is detected: the system runs on physical hardware, or detection is not supported. */
+	cpuinfo_hypervisor_vendor_none       = 0,
+	/** A hypervisor is present, but its signature is not recognized. */
+	cpuinfo_hypervisor_vendor_unknown    = 1,
+	/** Linux Kernel-based Virtual Machine, with any user-space monitor (QEMU, Firecracker, Cloud Hypervisor). */
+	cpuinfo_hypervisor_vendor_kvm        = 2,
+	/** Microsoft Hyper-V. KVM and Xen which emulate Hyper-V interfaces are reported as KVM and Xen. */
+	cpuinfo_hypervisor_vendor_hyperv     = 3,
+	/** Xen hypervisor, in HVM or PVH mode. */
+	cpuinfo_hypervisor_vendor_xen        = 4,
+	/** VMware ESXi, Workstation, or Fusion. */
+	cpuinfo_hypervisor_vendor_vmware     = 5,
+	/** Oracle VirtualBox. */
+	cpuinfo_hypervisor_vendor_virtualbox = 6,
+	/** QEMU with binary translation (TCG) instead of hardware virtualization. */
+	cpuinfo_hypervisor_vendor_qemu       = 7,
+	/** FreeBSD bhyve. */
+	cpuinfo_hypervisor_vendor_bhyve      = 8,
+	/** Project ACRN. */
+	cpuinfo_hypervisor_vendor_acrn       = 9,
+	/** Parallels Desktop. */
+	cpuinfo_hypervisor_vendor_parallels  = 10,
+};
+
+/** Properties of the virtual machine which runs the system */
+struct cpuinfo_hypervisor {
+	/** Vendor of the hypervisor, or cpuinfo_hypervisor_vendor_none on physical hardware */
+	enum cpuinfo_hypervisor_vendor vendor;
+	/** The hypervisor reports time when virtual processors were preempted on the host (steal time) */
+	bool steal_time;
+	/** Virtual processors run on dedicated host processors and are never preempted (KVM realtime hint) */
+	bool dedicated_processors;
+	/**
+	 * Reported topology matches the physical hardware. Hypervisors report arbitrary SMT siblings, cores, and cache
+	 * sharing, which need not match the host processors that actually run the virtual processors at any moment.
+	 * True on physical hardware, and on virtual machines with dedicated processors.
+	 */
+	bool topology_trusted;
+};
+
 struct cpuinfo_processor {
 	enum cpuinfo_vendor vendor;
 	enum cpuinfo_uarch uarch;
+	/** Core type of the logical processor on hybrid processors, or cpuinfo_core_type_unknown */
+	enum cpuinfo_core_type core_type;
 	struct cpuinfo_topology topology;
 	struct {
 		const struct cpuinfo_trace_cache* trace;
@@ -593,6 +1011,25 @@ struct cpuinfo_processor {
 		const struct cpuinfo_cache* l3;
 		const struct cpuinfo_cache* l4;
 	} cache;
+	/** Frequency domain of the logical processor, or NULL if frequency limits are unknown */
+	const struct cpuinfo_frequency_domain* frequency_domain;
+	/** Isolation of the logical processor by the kernel, a combination of CPUINFO_ISOLATION_* flags */
+	uint32_t isolation;
+	#if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+		/** Value of the Main ID Register (MIDR) of the core */
+		uint32_t midr;
+		/** Value of the Revision ID Register (REVIDR) of the core, or 0 if unknown */
+		uint32_t revidr;
+	#endif
+	#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+		/** Native model ID of the core on hybrid Intel processors (CPUID leaf 0x1A), or 0 if not reported */
+		uint32_t native_model_id;
+	#endif
+};
+
+struct cpuinfo_processors {
+	uint32_t count;
+	const struct cpuinfo_processor* instances;
 };
 
 struct cpuinfo_core {
@@ -613,24 +1050,341 @@ struct cpuinfo_package {
 extern "C" {
 #endif
 
+/**
+ * Detects processors, caches, and frequency domains of the system.
+ * Only the first call performs detection; subsequent calls return immediately.
+ */
 void CPUINFO_ABI cpuinfo_initialize(void);
 
+/**
+ * Detects the system again, e.g. after processor hotplug, a change of the cgroup, or migration of a virtual machine.
+ *
+ * New tables are published atomically: concurrent getters return either the old or the new tables, never a mix.
+ * Pointers returned before the call stay valid until cpuinfo_deinitialize.
+ * If detection fails, the old tables stay published.
+ *
+ * Legacy variables cpuinfo_isa, cpuinfo_processors, and cpuinfo_processors_count are rewritten in place,
+ * and must not be read concurrently with the call: use cpuinfo_get_processors and the getters instead.
+ */
+void CPUINFO_ABI cpuinfo_reinitialize(void);
+
+/**
+ * Releases all detected tables. Subsequent cpuinfo_initialize detects the system again.
+ * On Linux the frequency monitor and the online watcher are stopped first, and frequency samples are discarded.
+ * No other thread may use the library or the pointers returned by it during the call.
+ */
 void CPUINFO_ABI cpuinfo_deinitialize(void);
 
 #if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
 	extern struct cpuinfo_x86_isa cpuinfo_isa;
+
+	/**
+	 * Returns frequency and invariance of the time stamp counter.
+	 *
+	 * The frequency is decoded from CPUID leaves 0x15 and 0x16, or from the hypervisor timing leaf.
+	 * Only if the processor does not report it, the counter is calibrated against the system clock.
+	 */
+	struct cpuinfo_tsc CPUINFO_ABI cpuinfo_get_tsc(void);
+
+	/**
+	 * Converts a difference of time stamp counter values to nanoseconds.
+	 * Returns 0 if the frequency of the counter is unknown.
+	 */
+	uint64_t CPUINFO_ABI cpuinfo_tsc_ticks_to_nanoseconds(uint64_t ticks);
+
+	/**
+	 * Returns geometry of AMX tiles in palette 1, decoded from CPUID leaves 0x1D and 0x1E.
+	 * All fields are zero if AMX is not supported by the processor or tile state is not enabled by the OS.
+	 */
+	struct cpuinfo_amx CPUINFO_ABI cpuinfo_get_amx(void);
+
+	/**
+	 * Requests permission to use AMX tile data in the calling process.
+	 *
+	 * Linux enables AMX tile state in XCR0, but blocks the first use of tile data with a fault until the process
+	 * requests the permission through arch_prctl(ARCH_REQ_XCOMP_PERM). The permission applies to all threads
+	 * of the process, and the kernel allocates the larger signal frame and context buffers for them.
+	 * On other operating systems no request is necessary.
+	 *
+	 * @returns true if AMX instructions may be used, false if AMX is unsupported or the request was denied.
+	 */
+	bool CPUINFO_ABI cpuinfo_request_amx_permission(void);
+
+	/**
+	 * Returns sizes of the XSAVE area and supported XSAVE instruction variants, decoded from CPUID leaf 0xD.
+	 * All fields are zero if XSAVE is not supported by the processor or not enabled by the OS.
+	 */
+	struct cpuinfo_xsave CPUINFO_ABI cpuinfo_get_xsave(void);
+
+	/**
+	 * Returns size and location of a state component in the XSAVE area.
+	 *
+	 * @param index - index of the state component, which is also its bit position in XCR0 and IA32_XSS.
+	 *                Components 0 (x87) and 1 (SSE) are reported as the corresponding parts of the legacy region.
+	 * @returns the component description, or all-zero description if the component is not supported.
+	 */
+	struct cpuinfo_xsave_component CPUINFO_ABI cpuinfo_get_xsave_component(uint32_t index);
+
+	/**
+	 * Looks up the execution cost of an instruction on a microarchitecture, for cost-based code generation.
+	 * Costs are listed only for the microarchitectures and instructions with published measurements.
+	 * Support of the instruction by the processor must be checked separately in cpuinfo_isa.
+	 *
+	 * @returns the cost, or all-zero cost if it is unknown.
+	 */
+	struct cpuinfo_x86_instruction_cost CPUINFO_ABI cpuinfo_get_x86_instruction_cost(
+		enum cpuinfo_uarch uarch, enum cpuinfo_x86_instruction instruction);
 #endif
 
 #if CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
 	extern struct cpuinfo_arm_isa cpuinfo_isa;
 #endif
 
+#if CPUINFO_ARCH_X86_64
+	/**
+	 * Classifies the detected instruction set into an x86-64 microarchitecture level defined in the x86-64 psABI.
+	 *
+	 * @returns 1 for the x86-64 baseline, 2, 3, or 4 for x86-64-v2, x86-64-v3, or x86-64-v4.
+	 */
+	uint32_t CPUINFO_ABI cpuinfo_get_x86_64_level(void);
+#endif
+
+#if CPUINFO_ARCH_ARM64
+	/**
+	 * Classifies the detected instruction set into an Armv8.x-A profile.
+	 *
+	 * @returns the minor version x of the latest profile whose mandatory user-space features are all supported,
+	 *          from 0 for Armv8.0-A to 6 for Armv8.6-A.
+	 */
+	uint32_t CPUINFO_ABI cpuinfo_get_armv8_level(void);
+#endif
+
+/**
+ * Returns the name of the detected instruction set level as accepted by -march option of GCC and Clang,
+ * e.g. "x86-64-v3" or "armv8.2-a", or NULL if the architecture has no level classification.
+ */
+const char* CPUINFO_ABI cpuinfo_get_isa_level_name(void);
+
+#if CPUINFO_ARCH_ARM64 && defined(__linux__)
+	/** Scalable Vector Extension configuration. All vector lengths are in bytes, and zero if SVE is not supported. */
+	struct cpuinfo_arm_sve {
+		/** Vector length of the thread which initialized the library */
+		uint32_t vector_length;
+		/** Vector length assigned to new processes, as configured in /proc/sys/abi/sve_default_vector_length */
+		uint32_t default_vector_length;
+	};
+
+	struct cpuinfo_arm_sve CPUINFO_ABI cpuinfo_get_sve(void);
+
+	/**
+	 * Queries SVE vector length of the calling thread.
+	 * Vector length is a per-thread property, and may differ from the one detected during initialization.
+	 *
+	 * @returns vector length in bytes, or 0 if SVE is not supported.
+	 */
+	uint32_t CPUINFO_ABI cpuinfo_get_sve_vector_length(void);
+
+	/**
+	 * Probes the largest SVE vector length supported by all processors.
+	 * The probe sets the vector length of the calling thread to the maximum and restores it, which also cancels
+	 * a vector length scheduled for the next execve with prctl(PR_SVE_SET_VL_ONEXEC). Thus it is not done
+	 * during initialization.
+	 *
+	 * @returns vector length in bytes, or 0 if SVE is not supported or the probe failed.
+	 */
+	uint32_t CPUINFO_ABI cpuinfo_probe_sve_max_vector_length(void);
+
+	/**
+	 * Sets SVE vector length of the calling thread.
+	 * Requests above the supported maximum are clamped by the kernel to the largest supported length.
+	 * Code compiled for a fixed vector length (e.g. with -msve-vector-bits) must call this function
+	 * before any SVE instructions execute in the thread.
+	 *
+	 * @param vector_length - requested vector length in bytes: a multiple of 16 between 16 and 8192.
+	 * @param inherit - if true, the vector length is also inherited across execve.
+	 * @returns the vector length actually set, or 0 on failure.
+	 */
+	uint32_t CPUINFO_ABI cpuinfo_set_sve_vector_length(uint32_t vector_length, bool inherit);
+#endif
+
+/**
+ * Returns the logical processors of the latest initialization.
+ * Unlike cpuinfo_processors and cpuinfo_processors_count, the count and the table are consistent with each other
+ * even if another thread calls cpuinfo_reinitialize.
+ */
+struct cpuinfo_processors CPUINFO_ABI cpuinfo_get_processors(void);
+
 struct cpuinfo_caches CPUINFO_ABI cpuinfo_get_l1i_cache(void);
 struct cpuinfo_caches CPUINFO_ABI cpuinfo_get_l1d_cache(void);
 struct cpuinfo_caches CPUINFO_ABI cpuinfo_get_l2_cache(void);
 struct cpuinfo_caches CPUINFO_ABI cpuinfo_get_l3_cache(void);
 struct cpuinfo_caches CPUINFO_ABI cpuinfo_get_l4_cache(void);
 
+struct cpuinfo_frequency_domains CPUINFO_ABI cpuinfo_get_frequency_domains(void);
+
+/**
+ * Lists logical processors with the specified core type, e.g. to place threads on performance or efficiency cores.
+ *
+ * @param core_type - core type, as detected in cpuinfo_processor.core_type.
+ * @param max_count - capacity of the processors array.
+ * @param[out] processors - indices of the logical processors in cpuinfo_processors, in increasing order.
+ *                          Only the first max_count indices are stored.
+ * @returns the total number of logical processors with the core type.
+ */
+uint32_t CPUINFO_ABI cpuinfo_get_core_type_processors(
+	enum cpuinfo_core_type core_type, uint32_t max_count, uint32_t* processors);
+
+/**
+ * Returns a counter which changes whenever the detected processors or their online state change.
+ * Thread pools can save the counter when they place threads, and later compare it to check that the placement
+ * is still valid. Lock-free and does not make system calls.
+ */
+uint32_t CPUINFO_ABI cpuinfo_get_generation(void);
+
+/**
+ * Checks if a logical processor was online at initialization or at the latest update of the online state.
+ * Lock-free and does not make system calls.
+ *
+ * @returns false if the processor is offline or the index is invalid.
+ */
+bool CPUINFO_ABI cpuinfo_is_processor_online(uint32_t processor);
+
+/**
+ * Lists logical processors available to the process at initialization: processors in the affinity mask of the
+ * initializing thread and, on Linux, in the effective cpuset of its cgroup (v1 or v2).
+ *
+ * @param max_count - capacity of the processors array.
+ * @param[out] processors - indices of the logical processors in cpuinfo_processors, in increasing order.
+ *                          Only the first max_count indices are stored.
+ * @returns the total number of available logical processors.
+ */
+uint32_t CPUINFO_ABI cpuinfo_get_available_processors(uint32_t max_count, uint32_t* processors);
+
+/**
+ * Returns the number of threads which the process can run in parallel: the number of available processors,
+ * limited on Linux by the CPU bandwidth quota of the cgroup (cpu.max or cpu.cfs_quota_us), rounded up.
+ * Thread pools sized by this number do not oversubscribe containers.
+ */
+uint32_t CPUINFO_ABI cpuinfo_get_effective_parallelism(void);
+
+/**
+ * Lists logical processors for threads of a role.
+ *
+ * Latency-critical threads get processors isolated by the kernel (isolcpus, nohz_full, rcu_nocbs) and allowed by
+ * the cgroup cpuset, most isolated first. Isolated processors are usually outside the default affinity mask,
+ * and threads must be pinned to them explicitly. Housekeeping threads get the available processors which are not
+ * isolated. If no processor suits the role, e.g. when the kernel isolates no processors, the available processors
+ * are listed.
+ *
+ * @param role - role of the threads.
+ * @param max_count - capacity of the processors array.
+ * @param[out] processors - indices of the logical processors in cpuinfo_processors, in the order of preference.
+ *                          Only the first max_count indices are stored.
+ * @returns the total number of logical processors for the role.
+ */
+uint32_t CPUINFO_ABI cpuinfo_get_role_processors(
+	enum cpuinfo_thread_role role, uint32_t max_count, uint32_t* processors);
+
+/**
+ * Returns the hypervisor which runs the system, detected from the hypervisor CPUID leaves on x86.
+ * On other architectures no hypervisor is reported and the topology is trusted.
+ *
+ * On virtual machines with untrusted topology, cpuinfo_get_blocking does not assume that SMT siblings are idle.
+ * Unless the virtual processors are dedicated, threads pinned to a single processor stall whenever the host
+ * preempts it: pinning to a set of processors, e.g. from cpuinfo_get_role_processors, is more robust.
+ */
+struct cpuinfo_hypervisor CPUINFO_ABI cpuinfo_get_hypervisor(void);
+
+#if defined(__linux__)
+	/**
+	 * Reads the set of online processors from /sys/devices/system/cpu/online, and updates online state of the
+	 * detected processors. Processors which come online but were not detected at initialization, e.g. hot-added
+	 * processors, also change the generation, but are added to the processors table only by cpuinfo_reinitialize.
+	 *
+	 * @returns true if the online set changed since the previous update, and the generation was advanced.
+	 */
+	bool CPUINFO_ABI cpuinfo_update_online_processors(void);
+
+	/**
+	 * Starts a background thread which updates online state of processors on CPU hotplug uevents of the kernel,
+	 * and every period_us microseconds (at least 1000) in case uevents are not delivered, e.g. inside a container.
+	 * Each update costs a read of one sysfs file.
+	 *
+	 * @returns false if the watcher is already started or the thread can not be created.
+	 */
+	bool CPUINFO_ABI cpuinfo_online_watcher_start(uint32_t period_us);
+
+	/** Stops the background thread. Online state keeps the values of the latest update. */
+	void CPUINFO_ABI cpuinfo_online_watcher_stop(void);
+
+	/**
+	 * Starts sampling effective frequency of all logical processors.
+	 *
+	 * With non-zero period a background thread takes one sample of every processor each period_us microseconds
+	 * (at least 1000). Each sample costs at most two reads of a device file per processor.
+	 * With zero period no thread is created, and samples are taken only by cpuinfo_frequency_monitor_sample.
+	 * Processors are numbered as in the tables published at the start; after cpuinfo_reinitialize the monitor must be
+	 * restarted, and samples taken before are no longer reported.
+	 *
+	 * @returns the source of samples, or cpuinfo_frequency_source_none if monitoring is not supported.
+	 */
+	enum cpuinfo_frequency_source CPUINFO_ABI cpuinfo_frequency_monitor_start(uint32_t period_us);
+
+	/** Stops sampling. Previously taken samples remain readable. */
+	void CPUINFO_ABI cpuinfo_frequency_monitor_stop(void);
+
+	/**
+	 * Takes one sample of every logical processor in the calling thread.
+	 * Fails if the monitor is not started or samples are taken by a background thread.
+	 */
+	bool CPUINFO_ABI cpuinfo_frequency_monitor_sample(void);
+
+	/**
+	 * Reads the most recent frequency sample of a logical processor.
+	 * Lock-free and does not make system calls; safe to call concurrently with sampling.
+	 *
+	 * @returns false if no sample of the processor has been taken yet.
+	 */
+	bool CPUINFO_ABI cpuinfo_get_frequency_sample(uint32_t processor, struct cpuinfo_frequency_sample* sample);
+
+	/**
+	 * Reads up to max_samples most recent frequency samples of a logical processor, most recent first.
+	 * At most CPUINFO_FREQUENCY_MONITOR_HISTORY samples are retained.
+	 *
+	 * @returns the number of samples stored to the samples array.
+	 */
+	uint32_t CPUINFO_ABI cpuinfo_get_frequency_history(
+		uint32_t processor, struct cpuinfo_frequency_sample* samples, uint32_t max_samples);
+#endif
+
+/**
+ * Recommends cache block sizes for a working set processed on the specified logical processor.
+ *
+ * Recommendations account for cache associativity, sharing of the cache between logical processors,
+ * inclusiveness of the cache hierarchy, and the number of active SMT threads on a core.
+ * All block sizes are zero if the working set description or processor index is invalid.
+ */
+struct cpuinfo_blocking CPUINFO_ABI cpuinfo_get_blocking(
+	const struct cpuinfo_working_set* working_set, uint32_t processor);
+
+/**
+ * Returns performance characteristics of a microarchitecture, as detected in cpuinfo_processor.uarch.
+ *
+ * The description depends only on the argument, not on the host processor.
+ * Xeon Scalable processors are decoded as cpuinfo_uarch_sky_lake_server, and described separately from Sky Lake clients.
+ *
+ * @returns the description, or all-zero description if the microarchitecture is not characterized.
+ */
+struct cpuinfo_uarch_info CPUINFO_ABI cpuinfo_get_uarch_info(enum cpuinfo_uarch uarch);
+
+/**
+ * Returns cache and memory bandwidth allocation and monitoring capabilities of the platform.
+ *
+ * Capabilities are reported by the processor, and are overridden by the resctrl filesystem on Linux,
+ * which reflects the configuration actually enabled by the kernel.
+ */
+struct cpuinfo_qos CPUINFO_ABI cpuinfo_get_qos(void);
+
 extern struct cpuinfo_processor* cpuinfo_processors;
 extern struct cpuinfo_cores* cpuinfo_cores;
 extern struct cpuinfo_package* cpuinfo_packages;
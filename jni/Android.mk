@@ -3,15 +3,30 @@ LOCAL_PATH := $(call my-dir)/..
 include $(CLEAR_VARS)
 LOCAL_MODULE := cpuinfo
 LOCAL_SRC_FILES := $(LOCAL_PATH)/src/init.c \
+    $(LOCAL_PATH)/src/arena.c \
     $(LOCAL_PATH)/src/cache.c \
+    $(LOCAL_PATH)/src/blocking.c \
+    $(LOCAL_PATH)/src/qos.c \
+    $(LOCAL_PATH)/src/frequency.c \
+    $(LOCAL_PATH)/src/core-type.c \
+    $(LOCAL_PATH)/src/isa-level.c \
+    $(LOCAL_PATH)/src/uarch-info.c \
     $(LOCAL_PATH)/src/log.c \
-    $(LOCAL_PATH)/src/linux/cpuset.c
+    $(LOCAL_PATH)/src/linux/cpuset.c \
+    $(LOCAL_PATH)/src/linux/sysfs.c \
+    $(LOCAL_PATH)/src/linux/resctrl.c \
+    $(LOCAL_PATH)/src/linux/cpufreq.c \
+    $(LOCAL_PATH)/src/linux/monitor.c \
+    $(LOCAL_PATH)/src/linux/online.c \
+    $(LOCAL_PATH)/src/linux/cgroup.c \
+    $(LOCAL_PATH)/src/linux/isolation.c
 ifeq ($(TARGET_ARCH_ABI),$(filter $(TARGET_ARCH_ABI),armeabi armeabi-v7a arm64-v8a))
 LOCAL_SRC_FILES += \
 	$(LOCAL_PATH)/src/arm/uarch.c \
 	$(LOCAL_PATH)/src/arm/cache.c \
 	$(LOCAL_PATH)/src/arm/linux/init.c \
-	$(LOCAL_PATH)/src/arm/linux/cpuinfo.c
+	$(LOCAL_PATH)/src/arm/linux/cpuinfo.c \
+	$(LOCAL_PATH)/src/arm/linux/midr.c
 ifeq ($(TARGET_ARCH_ABI),armeabi)
 LOCAL_SRC_FILES += $(LOCAL_PATH)/src/arm/linux/arm32-isa.c.arm
 endif # armeabi
@@ -19,7 +34,9 @@ ifeq ($(TARGET_ARCH_ABI),armeabi-v7a)
 LOCAL_SRC_FILES += $(LOCAL_PATH)/src/arm/linux/arm32-isa.c
 endif # armeabi-v7a
 ifeq ($(TARGET_ARCH_ABI),arm64-v8a)
-LOCAL_SRC_FILES += $(LOCAL_PATH)/src/arm/linux/arm64-isa.c
+LOCAL_SRC_FILES += \
+	$(LOCAL_PATH)/src/arm/linux/arm64-isa.c \
+	$(LOCAL_PATH)/src/arm/linux/sve.c
 endif # arm64-v8a
 endif # armeabi, armeabi-v7a, or arm64-v8a
 ifeq ($(TARGET_ARCH_ABI),$(filter $(TARGET_ARCH_ABI),x86 x86_64))
@@ -33,6 +50,12 @@ LOCAL_SRC_FILES += \
     $(LOCAL_PATH)/src/x86/cache/init.c \
     $(LOCAL_PATH)/src/x86/cache/descriptor.c \
     $(LOCAL_PATH)/src/x86/cache/deterministic.c \
+    $(LOCAL_PATH)/src/x86/qos.c \
+    $(LOCAL_PATH)/src/x86/tsc.c \
+    $(LOCAL_PATH)/src/x86/hypervisor.c \
+    $(LOCAL_PATH)/src/x86/amx.c \
+    $(LOCAL_PATH)/src/x86/xsave.c \
+    $(LOCAL_PATH)/src/x86/cost.c \
     $(LOCAL_PATH)/src/x86/linux/init.c
 endif # x86 or x86_64
 LOCAL_EXPORT_C_INCLUDES := $(LOCAL_PATH)/include
@@ -0,0 +1,401 @@
+#!/usr/bin/env python
+"""
+Generates src/arm/linux/cpuinfo-names.h, the lookup of /proc/cpuinfo keys and feature names used by the parser.
+
+Names are packed into 64-bit words, 8 chars per word, first char in the least significant byte.
+Keys are looked up by a switch on the length of the key, then on the packed words. Feature names,
+which are much more numerous, are looked up in a perfect hash table: the hash of the packed words
+selects a bucket, and a per-bucket displacement, found by this script, maps every known name to its
+own slot. A lookup thus takes one multiplication, two table loads, and a comparison of the words.
+
+Usage: python scripts/proc-cpuinfo-names.py > src/arm/linux/cpuinfo-names.h
+"""
+
+from __future__ import print_function
+
+import collections
+import sys
+
+
+# Key name -> (parser key ID, architecture or None if the key is parsed on both ARM and ARM64)
+KEYS = [
+    ("processor", "processor", None),
+    ("Processor", "ignored", None),  # TODO: parse to fix misreported architecture, similar to Android's cpufeatures
+    ("Features", "features", None),
+    ("CPU architecture", "cpu_architecture", None),
+    ("CPU implementer", "cpu_implementer", None),
+    ("CPU implementor", "cpu_implementer", None),
+    ("CPU variant", "cpu_variant", None),
+    ("CPU part", "cpu_part", None),
+    ("CPU revision", "cpu_revision", None),
+    ("BogoMIPS", "ignored", None),  # BogoMIPS is useless, don't parse
+    ("Hardware", "ignored", None),  # TODO: parse to extract SoC name
+    ("Revision", "ignored", None),  # Board revision, no use for now
+    ("Serial", "ignored", None),  # Usually contains just zeros, useless
+    ("I size", "icache_size", "arm"),
+    ("I assoc", "icache_associativity", "arm"),
+    ("I line length", "icache_line_length", "arm"),
+    ("I sets", "icache_sets", "arm"),
+    ("D size", "dcache_size", "arm"),
+    ("D assoc", "dcache_associativity", "arm"),
+    ("D line length", "dcache_line_length", "arm"),
+    ("D sets", "dcache_sets", "arm"),
+]
+
+# Feature name -> (ARM flag, ARM64 flag); a flag is None if the kernel for the architecture never reports the name.
+# ARM: arch/arm/kernel/setup.c (hwcap_str, hwcap2_str), arch/arm/include/uapi/asm/hwcap.h
+# ARM64: arch/arm64/kernel/cpuinfo.c (hwcap_str), arch/arm64/include/uapi/asm/hwcap.h
+FEATURES = [
+    # AT_HWCAP on ARM
+    ("swp",       "FEATURE_SWP",       None),
+    ("half",      "FEATURE_HALF",      None),
+    ("thumb",     "FEATURE_THUMB",     None),
+    ("26bit",     "FEATURE_26BIT",     None),
+    ("fastmult",  "FEATURE_FASTMULT",  None),
+    ("fpa",       "FEATURE_FPA",       None),
+    ("vfp",       "FEATURE_VFP",       None),
+    ("edsp",      "FEATURE_EDSP",      None),
+    ("java",      "FEATURE_JAVA",      None),
+    ("iwmmxt",    "FEATURE_IWMMXT",    None),
+    ("crunch",    "FEATURE_CRUNCH",    None),
+    ("thumbee",   "FEATURE_THUMBEE",   None),
+    ("neon",      "FEATURE_NEON",      None),
+    ("vfpv3",     "FEATURE_VFPV3",     None),
+    ("vfpv3d16",  "FEATURE_VFPV3D16",  None),
+    ("tls",       "FEATURE_TLS",       None),
+    ("vfpv4",     "FEATURE_VFPV4",     None),
+    ("idiva",     "FEATURE_IDIVA",     None),
+    ("idivt",     "FEATURE_IDIVT",     None),
+    ("vfpd32",    "FEATURE_VFPD32",    None),
+    ("lpae",      "FEATURE_LPAE",      None),
+    ("asimdbf16", "FEATURE_ASIMDBF16", None),
+    # AT_HWCAP on ARM64, also reported by ARM kernels for the same features
+    ("fp",        None,                "FEATURE_FP"),
+    ("asimd",     None,                "FEATURE_ASIMD"),
+    ("evtstrm",   "FEATURE_EVTSTRM",   "FEATURE_EVTSTRM"),
+    ("aes",       "FEATURE2_AES",      "FEATURE_AES"),
+    ("pmull",     "FEATURE2_PMULL",    "FEATURE_PMULL"),
+    ("sha1",      "FEATURE2_SHA1",     "FEATURE_SHA1"),
+    ("sha2",      "FEATURE2_SHA2",     "FEATURE_SHA2"),
+    ("crc32",     "FEATURE2_CRC32",    "FEATURE_CRC32"),
+    ("atomics",   None,                "FEATURE_ATOMICS"),
+    ("fphp",      "FEATURE_FPHP",      "FEATURE_FPHP"),
+    ("asimdhp",   "FEATURE_ASIMDHP",   "FEATURE_ASIMDHP"),
+    ("cpuid",     None,                "FEATURE_CPUID"),
+    ("asimdrdm",  None,                "FEATURE_ASIMDRDM"),
+    ("jscvt",     None,                "FEATURE_JSCVT"),
+    ("fcma",      None,                "FEATURE_FCMA"),
+    ("lrcpc",     None,                "FEATURE_LRCPC"),
+    ("dcpop",     None,                "FEATURE_DCPOP"),
+    ("sha3",      None,                "FEATURE_SHA3"),
+    ("sm3",       None,                "FEATURE_SM3"),
+    ("sm4",       None,                "FEATURE_SM4"),
+    ("asimddp",   "FEATURE_ASIMDDP",   "FEATURE_ASIMDDP"),
+    ("sha512",    None,                "FEATURE_SHA512"),
+    ("sve",       None,                "FEATURE_SVE"),
+    ("asimdfhm",  "FEATURE_ASIMDFHM",  "FEATURE_ASIMDFHM"),
+    ("dit",       None,                "FEATURE_DIT"),
+    ("uscat",     None,                "FEATURE_USCAT"),
+    ("ilrcpc",    None,                "FEATURE_ILRCPC"),
+    ("flagm",     None,                "FEATURE_FLAGM"),
+    ("ssbs",      "FEATURE2_SSBS",     "FEATURE_SSBS"),
+    ("sb",        "FEATURE2_SB",       "FEATURE_SB"),
+    ("paca",      None,                "FEATURE_PACA"),
+    ("pacg",      None,                "FEATURE_PACG"),
+    # AT_HWCAP2 on ARM64
+    ("dcpodp",     None,               "FEATURE2_DCPODP"),
+    ("sve2",       None,               "FEATURE2_SVE2"),
+    ("sveaes",     None,               "FEATURE2_SVEAES"),
+    ("svepmull",   None,               "FEATURE2_SVEPMULL"),
+    ("svebitperm", None,               "FEATURE2_SVEBITPERM"),
+    ("svesha3",    None,               "FEATURE2_SVESHA3"),
+    ("svesm4",     None,               "FEATURE2_SVESM4"),
+    ("flagm2",     None,               "FEATURE2_FLAGM2"),
+    ("frint",      None,               "FEATURE2_FRINT"),
+    ("svei8mm",    None,               "FEATURE2_SVEI8MM"),
+    ("svef32mm",   None,               "FEATURE2_SVEF32MM"),
+    ("svef64mm",   None,               "FEATURE2_SVEF64MM"),
+    ("svebf16",    None,               "FEATURE2_SVEBF16"),
+    ("i8mm",       "FEATURE_I8MM",     "FEATURE2_I8MM"),
+    ("bf16",       None,               "FEATURE2_BF16"),
+    ("dgh",        None,               "FEATURE2_DGH"),
+    ("rng",        None,               "FEATURE2_RNG"),
+    ("bti",        None,               "FEATURE2_BTI"),
+    ("mte",        None,               "FEATURE2_MTE"),
+    ("ecv",        None,               "FEATURE2_ECV"),
+    ("afp",        None,               "FEATURE2_AFP"),
+    ("rpres",      None,               "FEATURE2_RPRES"),
+    ("mte3",       None,               "FEATURE2_MTE3"),
+    ("sme",        None,               "FEATURE2_SME"),
+    ("smei16i64",  None,               "FEATURE2_SMEI16I64"),
+    ("smef64f64",  None,               "FEATURE2_SMEF64F64"),
+    ("smei8i32",   None,               "FEATURE2_SMEI8I32"),
+    ("smef16f32",  None,               "FEATURE2_SMEF16F32"),
+    ("smeb16f32",  None,               "FEATURE2_SMEB16F32"),
+    ("smef32f32",  None,               "FEATURE2_SMEF32F32"),
+    ("smefa64",    None,               "FEATURE2_SMEFA64"),
+    ("wfxt",       None,               "FEATURE2_WFXT"),
+    ("ebf16",      None,               "FEATURE2_EBF16"),
+    ("sveebf16",   None,               "FEATURE2_SVE_EBF16"),
+    ("cssc",       None,               "FEATURE2_CSSC"),
+    ("rprfm",      None,               "FEATURE2_RPRFM"),
+    ("sve2p1",     None,               "FEATURE2_SVE2P1"),
+    ("sme2",       None,               "FEATURE2_SME2"),
+    ("sme2p1",     None,               "FEATURE2_SME2P1"),
+    ("smei16i32",  None,               "FEATURE2_SMEI16I32"),
+    ("smebi32i32", None,               "FEATURE2_SMEBI32I32"),
+    ("smeb16b16",  None,               "FEATURE2_SMEB16B16"),
+    ("smef16f16",  None,               "FEATURE2_SMEF16F16"),
+    ("mops",       None,               "FEATURE2_MOPS"),
+    ("hbc",        None,               "FEATURE2_HBC"),
+    ("sveb16b16",  None,               "FEATURE2_SVEB16B16"),
+    ("lrcpc3",     None,               "FEATURE2_LRCPC3"),
+    ("lse128",     None,               "FEATURE2_LSE128"),
+    ("fpmr",       None,               "FEATURE2_FPMR"),
+    ("lut",        None,               "FEATURE2_LUT"),
+    ("faminmax",   None,               "FEATURE2_FAMINMAX"),
+    ("f8cvt",      None,               "FEATURE2_F8CVT"),
+    ("f8fma",      None,               "FEATURE2_F8FMA"),
+    ("f8dp4",      None,               "FEATURE2_F8DP4"),
+    ("f8dp2",      None,               "FEATURE2_F8DP2"),
+    ("f8e4m3",     None,               "FEATURE2_F8E4M3"),
+    ("f8e5m2",     None,               "FEATURE2_F8E5M2"),
+    ("smelutv2",   None,               "FEATURE2_SMELUTV2"),
+    ("smef8f16",   None,               "FEATURE2_SMEF8F16"),
+    ("smef8f32",   None,               "FEATURE2_SMEF8F32"),
+    ("smesf8fma",  None,               "FEATURE2_SMESF8FMA"),
+    ("smesf8dp4",  None,               "FEATURE2_SMESF8DP4"),
+    ("smesf8dp2",  None,               "FEATURE2_SMESF8DP2"),
+    ("poe",        None,               "FEATURE2_POE"),
+]
+
+# Longest name which can be looked up
+MAX_NAME_LENGTH = 16
+
+
+def pack(name):
+    name = name.encode("ascii")
+    assert len(name) <= MAX_NAME_LENGTH
+    words = [0, 0]
+    for i, c in enumerate(bytearray(name)):
+        words[i // 8] |= c << (8 * (i % 8))
+    return words
+
+
+def word_literal(word):
+    return "UINT64_C(0x%016X)" % word
+
+
+def group(names):
+    """Groups names by length, then by the first word, then by the second word"""
+    tree = collections.OrderedDict()
+    for name, value in sorted(names, key=lambda entry: (len(entry[0]), pack(entry[0]))):
+        word0, word1 = pack(name)
+        tree.setdefault(len(name), collections.OrderedDict()).setdefault(word0, []).append((word1, name, value))
+    return tree
+
+
+def emit_lookup(out, names, emit_match, emit_miss, indent):
+    tab = "\t" * indent
+    print(tab + "switch (length) {", file=out)
+    for length, words in group(names).items():
+        print(tab + "\tcase %d:" % length, file=out)
+        print(tab + "\t\tswitch (words[0]) {", file=out)
+        for word0, entries in words.items():
+            if length <= 8:
+                assert len(entries) == 1
+                word1, name, value = entries[0]
+                print(tab + "\t\t\tcase %s: /* %s */" % (word_literal(word0), name), file=out)
+                emit_match(out, value, indent + 4)
+            else:
+                print(tab + "\t\t\tcase %s:" % word_literal(word0), file=out)
+                print(tab + "\t\t\t\tswitch (words[1]) {", file=out)
+                for word1, name, value in entries:
+                    print(tab + "\t\t\t\t\tcase %s: /* %s */" % (word_literal(word1), name), file=out)
+                    emit_match(out, value, indent + 6)
+                print(tab + "\t\t\t\t}", file=out)
+                print(tab + "\t\t\t\tbreak;", file=out)
+        print(tab + "\t\t}", file=out)
+        print(tab + "\t\tbreak;", file=out)
+    print(tab + "}", file=out)
+    emit_miss(out, indent)
+
+
+def emit_key_match(out, value, indent):
+    key_id, architecture = value
+    tab = "\t" * indent
+    if architecture == "arm":
+        print(tab + "#if CPUINFO_ARCH_ARM", file=out)
+        print(tab + "\treturn proc_cpuinfo_key_%s;" % key_id, file=out)
+        print(tab + "#else", file=out)
+        print(tab + "\treturn proc_cpuinfo_key_unknown;", file=out)
+        print(tab + "#endif", file=out)
+    else:
+        print(tab + "return proc_cpuinfo_key_%s;" % key_id, file=out)
+
+
+def emit_key_miss(out, indent):
+    print("\t" * indent + "return proc_cpuinfo_key_unknown;", file=out)
+
+
+# Multiplier of the packed name words in the hash function, from the golden ratio
+HASH_MULTIPLIER = 0x9E3779B97F4A7C15
+HASH_BUCKET_BITS = 5
+HASH_SLOT_BITS = 8
+MASK64 = (1 << 64) - 1
+
+
+def hash_name(name, seed):
+    word0, word1 = pack(name)
+    value = (((word0 + word1 * HASH_MULTIPLIER) & MASK64) * seed) & MASK64
+    return value >> (64 - HASH_BUCKET_BITS), (value >> 32) & ((1 << HASH_SLOT_BITS) - 1)
+
+
+def build_perfect_hash(names):
+    """Returns the hash seed, per-bucket displacements, and the name index (plus one) for each slot"""
+    slot_count = 1 << HASH_SLOT_BITS
+    for seed in range(0x9E3779B97F4A7C15 | 1, MASK64, 0x100000002):
+        buckets = collections.defaultdict(list)
+        for index, name in enumerate(names):
+            bucket, slot = hash_name(name, seed)
+            buckets[bucket].append((slot, index))
+        displacements = [0] * (1 << HASH_BUCKET_BITS)
+        slots = [0] * slot_count
+        for bucket in sorted(buckets, key=lambda bucket: -len(buckets[bucket])):
+            for displacement in range(slot_count):
+                candidates = set((slot + displacement) % slot_count for slot, index in buckets[bucket])
+                if len(candidates) == len(buckets[bucket]) and all(slots[slot] == 0 for slot in candidates):
+                    break
+            else:
+                break
+            displacements[bucket] = displacement
+            for slot, index in buckets[bucket]:
+                slots[(slot + displacement) % slot_count] = index + 1
+        else:
+            return seed, displacements, slots
+    raise ValueError("failed to build a perfect hash of feature names")
+
+
+def feature_initializer(flag):
+    if flag is None:
+        return "0, 0"
+    elif flag.startswith("FEATURE2_"):
+        return "0, PROC_CPUINFO_%s" % flag
+    else:
+        return "PROC_CPUINFO_%s, 0" % flag
+
+
+def emit_byte_table(out, values, indent):
+    tab = "\t" * indent
+    for row in range(0, len(values), 16):
+        print(tab + " ".join("%3d," % value for value in values[row:row + 16]), file=out)
+
+
+def main(out):
+    key_ids = []
+    for name, key_id, architecture in KEYS:
+        if key_id not in key_ids:
+            key_ids.append(key_id)
+
+    print("/* Generated by scripts/proc-cpuinfo-names.py, do not edit */", file=out)
+    print("#pragma once", file=out)
+    print("", file=out)
+    print("#include <stdbool.h>", file=out)
+    print("#include <stdint.h>", file=out)
+    print("#include <stddef.h>", file=out)
+    print("#include <string.h>", file=out)
+    print("", file=out)
+    print("#include <arm/linux/api.h>", file=out)
+    print("", file=out)
+    print("", file=out)
+    print("/* Longest key or feature name in /proc/cpuinfo which can be looked up */", file=out)
+    print("#define PROC_CPUINFO_MAX_NAME_LENGTH %d" % MAX_NAME_LENGTH, file=out)
+    print("", file=out)
+    print("enum proc_cpuinfo_key {", file=out)
+    print("\tproc_cpuinfo_key_unknown = 0,", file=out)
+    for key_id in key_ids:
+        print("\tproc_cpuinfo_key_%s," % key_id, file=out)
+    print("};", file=out)
+    print("", file=out)
+    print("/*", file=out)
+    print(" * Packs a name into 64-bit words, 8 chars per word, with the first char in the least significant byte.", file=out)
+    print(" * Always loads PROC_CPUINFO_MAX_NAME_LENGTH chars to avoid a variable-length copy, thus the chars after", file=out)
+    print(" * a short name must be readable. Returns false if the name is too long to be looked up.", file=out)
+    print(" */", file=out)
+    print("static inline bool proc_cpuinfo_pack_name(const char* name, size_t length, uint64_t words[restrict static 2]) {", file=out)
+    print("\tif (length > PROC_CPUINFO_MAX_NAME_LENGTH) {", file=out)
+    print("\t\treturn false;", file=out)
+    print("\t}", file=out)
+    print("\tmemcpy(words, name, PROC_CPUINFO_MAX_NAME_LENGTH);", file=out)
+    print("\t#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)", file=out)
+    print("\t\twords[0] = __builtin_bswap64(words[0]);", file=out)
+    print("\t\twords[1] = __builtin_bswap64(words[1]);", file=out)
+    print("\t#endif", file=out)
+    print("\tif (length < 8) {", file=out)
+    print("\t\twords[0] &= (UINT64_C(1) << (length * 8)) - 1;", file=out)
+    print("\t\twords[1] = 0;", file=out)
+    print("\t} else if (length < 16) {", file=out)
+    print("\t\twords[1] &= (UINT64_C(1) << ((length - 8) * 8)) - 1;", file=out)
+    print("\t}", file=out)
+    print("\treturn true;", file=out)
+    print("}", file=out)
+    print("", file=out)
+    print("static inline enum proc_cpuinfo_key proc_cpuinfo_lookup_key(size_t length, const uint64_t words[restrict static 2]) {", file=out)
+    emit_lookup(out, [(name, (key_id, architecture)) for name, key_id, architecture in KEYS],
+        emit_key_match, emit_key_miss, 1)
+    print("}", file=out)
+    print("", file=out)
+    names = [name for name, arm_flag, arm64_flag in FEATURES]
+    seed, displacements, slots = build_perfect_hash(names)
+    print("struct proc_cpuinfo_feature_name {", file=out)
+    print("\tuint64_t words[2];", file=out)
+    print("\tuint32_t features;", file=out)
+    print("\tuint64_t features2;", file=out)
+    print("};", file=out)
+    print("", file=out)
+    print("/* Flags of all feature names reported by ARM and ARM64 kernels; flags are zero if the name is not used on this architecture */", file=out)
+    print("static const struct proc_cpuinfo_feature_name proc_cpuinfo_feature_names[%d] = {" % len(FEATURES), file=out)
+    for architecture, column in (("CPUINFO_ARCH_ARM", 1), ("CPUINFO_ARCH_ARM64", 2)):
+        print("\t#%s %s" % ("if" if column == 1 else "elif", architecture), file=out)
+        for feature in FEATURES:
+            word0, word1 = pack(feature[0])
+            print("\t\t{ { %s, %s }, %s }, /* %s */" %
+                (word_literal(word0), word_literal(word1), feature_initializer(feature[column]), feature[0]), file=out)
+    print("\t#endif", file=out)
+    print("};", file=out)
+    print("", file=out)
+    print("static const uint8_t proc_cpuinfo_feature_displacements[%d] = {" % len(displacements), file=out)
+    emit_byte_table(out, displacements, 1)
+    print("};", file=out)
+    print("", file=out)
+    print("/* Index of the feature name in proc_cpuinfo_feature_names plus one, or zero for unused slots */", file=out)
+    print("static const uint8_t proc_cpuinfo_feature_slots[%d] = {" % len(slots), file=out)
+    emit_byte_table(out, slots, 1)
+    print("};", file=out)
+    print("", file=out)
+    print("/* Sets the flags of a feature, and returns false if the feature name is not known */", file=out)
+    print("static inline bool proc_cpuinfo_lookup_feature(", file=out)
+    print("\tconst uint64_t words[restrict static 2],", file=out)
+    print("\tuint32_t features[restrict static 1],", file=out)
+    print("\tuint64_t features2[restrict static 1])", file=out)
+    print("{", file=out)
+    print("\tconst uint64_t hash = (words[0] + words[1] * %s) * %s;" % (word_literal(HASH_MULTIPLIER), word_literal(seed)), file=out)
+    print("\tconst uint32_t bucket = (uint32_t) (hash >> %d);" % (64 - HASH_BUCKET_BITS), file=out)
+    print("\tconst uint32_t slot = ((uint32_t) (hash >> 32) + proc_cpuinfo_feature_displacements[bucket]) %% %d;" % len(slots), file=out)
+    print("\tconst uint32_t index = proc_cpuinfo_feature_slots[slot];", file=out)
+    print("\tif (index == 0) {", file=out)
+    print("\t\treturn false;", file=out)
+    print("\t}", file=out)
+    print("", file=out)
+    print("\tconst struct proc_cpuinfo_feature_name* feature = &proc_cpuinfo_feature_names[index - 1];", file=out)
+    print("\tif (feature->words[0] != words[0] || feature->words[1] != words[1]) {", file=out)
+    print("\t\treturn false;", file=out)
+    print("\t}", file=out)
+    print("\t*features |= feature->features;", file=out)
+    print("\t*features2 |= feature->features2;", file=out)
+    print("\treturn true;", file=out)
+    print("}", file=out)
+
+
+if __name__ == "__main__":
+    main(sys.stdout)
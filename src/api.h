@@ -1,8 +1,112 @@
 #pragma once
 
-extern struct cpuinfo_cache* cpuinfo_cache[cpuinfo_cache_level_max];
-extern uint32_t cpuinfo_cache_count[cpuinfo_cache_level_max];
-extern uint32_t cpuinfo_processors_count;
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Single allocation for all tables detected by initialization: processors, caches, frequency domains.
+ * Tables are reserved first, to compute the total size, and placed at cache line boundaries after allocation.
+ */
+struct cpuinfo_arena {
+	/* Total size of reserved tables, in bytes */
+	size_t size;
+	/* Start of the allocation, or NULL if not allocated */
+	void* base;
+	/* Size of the allocation, in bytes, rounded up to whole pages */
+	size_t mapping_size;
+};
+
+/* Offset of an empty table, which is never allocated */
+#define CPUINFO_ARENA_NO_TABLE SIZE_MAX
+
+size_t cpuinfo_arena_reserve(struct cpuinfo_arena arena[restrict static 1], size_t count, size_t element_size);
+bool cpuinfo_arena_allocate(struct cpuinfo_arena arena[restrict static 1]);
+void cpuinfo_arena_free(struct cpuinfo_arena arena[restrict static 1]);
+
+/* Returns the table at the offset returned by cpuinfo_arena_reserve, or NULL for an empty table */
+static inline void* cpuinfo_arena_table(const struct cpuinfo_arena arena[restrict static 1], size_t offset) {
+	if (offset == CPUINFO_ARENA_NO_TABLE) {
+		return NULL;
+	}
+	return (char*) arena->base + offset;
+}
+
+/*
+ * Tables detected by one initialization. The structure is allocated in the arena together with the tables,
+ * and is published as a whole: readers load cpuinfo_tables once, and see either all old or all new tables.
+ */
+struct cpuinfo_tables {
+	/* Number of the initialization which detected the tables, or 0 before the first initialization */
+	uint64_t version;
+	struct cpuinfo_arena arena;
+	struct cpuinfo_processor* processors;
+	uint32_t processors_count;
+	struct cpuinfo_cache* cache[cpuinfo_cache_level_max];
+	uint32_t cache_count[cpuinfo_cache_level_max];
+	struct cpuinfo_frequency_domain* frequency_domains;
+	uint32_t frequency_domains_count;
+	/*
+	 * Bit i is set if processors[i] is online, or NULL if online state is not tracked and all processors are online.
+	 * Bits are updated in place after publication, with atomic operations, while the initialization lock is held.
+	 */
+	uint32_t* online_mask;
+	/*
+	 * Number of online processors missing from the processors table, e.g. hot-added after initialization,
+	 * or outside the cgroup cpuset on x86, where a processor is detected only by running CPUID on it.
+	 */
+	uint32_t untracked_online_count;
+	/*
+	 * Indices of processors available to the process at initialization, in increasing order, and the number of
+	 * threads they can run in parallel under the CPU quota. NULL if availability is not detected.
+	 */
+	uint32_t* available_processors;
+	uint32_t available_processors_count;
+	uint32_t effective_parallelism;
+	/* Indices of isolated processors allowed by the cgroup, most isolated first, or NULL if not detected */
+	uint32_t* isolated_processors;
+	uint32_t isolated_processors_count;
+	/* Capabilities of the platform, detected by the same initialization as the processors */
+	struct cpuinfo_qos qos;
+	struct cpuinfo_hypervisor hypervisor;
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+	struct cpuinfo_x86_isa isa;
+	struct cpuinfo_tsc tsc;
+	/* TSC ticks are converted to nanoseconds as (ticks * tsc_multiplier) >> tsc_shift, or 0 if tsc_shift is 0 */
+	uint64_t tsc_multiplier;
+	uint32_t tsc_shift;
+	struct cpuinfo_amx amx;
+	struct cpuinfo_xsave xsave;
+	struct cpuinfo_xsave_component xsave_components[CPUINFO_XSAVE_MAX_COMPONENTS];
+#elif CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
+	struct cpuinfo_arm_isa isa;
+	#if CPUINFO_ARCH_ARM64 && defined(__linux__)
+		struct cpuinfo_arm_sve sve;
+	#endif
+#endif
+	/* Tables replaced by this initialization. Readers may still use them, so they are freed only on de-initialization. */
+	struct cpuinfo_tables* retired;
+};
+
+/* Current tables, never NULL. Written only by cpuinfo_publish_tables, and read only via cpuinfo_get_tables. */
+extern const struct cpuinfo_tables* cpuinfo_tables;
+
+static inline const struct cpuinfo_tables* cpuinfo_get_tables(void) {
+	return __atomic_load_n(&cpuinfo_tables, __ATOMIC_ACQUIRE);
+}
+
+/*
+ * Publishes tables allocated in their own arena, and takes ownership of the arena.
+ * Tables of previous initializations stay valid until de-initialization. Called only by initialization functions.
+ */
+void cpuinfo_publish_tables(struct cpuinfo_tables tables[restrict static 1]);
+
+/* Serialize in-place updates of the published tables with initialization */
+void cpuinfo_lock_initialization(void);
+void cpuinfo_unlock_initialization(void);
+
+/* Advances the counter returned by cpuinfo_get_generation, after a change of the published tables */
+void cpuinfo_advance_generation(void);
 
 void cpuinfo_x86_mach_init(void);
 void cpuinfo_x86_linux_init(void);
@@ -0,0 +1,64 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cpuinfo.h>
+#include <api.h>
+#include <log.h>
+
+
+/* Every table starts on its own cache line */
+#define CACHE_LINE_SIZE 64
+
+/* Arenas of at least this size are backed by transparent huge pages, where the kernel supports them */
+#define HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+
+size_t cpuinfo_arena_reserve(struct cpuinfo_arena arena[restrict static 1], size_t count, size_t element_size) {
+	if (count == 0) {
+		return CPUINFO_ARENA_NO_TABLE;
+	}
+
+	const size_t offset = (arena->size + (CACHE_LINE_SIZE - 1)) & ~(size_t) (CACHE_LINE_SIZE - 1);
+	arena->size = offset + count * element_size;
+	return offset;
+}
+
+bool cpuinfo_arena_allocate(struct cpuinfo_arena arena[restrict static 1]) {
+	if (arena->size == 0) {
+		return true;
+	}
+
+	const size_t page_size = (size_t) sysconf(_SC_PAGESIZE);
+	const size_t mapping_size = (arena->size + (page_size - 1)) & ~(page_size - 1);
+
+	/* Anonymous mappings are zero-filled, and page alignment implies cache line alignment */
+	void* base = mmap(NULL, mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (base == MAP_FAILED) {
+		cpuinfo_log_error("failed to map %zu bytes for processor, cache, and topology tables: %s",
+			mapping_size, strerror(errno));
+		return false;
+	}
+
+	#if defined(MADV_HUGEPAGE)
+		if (mapping_size >= HUGE_PAGE_SIZE && madvise(base, mapping_size, MADV_HUGEPAGE) != 0) {
+			cpuinfo_log_debug("failed to back %zu bytes of tables with huge pages: %s", mapping_size, strerror(errno));
+		}
+	#endif
+
+	arena->base = base;
+	arena->mapping_size = mapping_size;
+	return true;
+}
+
+void cpuinfo_arena_free(struct cpuinfo_arena arena[restrict static 1]) {
+	if (arena->base != NULL) {
+		munmap(arena->base, arena->mapping_size);
+	}
+	*arena = (struct cpuinfo_arena) { 0 };
+}
@@ -29,37 +29,49 @@ struct proc_cpuinfo_cache {
 #if CPUINFO_ARCH_ARM
 	/* arch/arm/include/uapi/asm/hwcap.h */
 
-	#define PROC_CPUINFO_FEATURE_SWP      UINT32_C(0x00000001)
-	#define PROC_CPUINFO_FEATURE_HALF     UINT32_C(0x00000002)
-	#define PROC_CPUINFO_FEATURE_THUMB    UINT32_C(0x00000004)
-	#define PROC_CPUINFO_FEATURE_26BIT    UINT32_C(0x00000008)
-	#define PROC_CPUINFO_FEATURE_FASTMULT UINT32_C(0x00000010)
-	#define PROC_CPUINFO_FEATURE_FPA      UINT32_C(0x00000020)
-	#define PROC_CPUINFO_FEATURE_VFP      UINT32_C(0x00000040)
-	#define PROC_CPUINFO_FEATURE_EDSP     UINT32_C(0x00000080)
-	#define PROC_CPUINFO_FEATURE_JAVA     UINT32_C(0x00000100)
-	#define PROC_CPUINFO_FEATURE_IWMMXT   UINT32_C(0x00000200)
-	#define PROC_CPUINFO_FEATURE_CRUNCH   UINT32_C(0x00000400)
-	#define PROC_CPUINFO_FEATURE_THUMBEE  UINT32_C(0x00000800)
-	#define PROC_CPUINFO_FEATURE_NEON     UINT32_C(0x00001000)
-	#define PROC_CPUINFO_FEATURE_VFPV3    UINT32_C(0x00002000)
-	#define PROC_CPUINFO_FEATURE_VFPV3D16 UINT32_C(0x00004000) /* Also set for VFPv4 with 16 double-precision registers */
-	#define PROC_CPUINFO_FEATURE_TLS      UINT32_C(0x00008000)
-	#define PROC_CPUINFO_FEATURE_VFPV4    UINT32_C(0x00010000)
-	#define PROC_CPUINFO_FEATURE_IDIVA    UINT32_C(0x00020000)
-	#define PROC_CPUINFO_FEATURE_IDIVT    UINT32_C(0x00040000)
-	#define PROC_CPUINFO_FEATURE_IDIV     UINT32_C(0x00060000)
-	#define PROC_CPUINFO_FEATURE_VFPD32   UINT32_C(0x00080000)
-	#define PROC_CPUINFO_FEATURE_LPAE     UINT32_C(0x00100000)
-	#define PROC_CPUINFO_FEATURE_EVTSTRM  UINT32_C(0x00200000)
+	#define PROC_CPUINFO_FEATURE_SWP       UINT32_C(0x00000001)
+	#define PROC_CPUINFO_FEATURE_HALF      UINT32_C(0x00000002)
+	#define PROC_CPUINFO_FEATURE_THUMB     UINT32_C(0x00000004)
+	#define PROC_CPUINFO_FEATURE_26BIT     UINT32_C(0x00000008)
+	#define PROC_CPUINFO_FEATURE_FASTMULT  UINT32_C(0x00000010)
+	#define PROC_CPUINFO_FEATURE_FPA       UINT32_C(0x00000020)
+	#define PROC_CPUINFO_FEATURE_VFP       UINT32_C(0x00000040)
+	#define PROC_CPUINFO_FEATURE_EDSP      UINT32_C(0x00000080)
+	#define PROC_CPUINFO_FEATURE_JAVA      UINT32_C(0x00000100)
+	#define PROC_CPUINFO_FEATURE_IWMMXT    UINT32_C(0x00000200)
+	#define PROC_CPUINFO_FEATURE_CRUNCH    UINT32_C(0x00000400)
+	#define PROC_CPUINFO_FEATURE_THUMBEE   UINT32_C(0x00000800)
+	#define PROC_CPUINFO_FEATURE_NEON      UINT32_C(0x00001000)
+	#define PROC_CPUINFO_FEATURE_VFPV3     UINT32_C(0x00002000)
+	#define PROC_CPUINFO_FEATURE_VFPV3D16  UINT32_C(0x00004000) /* Also set for VFPv4 with 16 double-precision registers */
+	#define PROC_CPUINFO_FEATURE_TLS       UINT32_C(0x00008000)
+	#define PROC_CPUINFO_FEATURE_VFPV4     UINT32_C(0x00010000)
+	#define PROC_CPUINFO_FEATURE_IDIVA     UINT32_C(0x00020000)
+	#define PROC_CPUINFO_FEATURE_IDIVT     UINT32_C(0x00040000)
+	#define PROC_CPUINFO_FEATURE_IDIV      UINT32_C(0x00060000)
+	#define PROC_CPUINFO_FEATURE_VFPD32    UINT32_C(0x00080000)
+	#define PROC_CPUINFO_FEATURE_LPAE      UINT32_C(0x00100000)
+	#define PROC_CPUINFO_FEATURE_EVTSTRM   UINT32_C(0x00200000)
+	#define PROC_CPUINFO_FEATURE_FPHP      UINT32_C(0x00400000)
+	#define PROC_CPUINFO_FEATURE_ASIMDHP   UINT32_C(0x00800000)
+	#define PROC_CPUINFO_FEATURE_ASIMDDP   UINT32_C(0x01000000)
+	#define PROC_CPUINFO_FEATURE_ASIMDFHM  UINT32_C(0x02000000)
+	#define PROC_CPUINFO_FEATURE_ASIMDBF16 UINT32_C(0x04000000)
+	#define PROC_CPUINFO_FEATURE_I8MM      UINT32_C(0x08000000)
 
 	#define PROC_CPUINFO_FEATURE2_AES   UINT32_C(0x00000001)
 	#define PROC_CPUINFO_FEATURE2_PMULL UINT32_C(0x00000002)
 	#define PROC_CPUINFO_FEATURE2_SHA1  UINT32_C(0x00000004)
 	#define PROC_CPUINFO_FEATURE2_SHA2  UINT32_C(0x00000008)
 	#define PROC_CPUINFO_FEATURE2_CRC32 UINT32_C(0x00000010)
+	#define PROC_CPUINFO_FEATURE2_SB    UINT32_C(0x00000020)
+	#define PROC_CPUINFO_FEATURE2_SSBS  UINT32_C(0x00000040)
 #elif CPUINFO_ARCH_ARM64
-	/* arch/arm64/include/uapi/asm/hwcap.h */
+	/*
+	 * arch/arm64/include/uapi/asm/hwcap.h
+	 * The bits match AT_HWCAP and AT_HWCAP2 values in the auxiliary vector,
+	 * so feature masks parsed from /proc/cpuinfo and read with getauxval are interchangeable.
+	 */
 	#define PROC_CPUINFO_FEATURE_FP       UINT32_C(0x00000001)
 	#define PROC_CPUINFO_FEATURE_ASIMD    UINT32_C(0x00000002)
 	#define PROC_CPUINFO_FEATURE_EVTSTRM  UINT32_C(0x00000004)
@@ -76,6 +88,87 @@ struct proc_cpuinfo_cache {
 	#define PROC_CPUINFO_FEATURE_JSCVT    UINT32_C(0x00002000)
 	#define PROC_CPUINFO_FEATURE_FCMA     UINT32_C(0x00004000)
 	#define PROC_CPUINFO_FEATURE_LRCPC    UINT32_C(0x00008000)
+	#define PROC_CPUINFO_FEATURE_DCPOP    UINT32_C(0x00010000)
+	#define PROC_CPUINFO_FEATURE_SHA3     UINT32_C(0x00020000)
+	#define PROC_CPUINFO_FEATURE_SM3      UINT32_C(0x00040000)
+	#define PROC_CPUINFO_FEATURE_SM4      UINT32_C(0x00080000)
+	#define PROC_CPUINFO_FEATURE_ASIMDDP  UINT32_C(0x00100000)
+	#define PROC_CPUINFO_FEATURE_SHA512   UINT32_C(0x00200000)
+	#define PROC_CPUINFO_FEATURE_SVE      UINT32_C(0x00400000)
+	#define PROC_CPUINFO_FEATURE_ASIMDFHM UINT32_C(0x00800000)
+	#define PROC_CPUINFO_FEATURE_DIT      UINT32_C(0x01000000)
+	#define PROC_CPUINFO_FEATURE_USCAT    UINT32_C(0x02000000)
+	#define PROC_CPUINFO_FEATURE_ILRCPC   UINT32_C(0x04000000)
+	#define PROC_CPUINFO_FEATURE_FLAGM    UINT32_C(0x08000000)
+	#define PROC_CPUINFO_FEATURE_SSBS     UINT32_C(0x10000000)
+	#define PROC_CPUINFO_FEATURE_SB       UINT32_C(0x20000000)
+	#define PROC_CPUINFO_FEATURE_PACA     UINT32_C(0x40000000)
+	#define PROC_CPUINFO_FEATURE_PACG     UINT32_C(0x80000000)
+
+	#define PROC_CPUINFO_FEATURE2_DCPODP     UINT32_C(0x00000001)
+	#define PROC_CPUINFO_FEATURE2_SVE2       UINT32_C(0x00000002)
+	#define PROC_CPUINFO_FEATURE2_SVEAES     UINT32_C(0x00000004)
+	#define PROC_CPUINFO_FEATURE2_SVEPMULL   UINT32_C(0x00000008)
+	#define PROC_CPUINFO_FEATURE2_SVEBITPERM UINT32_C(0x00000010)
+	#define PROC_CPUINFO_FEATURE2_SVESHA3    UINT32_C(0x00000020)
+	#define PROC_CPUINFO_FEATURE2_SVESM4     UINT32_C(0x00000040)
+	#define PROC_CPUINFO_FEATURE2_FLAGM2     UINT32_C(0x00000080)
+	#define PROC_CPUINFO_FEATURE2_FRINT      UINT32_C(0x00000100)
+	#define PROC_CPUINFO_FEATURE2_SVEI8MM    UINT32_C(0x00000200)
+	#define PROC_CPUINFO_FEATURE2_SVEF32MM   UINT32_C(0x00000400)
+	#define PROC_CPUINFO_FEATURE2_SVEF64MM   UINT32_C(0x00000800)
+	#define PROC_CPUINFO_FEATURE2_SVEBF16    UINT32_C(0x00001000)
+	#define PROC_CPUINFO_FEATURE2_I8MM       UINT32_C(0x00002000)
+	#define PROC_CPUINFO_FEATURE2_BF16       UINT32_C(0x00004000)
+	#define PROC_CPUINFO_FEATURE2_DGH        UINT32_C(0x00008000)
+	#define PROC_CPUINFO_FEATURE2_RNG        UINT32_C(0x00010000)
+	#define PROC_CPUINFO_FEATURE2_BTI        UINT32_C(0x00020000)
+	#define PROC_CPUINFO_FEATURE2_MTE        UINT32_C(0x00040000)
+	#define PROC_CPUINFO_FEATURE2_ECV        UINT32_C(0x00080000)
+	#define PROC_CPUINFO_FEATURE2_AFP        UINT32_C(0x00100000)
+	#define PROC_CPUINFO_FEATURE2_RPRES      UINT32_C(0x00200000)
+	#define PROC_CPUINFO_FEATURE2_MTE3       UINT32_C(0x00400000)
+	#define PROC_CPUINFO_FEATURE2_SME        UINT32_C(0x00800000)
+	#define PROC_CPUINFO_FEATURE2_SMEI16I64  UINT32_C(0x01000000)
+	#define PROC_CPUINFO_FEATURE2_SMEF64F64  UINT32_C(0x02000000)
+	#define PROC_CPUINFO_FEATURE2_SMEI8I32   UINT32_C(0x04000000)
+	#define PROC_CPUINFO_FEATURE2_SMEF16F32  UINT32_C(0x08000000)
+	#define PROC_CPUINFO_FEATURE2_SMEB16F32  UINT32_C(0x10000000)
+	#define PROC_CPUINFO_FEATURE2_SMEF32F32  UINT32_C(0x20000000)
+	#define PROC_CPUINFO_FEATURE2_SMEFA64    UINT32_C(0x40000000)
+	#define PROC_CPUINFO_FEATURE2_WFXT       UINT32_C(0x80000000)
+	#define PROC_CPUINFO_FEATURE2_EBF16      UINT64_C(0x0000000100000000)
+	#define PROC_CPUINFO_FEATURE2_SVE_EBF16  UINT64_C(0x0000000200000000)
+	#define PROC_CPUINFO_FEATURE2_CSSC       UINT64_C(0x0000000400000000)
+	#define PROC_CPUINFO_FEATURE2_RPRFM      UINT64_C(0x0000000800000000)
+	#define PROC_CPUINFO_FEATURE2_SVE2P1     UINT64_C(0x0000001000000000)
+	#define PROC_CPUINFO_FEATURE2_SME2       UINT64_C(0x0000002000000000)
+	#define PROC_CPUINFO_FEATURE2_SME2P1     UINT64_C(0x0000004000000000)
+	#define PROC_CPUINFO_FEATURE2_SMEI16I32  UINT64_C(0x0000008000000000)
+	#define PROC_CPUINFO_FEATURE2_SMEBI32I32 UINT64_C(0x0000010000000000)
+	#define PROC_CPUINFO_FEATURE2_SMEB16B16  UINT64_C(0x0000020000000000)
+	#define PROC_CPUINFO_FEATURE2_SMEF16F16  UINT64_C(0x0000040000000000)
+	#define PROC_CPUINFO_FEATURE2_MOPS       UINT64_C(0x0000080000000000)
+	#define PROC_CPUINFO_FEATURE2_HBC        UINT64_C(0x0000100000000000)
+	#define PROC_CPUINFO_FEATURE2_SVEB16B16  UINT64_C(0x0000200000000000)
+	#define PROC_CPUINFO_FEATURE2_LRCPC3     UINT64_C(0x0000400000000000)
+	#define PROC_CPUINFO_FEATURE2_LSE128     UINT64_C(0x0000800000000000)
+	#define PROC_CPUINFO_FEATURE2_FPMR       UINT64_C(0x0001000000000000)
+	#define PROC_CPUINFO_FEATURE2_LUT        UINT64_C(0x0002000000000000)
+	#define PROC_CPUINFO_FEATURE2_FAMINMAX   UINT64_C(0x0004000000000000)
+	#define PROC_CPUINFO_FEATURE2_F8CVT      UINT64_C(0x0008000000000000)
+	#define PROC_CPUINFO_FEATURE2_F8FMA      UINT64_C(0x0010000000000000)
+	#define PROC_CPUINFO_FEATURE2_F8DP4      UINT64_C(0x0020000000000000)
+	#define PROC_CPUINFO_FEATURE2_F8DP2      UINT64_C(0x0040000000000000)
+	#define PROC_CPUINFO_FEATURE2_F8E4M3     UINT64_C(0x0080000000000000)
+	#define PROC_CPUINFO_FEATURE2_F8E5M2     UINT64_C(0x0100000000000000)
+	#define PROC_CPUINFO_FEATURE2_SMELUTV2   UINT64_C(0x0200000000000000)
+	#define PROC_CPUINFO_FEATURE2_SMEF8F16   UINT64_C(0x0400000000000000)
+	#define PROC_CPUINFO_FEATURE2_SMEF8F32   UINT64_C(0x0800000000000000)
+	#define PROC_CPUINFO_FEATURE2_SMESF8FMA  UINT64_C(0x1000000000000000)
+	#define PROC_CPUINFO_FEATURE2_SMESF8DP4  UINT64_C(0x2000000000000000)
+	#define PROC_CPUINFO_FEATURE2_SMESF8DP2  UINT64_C(0x4000000000000000)
+	#define PROC_CPUINFO_FEATURE2_POE        UINT64_C(0x8000000000000000)
 #endif
 
 
@@ -109,9 +202,7 @@ struct proc_cpuinfo {
 	struct proc_cpuinfo_cache cache;
 #endif
 	uint32_t features;
-#if CPUINFO_ARCH_ARM
-	uint32_t features2;
-#endif
+	uint64_t features2;
 	uint32_t cpuid;
 	uint32_t implementer;
 	uint32_t variant;
@@ -123,13 +214,31 @@ struct proc_cpuinfo {
 struct proc_cpuinfo* cpuinfo_arm_linux_parse_proc_cpuinfo(
 	uint32_t processors_count[restrict static 1]);
 
+/*
+ * Reads MIDR_EL1 and REVIDR_EL1 of a processor from sysfs (Linux 4.7+ on ARM64 kernels).
+ * If available, MIDR fields override identification of the processor reported in /proc/cpuinfo.
+ * Otherwise, MIDR is reconstructed from /proc/cpuinfo, and REVIDR is zero.
+ *
+ * @returns true if the registers were read from sysfs.
+ */
+bool cpuinfo_arm_linux_detect_midr(
+	uint32_t processor,
+	struct proc_cpuinfo proc_cpuinfo[restrict static 1],
+	uint32_t midr[restrict static 1],
+	uint32_t revidr[restrict static 1]);
+
 #if CPUINFO_ARCH_ARM
 	void cpuinfo_arm_linux_decode_isa_from_proc_cpuinfo(
 		const struct proc_cpuinfo proc_cpuinfo[restrict static 1],
 		uint32_t proc_cpuinfo_count,
 		struct cpuinfo_arm_isa isa[restrict static 1]);
 #elif CPUINFO_ARCH_ARM64
-	void cpuinfo_arm64_linux_decode_isa_from_proc_cpuinfo(
-		const struct proc_cpuinfo proc_cpuinfo[restrict static 1],
+	bool cpuinfo_arm64_linux_read_hwcap(
+		uint32_t hwcap[restrict static 1],
+		uint64_t hwcap2[restrict static 1]);
+	void cpuinfo_arm64_linux_decode_isa(
+		uint32_t features,
+		uint64_t features2,
 		struct cpuinfo_arm_isa isa[restrict static 1]);
+	void cpuinfo_arm64_linux_detect_sve(struct cpuinfo_arm_sve sve[restrict static 1]);
 #endif
@@ -1,14 +1,54 @@
+#include <stdbool.h>
 #include <stdint.h>
 
+#include <sys/auxv.h>
+
+#if CPUINFO_MOCK
+	#include <cpuinfo-mock.h>
+#endif
 #include <arm/linux/api.h>
 #include <log.h>
 
 
-void cpuinfo_arm64_linux_decode_isa_from_proc_cpuinfo(
-	const struct proc_cpuinfo proc_cpuinfo[restrict static 1],
+/* Value from include/uapi/linux/auxvec.h, missing in older C library headers */
+#ifndef AT_HWCAP2
+	#define AT_HWCAP2 26
+#endif
+
+#if CPUINFO_MOCK
+	static uint32_t mock_hwcap = 0;
+	static uint64_t mock_hwcap2 = 0;
+
+	void cpuinfo_set_hwcap(uint32_t hwcap) {
+		mock_hwcap = hwcap;
+	}
+
+	void cpuinfo_set_hwcap2(uint64_t hwcap2) {
+		mock_hwcap2 = hwcap2;
+	}
+#endif
+
+
+bool cpuinfo_arm64_linux_read_hwcap(
+	uint32_t hwcap[restrict static 1],
+	uint64_t hwcap2[restrict static 1])
+{
+	#if CPUINFO_MOCK
+		*hwcap = mock_hwcap;
+		*hwcap2 = mock_hwcap2;
+	#else
+		*hwcap = (uint32_t) getauxval(AT_HWCAP);
+		*hwcap2 = (uint64_t) getauxval(AT_HWCAP2);
+	#endif
+	/* Every ARM64 kernel reports at least FP and ASIMD; zero means the auxiliary vector is not available */
+	return *hwcap != 0;
+}
+
+void cpuinfo_arm64_linux_decode_isa(
+	uint32_t features,
+	uint64_t features2,
 	struct cpuinfo_arm_isa isa[restrict static 1])
 {
-	const uint32_t features = proc_cpuinfo->features;
 	if (features & PROC_CPUINFO_FEATURE_AES) {
 		isa->aes = true;
 	}
@@ -21,6 +61,18 @@ void cpuinfo_arm64_linux_decode_isa_from_proc_cpuinfo(
 	if (features & PROC_CPUINFO_FEATURE_SHA2) {
 		isa->sha2 = true;
 	}
+	if (features & PROC_CPUINFO_FEATURE_SHA3) {
+		isa->sha3 = true;
+	}
+	if (features & PROC_CPUINFO_FEATURE_SHA512) {
+		isa->sha512 = true;
+	}
+	if (features & PROC_CPUINFO_FEATURE_SM3) {
+		isa->sm3 = true;
+	}
+	if (features & PROC_CPUINFO_FEATURE_SM4) {
+		isa->sm4 = true;
+	}
 	if (features & PROC_CPUINFO_FEATURE_CRC32) {
 		isa->crc32 = true;
 	}
@@ -35,19 +87,64 @@ void cpuinfo_arm64_linux_decode_isa_from_proc_cpuinfo(
 	} else if (features & PROC_CPUINFO_FEATURE_ASIMDHP) {
 		cpuinfo_log_warning("FP16 arithmetics disabled: detected support only for SIMD operations");
 	}
-	if (features & PROC_CPUINFO_FEATURE_ASIMDRDM) {
-		isa->rdm = true;
-	}
-	if (features & PROC_CPUINFO_FEATURE_JSCVT) {
-		isa->jscvt = true;
+	if (features & PROC_CPUINFO_FEATURE_ASIMDFHM) {
+		isa->fhm = true;
 	}
 	if (features & PROC_CPUINFO_FEATURE_ASIMDRDM) {
 		isa->rdm = true;
 	}
+	if (features & PROC_CPUINFO_FEATURE_ASIMDDP) {
+		isa->dot = true;
+	}
 	if (features & PROC_CPUINFO_FEATURE_JSCVT) {
 		isa->jscvt = true;
 	}
 	if (features & PROC_CPUINFO_FEATURE_FCMA) {
 		isa->fcma = true;
 	}
+	if (features & PROC_CPUINFO_FEATURE_LRCPC) {
+		isa->lrcpc = true;
+	}
+	if (features & PROC_CPUINFO_FEATURE_ILRCPC) {
+		isa->lrcpc2 = true;
+	}
+	if (features & PROC_CPUINFO_FEATURE_DCPOP) {
+		isa->dcpop = true;
+	}
+	if (features2 & PROC_CPUINFO_FEATURE2_DCPODP) {
+		isa->dcpodp = true;
+	}
+	if (features & PROC_CPUINFO_FEATURE_FLAGM) {
+		isa->flagm = true;
+	}
+	if (features2 & PROC_CPUINFO_FEATURE2_FLAGM2) {
+		isa->flagm2 = true;
+	}
+	if (features2 & PROC_CPUINFO_FEATURE2_FRINT) {
+		isa->frint = true;
+	}
+	if (features & PROC_CPUINFO_FEATURE_SB) {
+		isa->sb = true;
+	}
+	if (features2 & PROC_CPUINFO_FEATURE2_I8MM) {
+		isa->i8mm = true;
+	}
+	if (features2 & PROC_CPUINFO_FEATURE2_BF16) {
+		isa->bf16 = true;
+	}
+	if (features & PROC_CPUINFO_FEATURE_SVE) {
+		isa->sve = true;
+	}
+	if (features2 & PROC_CPUINFO_FEATURE2_SVE2) {
+		isa->sve2 = true;
+	}
+	if (features2 & PROC_CPUINFO_FEATURE2_SVEBF16) {
+		isa->svebf16 = true;
+	}
+	if (features2 & PROC_CPUINFO_FEATURE2_SVEI8MM) {
+		isa->svei8mm = true;
+	}
+	if (features2 & PROC_CPUINFO_FEATURE2_SME) {
+		isa->sme = true;
+	}
 }
@@ -0,0 +1,501 @@
+/* Generated by scripts/proc-cpuinfo-names.py, do not edit */
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <arm/linux/api.h>
+
+
+/* Longest key or feature name in /proc/cpuinfo which can be looked up */
+#define PROC_CPUINFO_MAX_NAME_LENGTH 16
+
+enum proc_cpuinfo_key {
+	proc_cpuinfo_key_unknown = 0,
+	proc_cpuinfo_key_processor,
+	proc_cpuinfo_key_ignored,
+	proc_cpuinfo_key_features,
+	proc_cpuinfo_key_cpu_architecture,
+	proc_cpuinfo_key_cpu_implementer,
+	proc_cpuinfo_key_cpu_variant,
+	proc_cpuinfo_key_cpu_part,
+	proc_cpuinfo_key_cpu_revision,
+	proc_cpuinfo_key_icache_size,
+	proc_cpuinfo_key_icache_associativity,
+	proc_cpuinfo_key_icache_line_length,
+	proc_cpuinfo_key_icache_sets,
+	proc_cpuinfo_key_dcache_size,
+	proc_cpuinfo_key_dcache_associativity,
+	proc_cpuinfo_key_dcache_line_length,
+	proc_cpuinfo_key_dcache_sets,
+};
+
+/*
+ * Packs a name into 64-bit words, 8 chars per word, with the first char in the least significant byte.
+ * Always loads PROC_CPUINFO_MAX_NAME_LENGTH chars to avoid a variable-length copy, thus the chars after
+ * a short name must be readable. Returns false if the name is too long to be looked up.
+ */
+static inline bool proc_cpuinfo_pack_name(const char* name, size_t length, uint64_t words[restrict static 2]) {
+	if (length > PROC_CPUINFO_MAX_NAME_LENGTH) {
+		return false;
+	}
+	memcpy(words, name, PROC_CPUINFO_MAX_NAME_LENGTH);
+	#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+		words[0] = __builtin_bswap64(words[0]);
+		words[1] = __builtin_bswap64(words[1]);
+	#endif
+	if (length < 8) {
+		words[0] &= (UINT64_C(1) << (length * 8)) - 1;
+		words[1] = 0;
+	} else if (length < 16) {
+		words[1] &= (UINT64_C(1) << ((length - 8) * 8)) - 1;
+	}
+	return true;
+}
+
+static inline enum proc_cpuinfo_key proc_cpuinfo_lookup_key(size_t length, const uint64_t words[restrict static 2]) {
+	switch (length) {
+		case 6:
+			switch (words[0]) {
+				case UINT64_C(0x0000657A69732044): /* D size */
+					#if CPUINFO_ARCH_ARM
+						return proc_cpuinfo_key_dcache_size;
+					#else
+						return proc_cpuinfo_key_unknown;
+					#endif
+				case UINT64_C(0x0000657A69732049): /* I size */
+					#if CPUINFO_ARCH_ARM
+						return proc_cpuinfo_key_icache_size;
+					#else
+						return proc_cpuinfo_key_unknown;
+					#endif
+				case UINT64_C(0x00006C6169726553): /* Serial */
+					return proc_cpuinfo_key_ignored;
+				case UINT64_C(0x0000737465732044): /* D sets */
+					#if CPUINFO_ARCH_ARM
+						return proc_cpuinfo_key_dcache_sets;
+					#else
+						return proc_cpuinfo_key_unknown;
+					#endif
+				case UINT64_C(0x0000737465732049): /* I sets */
+					#if CPUINFO_ARCH_ARM
+						return proc_cpuinfo_key_icache_sets;
+					#else
+						return proc_cpuinfo_key_unknown;
+					#endif
+			}
+			break;
+		case 7:
+			switch (words[0]) {
+				case UINT64_C(0x00636F7373612044): /* D assoc */
+					#if CPUINFO_ARCH_ARM
+						return proc_cpuinfo_key_dcache_associativity;
+					#else
+						return proc_cpuinfo_key_unknown;
+					#endif
+				case UINT64_C(0x00636F7373612049): /* I assoc */
+					#if CPUINFO_ARCH_ARM
+						return proc_cpuinfo_key_icache_associativity;
+					#else
+						return proc_cpuinfo_key_unknown;
+					#endif
+			}
+			break;
+		case 8:
+			switch (words[0]) {
+				case UINT64_C(0x5350494D6F676F42): /* BogoMIPS */
+					return proc_cpuinfo_key_ignored;
+				case UINT64_C(0x6572617764726148): /* Hardware */
+					return proc_cpuinfo_key_ignored;
+				case UINT64_C(0x6E6F697369766552): /* Revision */
+					return proc_cpuinfo_key_ignored;
+				case UINT64_C(0x7365727574616546): /* Features */
+					return proc_cpuinfo_key_features;
+				case UINT64_C(0x7472617020555043): /* CPU part */
+					return proc_cpuinfo_key_cpu_part;
+			}
+			break;
+		case 9:
+			switch (words[0]) {
+				case UINT64_C(0x6F737365636F7250):
+					switch (words[1]) {
+						case UINT64_C(0x0000000000000072): /* Processor */
+							return proc_cpuinfo_key_ignored;
+					}
+					break;
+				case UINT64_C(0x6F737365636F7270):
+					switch (words[1]) {
+						case UINT64_C(0x0000000000000072): /* processor */
+							return proc_cpuinfo_key_processor;
+					}
+					break;
+			}
+			break;
+		case 11:
+			switch (words[0]) {
+				case UINT64_C(0x6972617620555043):
+					switch (words[1]) {
+						case UINT64_C(0x0000000000746E61): /* CPU variant */
+							return proc_cpuinfo_key_cpu_variant;
+					}
+					break;
+			}
+			break;
+		case 12:
+			switch (words[0]) {
+				case UINT64_C(0x6976657220555043):
+					switch (words[1]) {
+						case UINT64_C(0x000000006E6F6973): /* CPU revision */
+							return proc_cpuinfo_key_cpu_revision;
+					}
+					break;
+			}
+			break;
+		case 13:
+			switch (words[0]) {
+				case UINT64_C(0x6C20656E696C2044):
+					switch (words[1]) {
+						case UINT64_C(0x0000006874676E65): /* D line length */
+							#if CPUINFO_ARCH_ARM
+								return proc_cpuinfo_key_dcache_line_length;
+							#else
+								return proc_cpuinfo_key_unknown;
+							#endif
+					}
+					break;
+				case UINT64_C(0x6C20656E696C2049):
+					switch (words[1]) {
+						case UINT64_C(0x0000006874676E65): /* I line length */
+							#if CPUINFO_ARCH_ARM
+								return proc_cpuinfo_key_icache_line_length;
+							#else
+								return proc_cpuinfo_key_unknown;
+							#endif
+					}
+					break;
+			}
+			break;
+		case 15:
+			switch (words[0]) {
+				case UINT64_C(0x6C706D6920555043):
+					switch (words[1]) {
+						case UINT64_C(0x007265746E656D65): /* CPU implementer */
+							return proc_cpuinfo_key_cpu_implementer;
+						case UINT64_C(0x00726F746E656D65): /* CPU implementor */
+							return proc_cpuinfo_key_cpu_implementer;
+					}
+					break;
+			}
+			break;
+		case 16:
+			switch (words[0]) {
+				case UINT64_C(0x6863726120555043):
+					switch (words[1]) {
+						case UINT64_C(0x6572757463657469): /* CPU architecture */
+							return proc_cpuinfo_key_cpu_architecture;
+					}
+					break;
+			}
+			break;
+	}
+	return proc_cpuinfo_key_unknown;
+}
+
+struct proc_cpuinfo_feature_name {
+	uint64_t words[2];
+	uint32_t features;
+	uint64_t features2;
+};
+
+/* Flags of all feature names reported by ARM and ARM64 kernels; flags are zero if the name is not used on this architecture */
+static const struct proc_cpuinfo_feature_name proc_cpuinfo_feature_names[118] = {
+	#if CPUINFO_ARCH_ARM
+		{ { UINT64_C(0x0000000000707773), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_SWP, 0 }, /* swp */
+		{ { UINT64_C(0x00000000666C6168), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_HALF, 0 }, /* half */
+		{ { UINT64_C(0x000000626D756874), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_THUMB, 0 }, /* thumb */
+		{ { UINT64_C(0x0000007469623632), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_26BIT, 0 }, /* 26bit */
+		{ { UINT64_C(0x746C756D74736166), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_FASTMULT, 0 }, /* fastmult */
+		{ { UINT64_C(0x0000000000617066), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_FPA, 0 }, /* fpa */
+		{ { UINT64_C(0x0000000000706676), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_VFP, 0 }, /* vfp */
+		{ { UINT64_C(0x0000000070736465), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_EDSP, 0 }, /* edsp */
+		{ { UINT64_C(0x000000006176616A), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_JAVA, 0 }, /* java */
+		{ { UINT64_C(0x000074786D6D7769), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_IWMMXT, 0 }, /* iwmmxt */
+		{ { UINT64_C(0x000068636E757263), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_CRUNCH, 0 }, /* crunch */
+		{ { UINT64_C(0x006565626D756874), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_THUMBEE, 0 }, /* thumbee */
+		{ { UINT64_C(0x000000006E6F656E), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_NEON, 0 }, /* neon */
+		{ { UINT64_C(0x0000003376706676), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_VFPV3, 0 }, /* vfpv3 */
+		{ { UINT64_C(0x3631643376706676), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_VFPV3D16, 0 }, /* vfpv3d16 */
+		{ { UINT64_C(0x0000000000736C74), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_TLS, 0 }, /* tls */
+		{ { UINT64_C(0x0000003476706676), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_VFPV4, 0 }, /* vfpv4 */
+		{ { UINT64_C(0x0000006176696469), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_IDIVA, 0 }, /* idiva */
+		{ { UINT64_C(0x0000007476696469), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_IDIVT, 0 }, /* idivt */
+		{ { UINT64_C(0x0000323364706676), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_VFPD32, 0 }, /* vfpd32 */
+		{ { UINT64_C(0x000000006561706C), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_LPAE, 0 }, /* lpae */
+		{ { UINT64_C(0x316662646D697361), UINT64_C(0x0000000000000036) }, PROC_CPUINFO_FEATURE_ASIMDBF16, 0 }, /* asimdbf16 */
+		{ { UINT64_C(0x0000000000007066), UINT64_C(0x0000000000000000) }, 0, 0 }, /* fp */
+		{ { UINT64_C(0x000000646D697361), UINT64_C(0x0000000000000000) }, 0, 0 }, /* asimd */
+		{ { UINT64_C(0x006D727473747665), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_EVTSTRM, 0 }, /* evtstrm */
+		{ { UINT64_C(0x0000000000736561), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_AES }, /* aes */
+		{ { UINT64_C(0x0000006C6C756D70), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_PMULL }, /* pmull */
+		{ { UINT64_C(0x0000000031616873), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SHA1 }, /* sha1 */
+		{ { UINT64_C(0x0000000032616873), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SHA2 }, /* sha2 */
+		{ { UINT64_C(0x0000003233637263), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_CRC32 }, /* crc32 */
+		{ { UINT64_C(0x007363696D6F7461), UINT64_C(0x0000000000000000) }, 0, 0 }, /* atomics */
+		{ { UINT64_C(0x0000000070687066), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_FPHP, 0 }, /* fphp */
+		{ { UINT64_C(0x007068646D697361), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_ASIMDHP, 0 }, /* asimdhp */
+		{ { UINT64_C(0x0000006469757063), UINT64_C(0x0000000000000000) }, 0, 0 }, /* cpuid */
+		{ { UINT64_C(0x6D6472646D697361), UINT64_C(0x0000000000000000) }, 0, 0 }, /* asimdrdm */
+		{ { UINT64_C(0x000000747663736A), UINT64_C(0x0000000000000000) }, 0, 0 }, /* jscvt */
+		{ { UINT64_C(0x00000000616D6366), UINT64_C(0x0000000000000000) }, 0, 0 }, /* fcma */
+		{ { UINT64_C(0x000000637063726C), UINT64_C(0x0000000000000000) }, 0, 0 }, /* lrcpc */
+		{ { UINT64_C(0x000000706F706364), UINT64_C(0x0000000000000000) }, 0, 0 }, /* dcpop */
+		{ { UINT64_C(0x0000000033616873), UINT64_C(0x0000000000000000) }, 0, 0 }, /* sha3 */
+		{ { UINT64_C(0x0000000000336D73), UINT64_C(0x0000000000000000) }, 0, 0 }, /* sm3 */
+		{ { UINT64_C(0x0000000000346D73), UINT64_C(0x0000000000000000) }, 0, 0 }, /* sm4 */
+		{ { UINT64_C(0x007064646D697361), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_ASIMDDP, 0 }, /* asimddp */
+		{ { UINT64_C(0x0000323135616873), UINT64_C(0x0000000000000000) }, 0, 0 }, /* sha512 */
+		{ { UINT64_C(0x0000000000657673), UINT64_C(0x0000000000000000) }, 0, 0 }, /* sve */
+		{ { UINT64_C(0x6D6866646D697361), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_ASIMDFHM, 0 }, /* asimdfhm */
+		{ { UINT64_C(0x0000000000746964), UINT64_C(0x0000000000000000) }, 0, 0 }, /* dit */
+		{ { UINT64_C(0x0000007461637375), UINT64_C(0x0000000000000000) }, 0, 0 }, /* uscat */
+		{ { UINT64_C(0x0000637063726C69), UINT64_C(0x0000000000000000) }, 0, 0 }, /* ilrcpc */
+		{ { UINT64_C(0x0000006D67616C66), UINT64_C(0x0000000000000000) }, 0, 0 }, /* flagm */
+		{ { UINT64_C(0x0000000073627373), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SSBS }, /* ssbs */
+		{ { UINT64_C(0x0000000000006273), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SB }, /* sb */
+		{ { UINT64_C(0x0000000061636170), UINT64_C(0x0000000000000000) }, 0, 0 }, /* paca */
+		{ { UINT64_C(0x0000000067636170), UINT64_C(0x0000000000000000) }, 0, 0 }, /* pacg */
+		{ { UINT64_C(0x000070646F706364), UINT64_C(0x0000000000000000) }, 0, 0 }, /* dcpodp */
+		{ { UINT64_C(0x0000000032657673), UINT64_C(0x0000000000000000) }, 0, 0 }, /* sve2 */
+		{ { UINT64_C(0x0000736561657673), UINT64_C(0x0000000000000000) }, 0, 0 }, /* sveaes */
+		{ { UINT64_C(0x6C6C756D70657673), UINT64_C(0x0000000000000000) }, 0, 0 }, /* svepmull */
+		{ { UINT64_C(0x6570746962657673), UINT64_C(0x0000000000006D72) }, 0, 0 }, /* svebitperm */
+		{ { UINT64_C(0x0033616873657673), UINT64_C(0x0000000000000000) }, 0, 0 }, /* svesha3 */
+		{ { UINT64_C(0x0000346D73657673), UINT64_C(0x0000000000000000) }, 0, 0 }, /* svesm4 */
+		{ { UINT64_C(0x0000326D67616C66), UINT64_C(0x0000000000000000) }, 0, 0 }, /* flagm2 */
+		{ { UINT64_C(0x000000746E697266), UINT64_C(0x0000000000000000) }, 0, 0 }, /* frint */
+		{ { UINT64_C(0x006D6D3869657673), UINT64_C(0x0000000000000000) }, 0, 0 }, /* svei8mm */
+		{ { UINT64_C(0x6D6D323366657673), UINT64_C(0x0000000000000000) }, 0, 0 }, /* svef32mm */
+		{ { UINT64_C(0x6D6D343666657673), UINT64_C(0x0000000000000000) }, 0, 0 }, /* svef64mm */
+		{ { UINT64_C(0x0036316662657673), UINT64_C(0x0000000000000000) }, 0, 0 }, /* svebf16 */
+		{ { UINT64_C(0x000000006D6D3869), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_I8MM, 0 }, /* i8mm */
+		{ { UINT64_C(0x0000000036316662), UINT64_C(0x0000000000000000) }, 0, 0 }, /* bf16 */
+		{ { UINT64_C(0x0000000000686764), UINT64_C(0x0000000000000000) }, 0, 0 }, /* dgh */
+		{ { UINT64_C(0x0000000000676E72), UINT64_C(0x0000000000000000) }, 0, 0 }, /* rng */
+		{ { UINT64_C(0x0000000000697462), UINT64_C(0x0000000000000000) }, 0, 0 }, /* bti */
+		{ { UINT64_C(0x000000000065746D), UINT64_C(0x0000000000000000) }, 0, 0 }, /* mte */
+		{ { UINT64_C(0x0000000000766365), UINT64_C(0x0000000000000000) }, 0, 0 }, /* ecv */
+		{ { UINT64_C(0x0000000000706661), UINT64_C(0x0000000000000000) }, 0, 0 }, /* afp */
+		{ { UINT64_C(0x0000007365727072), UINT64_C(0x0000000000000000) }, 0, 0 }, /* rpres */
+		{ { UINT64_C(0x000000003365746D), UINT64_C(0x0000000000000000) }, 0, 0 }, /* mte3 */
+		{ { UINT64_C(0x0000000000656D73), UINT64_C(0x0000000000000000) }, 0, 0 }, /* sme */
+		{ { UINT64_C(0x3669363169656D73), UINT64_C(0x0000000000000034) }, 0, 0 }, /* smei16i64 */
+		{ { UINT64_C(0x3666343666656D73), UINT64_C(0x0000000000000034) }, 0, 0 }, /* smef64f64 */
+		{ { UINT64_C(0x3233693869656D73), UINT64_C(0x0000000000000000) }, 0, 0 }, /* smei8i32 */
+		{ { UINT64_C(0x3366363166656D73), UINT64_C(0x0000000000000032) }, 0, 0 }, /* smef16f32 */
+		{ { UINT64_C(0x3366363162656D73), UINT64_C(0x0000000000000032) }, 0, 0 }, /* smeb16f32 */
+		{ { UINT64_C(0x3366323366656D73), UINT64_C(0x0000000000000032) }, 0, 0 }, /* smef32f32 */
+		{ { UINT64_C(0x0034366166656D73), UINT64_C(0x0000000000000000) }, 0, 0 }, /* smefa64 */
+		{ { UINT64_C(0x0000000074786677), UINT64_C(0x0000000000000000) }, 0, 0 }, /* wfxt */
+		{ { UINT64_C(0x0000003631666265), UINT64_C(0x0000000000000000) }, 0, 0 }, /* ebf16 */
+		{ { UINT64_C(0x3631666265657673), UINT64_C(0x0000000000000000) }, 0, 0 }, /* sveebf16 */
+		{ { UINT64_C(0x0000000063737363), UINT64_C(0x0000000000000000) }, 0, 0 }, /* cssc */
+		{ { UINT64_C(0x0000006D66727072), UINT64_C(0x0000000000000000) }, 0, 0 }, /* rprfm */
+		{ { UINT64_C(0x0000317032657673), UINT64_C(0x0000000000000000) }, 0, 0 }, /* sve2p1 */
+		{ { UINT64_C(0x0000000032656D73), UINT64_C(0x0000000000000000) }, 0, 0 }, /* sme2 */
+		{ { UINT64_C(0x0000317032656D73), UINT64_C(0x0000000000000000) }, 0, 0 }, /* sme2p1 */
+		{ { UINT64_C(0x3369363169656D73), UINT64_C(0x0000000000000032) }, 0, 0 }, /* smei16i32 */
+		{ { UINT64_C(0x6932336962656D73), UINT64_C(0x0000000000003233) }, 0, 0 }, /* smebi32i32 */
+		{ { UINT64_C(0x3162363162656D73), UINT64_C(0x0000000000000036) }, 0, 0 }, /* smeb16b16 */
+		{ { UINT64_C(0x3166363166656D73), UINT64_C(0x0000000000000036) }, 0, 0 }, /* smef16f16 */
+		{ { UINT64_C(0x0000000073706F6D), UINT64_C(0x0000000000000000) }, 0, 0 }, /* mops */
+		{ { UINT64_C(0x0000000000636268), UINT64_C(0x0000000000000000) }, 0, 0 }, /* hbc */
+		{ { UINT64_C(0x3162363162657673), UINT64_C(0x0000000000000036) }, 0, 0 }, /* sveb16b16 */
+		{ { UINT64_C(0x000033637063726C), UINT64_C(0x0000000000000000) }, 0, 0 }, /* lrcpc3 */
+		{ { UINT64_C(0x000038323165736C), UINT64_C(0x0000000000000000) }, 0, 0 }, /* lse128 */
+		{ { UINT64_C(0x00000000726D7066), UINT64_C(0x0000000000000000) }, 0, 0 }, /* fpmr */
+		{ { UINT64_C(0x000000000074756C), UINT64_C(0x0000000000000000) }, 0, 0 }, /* lut */
+		{ { UINT64_C(0x78616D6E696D6166), UINT64_C(0x0000000000000000) }, 0, 0 }, /* faminmax */
+		{ { UINT64_C(0x0000007476633866), UINT64_C(0x0000000000000000) }, 0, 0 }, /* f8cvt */
+		{ { UINT64_C(0x000000616D663866), UINT64_C(0x0000000000000000) }, 0, 0 }, /* f8fma */
+		{ { UINT64_C(0x0000003470643866), UINT64_C(0x0000000000000000) }, 0, 0 }, /* f8dp4 */
+		{ { UINT64_C(0x0000003270643866), UINT64_C(0x0000000000000000) }, 0, 0 }, /* f8dp2 */
+		{ { UINT64_C(0x0000336D34653866), UINT64_C(0x0000000000000000) }, 0, 0 }, /* f8e4m3 */
+		{ { UINT64_C(0x0000326D35653866), UINT64_C(0x0000000000000000) }, 0, 0 }, /* f8e5m2 */
+		{ { UINT64_C(0x327674756C656D73), UINT64_C(0x0000000000000000) }, 0, 0 }, /* smelutv2 */
+		{ { UINT64_C(0x3631663866656D73), UINT64_C(0x0000000000000000) }, 0, 0 }, /* smef8f16 */
+		{ { UINT64_C(0x3233663866656D73), UINT64_C(0x0000000000000000) }, 0, 0 }, /* smef8f32 */
+		{ { UINT64_C(0x6D66386673656D73), UINT64_C(0x0000000000000061) }, 0, 0 }, /* smesf8fma */
+		{ { UINT64_C(0x7064386673656D73), UINT64_C(0x0000000000000034) }, 0, 0 }, /* smesf8dp4 */
+		{ { UINT64_C(0x7064386673656D73), UINT64_C(0x0000000000000032) }, 0, 0 }, /* smesf8dp2 */
+		{ { UINT64_C(0x0000000000656F70), UINT64_C(0x0000000000000000) }, 0, 0 }, /* poe */
+	#elif CPUINFO_ARCH_ARM64
+		{ { UINT64_C(0x0000000000707773), UINT64_C(0x0000000000000000) }, 0, 0 }, /* swp */
+		{ { UINT64_C(0x00000000666C6168), UINT64_C(0x0000000000000000) }, 0, 0 }, /* half */
+		{ { UINT64_C(0x000000626D756874), UINT64_C(0x0000000000000000) }, 0, 0 }, /* thumb */
+		{ { UINT64_C(0x0000007469623632), UINT64_C(0x0000000000000000) }, 0, 0 }, /* 26bit */
+		{ { UINT64_C(0x746C756D74736166), UINT64_C(0x0000000000000000) }, 0, 0 }, /* fastmult */
+		{ { UINT64_C(0x0000000000617066), UINT64_C(0x0000000000000000) }, 0, 0 }, /* fpa */
+		{ { UINT64_C(0x0000000000706676), UINT64_C(0x0000000000000000) }, 0, 0 }, /* vfp */
+		{ { UINT64_C(0x0000000070736465), UINT64_C(0x0000000000000000) }, 0, 0 }, /* edsp */
+		{ { UINT64_C(0x000000006176616A), UINT64_C(0x0000000000000000) }, 0, 0 }, /* java */
+		{ { UINT64_C(0x000074786D6D7769), UINT64_C(0x0000000000000000) }, 0, 0 }, /* iwmmxt */
+		{ { UINT64_C(0x000068636E757263), UINT64_C(0x0000000000000000) }, 0, 0 }, /* crunch */
+		{ { UINT64_C(0x006565626D756874), UINT64_C(0x0000000000000000) }, 0, 0 }, /* thumbee */
+		{ { UINT64_C(0x000000006E6F656E), UINT64_C(0x0000000000000000) }, 0, 0 }, /* neon */
+		{ { UINT64_C(0x0000003376706676), UINT64_C(0x0000000000000000) }, 0, 0 }, /* vfpv3 */
+		{ { UINT64_C(0x3631643376706676), UINT64_C(0x0000000000000000) }, 0, 0 }, /* vfpv3d16 */
+		{ { UINT64_C(0x0000000000736C74), UINT64_C(0x0000000000000000) }, 0, 0 }, /* tls */
+		{ { UINT64_C(0x0000003476706676), UINT64_C(0x0000000000000000) }, 0, 0 }, /* vfpv4 */
+		{ { UINT64_C(0x0000006176696469), UINT64_C(0x0000000000000000) }, 0, 0 }, /* idiva */
+		{ { UINT64_C(0x0000007476696469), UINT64_C(0x0000000000000000) }, 0, 0 }, /* idivt */
+		{ { UINT64_C(0x0000323364706676), UINT64_C(0x0000000000000000) }, 0, 0 }, /* vfpd32 */
+		{ { UINT64_C(0x000000006561706C), UINT64_C(0x0000000000000000) }, 0, 0 }, /* lpae */
+		{ { UINT64_C(0x316662646D697361), UINT64_C(0x0000000000000036) }, 0, 0 }, /* asimdbf16 */
+		{ { UINT64_C(0x0000000000007066), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_FP, 0 }, /* fp */
+		{ { UINT64_C(0x000000646D697361), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_ASIMD, 0 }, /* asimd */
+		{ { UINT64_C(0x006D727473747665), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_EVTSTRM, 0 }, /* evtstrm */
+		{ { UINT64_C(0x0000000000736561), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_AES, 0 }, /* aes */
+		{ { UINT64_C(0x0000006C6C756D70), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_PMULL, 0 }, /* pmull */
+		{ { UINT64_C(0x0000000031616873), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_SHA1, 0 }, /* sha1 */
+		{ { UINT64_C(0x0000000032616873), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_SHA2, 0 }, /* sha2 */
+		{ { UINT64_C(0x0000003233637263), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_CRC32, 0 }, /* crc32 */
+		{ { UINT64_C(0x007363696D6F7461), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_ATOMICS, 0 }, /* atomics */
+		{ { UINT64_C(0x0000000070687066), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_FPHP, 0 }, /* fphp */
+		{ { UINT64_C(0x007068646D697361), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_ASIMDHP, 0 }, /* asimdhp */
+		{ { UINT64_C(0x0000006469757063), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_CPUID, 0 }, /* cpuid */
+		{ { UINT64_C(0x6D6472646D697361), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_ASIMDRDM, 0 }, /* asimdrdm */
+		{ { UINT64_C(0x000000747663736A), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_JSCVT, 0 }, /* jscvt */
+		{ { UINT64_C(0x00000000616D6366), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_FCMA, 0 }, /* fcma */
+		{ { UINT64_C(0x000000637063726C), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_LRCPC, 0 }, /* lrcpc */
+		{ { UINT64_C(0x000000706F706364), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_DCPOP, 0 }, /* dcpop */
+		{ { UINT64_C(0x0000000033616873), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_SHA3, 0 }, /* sha3 */
+		{ { UINT64_C(0x0000000000336D73), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_SM3, 0 }, /* sm3 */
+		{ { UINT64_C(0x0000000000346D73), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_SM4, 0 }, /* sm4 */
+		{ { UINT64_C(0x007064646D697361), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_ASIMDDP, 0 }, /* asimddp */
+		{ { UINT64_C(0x0000323135616873), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_SHA512, 0 }, /* sha512 */
+		{ { UINT64_C(0x0000000000657673), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_SVE, 0 }, /* sve */
+		{ { UINT64_C(0x6D6866646D697361), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_ASIMDFHM, 0 }, /* asimdfhm */
+		{ { UINT64_C(0x0000000000746964), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_DIT, 0 }, /* dit */
+		{ { UINT64_C(0x0000007461637375), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_USCAT, 0 }, /* uscat */
+		{ { UINT64_C(0x0000637063726C69), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_ILRCPC, 0 }, /* ilrcpc */
+		{ { UINT64_C(0x0000006D67616C66), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_FLAGM, 0 }, /* flagm */
+		{ { UINT64_C(0x0000000073627373), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_SSBS, 0 }, /* ssbs */
+		{ { UINT64_C(0x0000000000006273), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_SB, 0 }, /* sb */
+		{ { UINT64_C(0x0000000061636170), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_PACA, 0 }, /* paca */
+		{ { UINT64_C(0x0000000067636170), UINT64_C(0x0000000000000000) }, PROC_CPUINFO_FEATURE_PACG, 0 }, /* pacg */
+		{ { UINT64_C(0x000070646F706364), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_DCPODP }, /* dcpodp */
+		{ { UINT64_C(0x0000000032657673), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SVE2 }, /* sve2 */
+		{ { UINT64_C(0x0000736561657673), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SVEAES }, /* sveaes */
+		{ { UINT64_C(0x6C6C756D70657673), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SVEPMULL }, /* svepmull */
+		{ { UINT64_C(0x6570746962657673), UINT64_C(0x0000000000006D72) }, 0, PROC_CPUINFO_FEATURE2_SVEBITPERM }, /* svebitperm */
+		{ { UINT64_C(0x0033616873657673), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SVESHA3 }, /* svesha3 */
+		{ { UINT64_C(0x0000346D73657673), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SVESM4 }, /* svesm4 */
+		{ { UINT64_C(0x0000326D67616C66), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_FLAGM2 }, /* flagm2 */
+		{ { UINT64_C(0x000000746E697266), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_FRINT }, /* frint */
+		{ { UINT64_C(0x006D6D3869657673), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SVEI8MM }, /* svei8mm */
+		{ { UINT64_C(0x6D6D323366657673), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SVEF32MM }, /* svef32mm */
+		{ { UINT64_C(0x6D6D343666657673), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SVEF64MM }, /* svef64mm */
+		{ { UINT64_C(0x0036316662657673), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SVEBF16 }, /* svebf16 */
+		{ { UINT64_C(0x000000006D6D3869), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_I8MM }, /* i8mm */
+		{ { UINT64_C(0x0000000036316662), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_BF16 }, /* bf16 */
+		{ { UINT64_C(0x0000000000686764), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_DGH }, /* dgh */
+		{ { UINT64_C(0x0000000000676E72), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_RNG }, /* rng */
+		{ { UINT64_C(0x0000000000697462), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_BTI }, /* bti */
+		{ { UINT64_C(0x000000000065746D), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_MTE }, /* mte */
+		{ { UINT64_C(0x0000000000766365), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_ECV }, /* ecv */
+		{ { UINT64_C(0x0000000000706661), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_AFP }, /* afp */
+		{ { UINT64_C(0x0000007365727072), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_RPRES }, /* rpres */
+		{ { UINT64_C(0x000000003365746D), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_MTE3 }, /* mte3 */
+		{ { UINT64_C(0x0000000000656D73), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SME }, /* sme */
+		{ { UINT64_C(0x3669363169656D73), UINT64_C(0x0000000000000034) }, 0, PROC_CPUINFO_FEATURE2_SMEI16I64 }, /* smei16i64 */
+		{ { UINT64_C(0x3666343666656D73), UINT64_C(0x0000000000000034) }, 0, PROC_CPUINFO_FEATURE2_SMEF64F64 }, /* smef64f64 */
+		{ { UINT64_C(0x3233693869656D73), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SMEI8I32 }, /* smei8i32 */
+		{ { UINT64_C(0x3366363166656D73), UINT64_C(0x0000000000000032) }, 0, PROC_CPUINFO_FEATURE2_SMEF16F32 }, /* smef16f32 */
+		{ { UINT64_C(0x3366363162656D73), UINT64_C(0x0000000000000032) }, 0, PROC_CPUINFO_FEATURE2_SMEB16F32 }, /* smeb16f32 */
+		{ { UINT64_C(0x3366323366656D73), UINT64_C(0x0000000000000032) }, 0, PROC_CPUINFO_FEATURE2_SMEF32F32 }, /* smef32f32 */
+		{ { UINT64_C(0x0034366166656D73), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SMEFA64 }, /* smefa64 */
+		{ { UINT64_C(0x0000000074786677), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_WFXT }, /* wfxt */
+		{ { UINT64_C(0x0000003631666265), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_EBF16 }, /* ebf16 */
+		{ { UINT64_C(0x3631666265657673), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SVE_EBF16 }, /* sveebf16 */
+		{ { UINT64_C(0x0000000063737363), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_CSSC }, /* cssc */
+		{ { UINT64_C(0x0000006D66727072), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_RPRFM }, /* rprfm */
+		{ { UINT64_C(0x0000317032657673), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SVE2P1 }, /* sve2p1 */
+		{ { UINT64_C(0x0000000032656D73), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SME2 }, /* sme2 */
+		{ { UINT64_C(0x0000317032656D73), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SME2P1 }, /* sme2p1 */
+		{ { UINT64_C(0x3369363169656D73), UINT64_C(0x0000000000000032) }, 0, PROC_CPUINFO_FEATURE2_SMEI16I32 }, /* smei16i32 */
+		{ { UINT64_C(0x6932336962656D73), UINT64_C(0x0000000000003233) }, 0, PROC_CPUINFO_FEATURE2_SMEBI32I32 }, /* smebi32i32 */
+		{ { UINT64_C(0x3162363162656D73), UINT64_C(0x0000000000000036) }, 0, PROC_CPUINFO_FEATURE2_SMEB16B16 }, /* smeb16b16 */
+		{ { UINT64_C(0x3166363166656D73), UINT64_C(0x0000000000000036) }, 0, PROC_CPUINFO_FEATURE2_SMEF16F16 }, /* smef16f16 */
+		{ { UINT64_C(0x0000000073706F6D), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_MOPS }, /* mops */
+		{ { UINT64_C(0x0000000000636268), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_HBC }, /* hbc */
+		{ { UINT64_C(0x3162363162657673), UINT64_C(0x0000000000000036) }, 0, PROC_CPUINFO_FEATURE2_SVEB16B16 }, /* sveb16b16 */
+		{ { UINT64_C(0x000033637063726C), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_LRCPC3 }, /* lrcpc3 */
+		{ { UINT64_C(0x000038323165736C), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_LSE128 }, /* lse128 */
+		{ { UINT64_C(0x00000000726D7066), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_FPMR }, /* fpmr */
+		{ { UINT64_C(0x000000000074756C), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_LUT }, /* lut */
+		{ { UINT64_C(0x78616D6E696D6166), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_FAMINMAX }, /* faminmax */
+		{ { UINT64_C(0x0000007476633866), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_F8CVT }, /* f8cvt */
+		{ { UINT64_C(0x000000616D663866), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_F8FMA }, /* f8fma */
+		{ { UINT64_C(0x0000003470643866), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_F8DP4 }, /* f8dp4 */
+		{ { UINT64_C(0x0000003270643866), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_F8DP2 }, /* f8dp2 */
+		{ { UINT64_C(0x0000336D34653866), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_F8E4M3 }, /* f8e4m3 */
+		{ { UINT64_C(0x0000326D35653866), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_F8E5M2 }, /* f8e5m2 */
+		{ { UINT64_C(0x327674756C656D73), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SMELUTV2 }, /* smelutv2 */
+		{ { UINT64_C(0x3631663866656D73), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SMEF8F16 }, /* smef8f16 */
+		{ { UINT64_C(0x3233663866656D73), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_SMEF8F32 }, /* smef8f32 */
+		{ { UINT64_C(0x6D66386673656D73), UINT64_C(0x0000000000000061) }, 0, PROC_CPUINFO_FEATURE2_SMESF8FMA }, /* smesf8fma */
+		{ { UINT64_C(0x7064386673656D73), UINT64_C(0x0000000000000034) }, 0, PROC_CPUINFO_FEATURE2_SMESF8DP4 }, /* smesf8dp4 */
+		{ { UINT64_C(0x7064386673656D73), UINT64_C(0x0000000000000032) }, 0, PROC_CPUINFO_FEATURE2_SMESF8DP2 }, /* smesf8dp2 */
+		{ { UINT64_C(0x0000000000656F70), UINT64_C(0x0000000000000000) }, 0, PROC_CPUINFO_FEATURE2_POE }, /* poe */
+	#endif
+};
+
+static const uint8_t proc_cpuinfo_feature_displacements[32] = {
+	  0,   3,   1,   4,   0,   0,   5,   0,   0,   0,   5,   0,   3,  10,   5,   6,
+	 10,   0,  11,   0,   9,   1,   0,   0,   2,   2,   3,   1,   8,   0,   0,   3,
+};
+
+/* Index of the feature name in proc_cpuinfo_feature_names plus one, or zero for unused slots */
+static const uint8_t proc_cpuinfo_feature_slots[256] = {
+	 50,   0,   0,   0, 107,   0,  27,  51,   5,   0, 111,   0,   0,   0,   0,   0,
+	  0,   0,   0, 105,  69,   0,   0,   0,   0,   0,   0,   0,   7,   0,   0, 115,
+	 48,   0,  36,  58,  44, 101,   0,  82,  78,  38,   0,  32,  73,   0,   0,   0,
+	 72,  55,   0, 109,  79,   0,  83,   0,   0,   0,   0,   0,  40,   0,   0,  21,
+	  0,   0,   0,  65,   0,   0,   0,   0,   0,  28, 104,   0,   0,  52,   0,   0,
+	  0,  54,  97,   0,  89,   0,   0,  80,  64,   1,  90,   0,   0,  18,  85,  47,
+	  0,  96,   0,   0,   0, 114,  92,   0,  10,  84, 113,  34,  25,   0,   0,   0,
+	 86, 108,  53,  91,   0, 116,   0,   0,  88,   0,   0,   9,  16,   0,  71,   2,
+	 15,  75,  67,   0,  14,   0,   4,   0,   0,  63,   0, 110,   0,  68,   0,   0,
+	  0,  49,   0,   0,   0,  76, 103,  23,   0,   0,   0,  94,  41,  39,  17,   0,
+	 66,   0,  61,  45,  22,  98,   0,   0,   8,   0,   0,   0,   0,  19,   0,   0,
+	112,  95,   0,   0,   0,   0,   0,   0,  11,  31,  74,   0,   0,   0,  13,   0,
+	 29,   0,   0,   0, 102,  20,   0,   0,   0,   3,  12,   0,   0,   0,   0, 106,
+	  0,   0,   0,   0,   0,   6,   0,   0,   0,   0,   0,   0,  81,   0,  46, 117,
+	100,  43,  87,  33,  35,  57,  26,  24,  56,  37,   0, 118,   0,  77,  70,   0,
+	  0,  42,  30,   0,   0,   0,  62,  99,   0,   0,  59,   0,  60,   0,  93,   0,
+};
+
+/* Sets the flags of a feature, and returns false if the feature name is not known */
+static inline bool proc_cpuinfo_lookup_feature(
+	const uint64_t words[restrict static 2],
+	uint32_t features[restrict static 1],
+	uint64_t features2[restrict static 1])
+{
+	const uint64_t hash = (words[0] + words[1] * UINT64_C(0x9E3779B97F4A7C15)) * UINT64_C(0x9E3779BE7F4A7C1F);
+	const uint32_t bucket = (uint32_t) (hash >> 59);
+	const uint32_t slot = ((uint32_t) (hash >> 32) + proc_cpuinfo_feature_displacements[bucket]) % 256;
+	const uint32_t index = proc_cpuinfo_feature_slots[slot];
+	if (index == 0) {
+		return false;
+	}
+
+	const struct proc_cpuinfo_feature_name* feature = &proc_cpuinfo_feature_names[index - 1];
+	if (feature->words[0] != words[0] || feature->words[1] != words[1]) {
+		return false;
+	}
+	*features |= feature->features;
+	*features2 |= feature->features2;
+	return true;
+}
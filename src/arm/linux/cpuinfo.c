@@ -15,6 +15,8 @@
 	#include <cpuinfo-mock.h>
 #endif
 #include <arm/linux/api.h>
+#include <arm/linux/cpuinfo-names.h>
+#include <linux/api.h>
 #include <log.h>
 
 
@@ -29,12 +31,13 @@ static const char* proc_cpuinfo_path = "/proc/cpuinfo";
 
 
 /*
- * Size, in chars, of the on-stack buffer used for parsing cpu lists.
- * This is also the limit on the length of a single entry
- * (<cpu-number> or <cpu-number-start>-<cpu-number-end>)
- * in the cpu list.
+ * Initial size, in chars, of the buffer for the contents of /proc/cpuinfo, per possible processor.
+ * A block of processor information takes 200-600 chars, and the file is usually read in a single call.
  */
-#define BUFFER_SIZE 256
+#define PROC_CPUINFO_SIZE_PER_PROCESSOR 1024
+
+/* Minimal initial number of processor records, used if the number of possible processors is unknown or small */
+#define MIN_PROCESSORS_CAPACITY 8
 
 
 static uint32_t parse_processor_number(
@@ -64,6 +67,17 @@ static uint32_t parse_processor_number(
 	return processor_number;
 }
 
+/*
+ *	Features line of the last parsed processor, and flags decoded from it.
+ *	All processors usually report the same features, and a match skips decoding of the line.
+ */
+struct features_cache {
+	const char* start;
+	size_t length;
+	uint32_t features;
+	uint64_t features2;
+};
+
 /*
  *	Full list of ARM features reported in /proc/cpuinfo:
  *	
@@ -116,20 +130,35 @@ static uint32_t parse_processor_number(
  *  * crc32 - CRC32 instructions.
  *
  *	/proc/cpuinfo on ARM is populated in file arch/arm/kernel/setup.c in Linux kernel
+ *	/proc/cpuinfo on ARM64 is populated in file arch/arm64/kernel/cpuinfo.c in Linux kernel,
+ *	with one name for each bit of AT_HWCAP and AT_HWCAP2 in the auxiliary vector.
  *	Note that some devices may use patched Linux kernels with different feature names.
  *	However, the names above were checked on a large number of /proc/cpuinfo listings.
+ *
+ *	Names are looked up in cpuinfo-names.h, generated by scripts/proc-cpuinfo-names.py
+ *	from the list of all names reported by ARM and ARM64 kernels.
  */
 static void parse_features(
 	const char* features_start,
 	const char* features_end,
-	struct proc_cpuinfo proc_cpuinfo[restrict static 1])
+	struct proc_cpuinfo proc_cpuinfo[restrict static 1],
+	struct features_cache cache[restrict static 1])
 {
-	const char* feature_start = features_start;
-	const char* feature_end;
+	const size_t features_length = (size_t) (features_end - features_start);
 
 	/* Mark the features as valid */
 	proc_cpuinfo->valid_mask |= PROC_CPUINFO_VALID_FEATURES;
 
+	if (features_length == cache->length && memcmp(features_start, cache->start, features_length) == 0) {
+		proc_cpuinfo->features |= cache->features;
+		proc_cpuinfo->features2 |= cache->features2;
+		return;
+	}
+
+	uint32_t features = 0;
+	uint64_t features2 = 0;
+	const char* feature_start = features_start;
+	const char* feature_end;
 	do {
 		feature_end = feature_start + 1;
 		for (; feature_end != features_end; feature_end++) {
@@ -139,161 +168,14 @@ static void parse_features(
 		}
 		const size_t feature_length = (size_t) (feature_end - feature_start);
 
-		switch (feature_length) {
-			case 3:
-				if (memcmp(feature_start, "aes", feature_length) == 0) {
-					#if CPUINFO_ARCH_ARM
-						proc_cpuinfo->features2 |= PROC_CPUINFO_FEATURE2_AES;
-					#elif CPUINFO_ARCH_ARM64
-						proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_AES;
-					#endif
-#if CPUINFO_ARCH_ARM
-				} else if (memcmp(feature_start, "swp", feature_length) == 0) {
-					proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_SWP;
-				} else if (memcmp(feature_start, "fpa", feature_length) == 0) {
-					proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_FPA;
-				} else if (memcmp(feature_start, "vfp", feature_length) == 0) {
-					proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_VFP;
-				} else if (memcmp(feature_start, "tls", feature_length) == 0) {
-					proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_TLS;
-#endif /* CPUINFO_ARCH_ARM */
-				} else {
-					goto unexpected;
-				}
-				break;
-			case 4:
-				if (memcmp(feature_start, "sha1", feature_length) == 0) {
-					#if CPUINFO_ARCH_ARM
-						proc_cpuinfo->features2 |= PROC_CPUINFO_FEATURE2_SHA1;
-					#elif CPUINFO_ARCH_ARM64
-						proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_SHA1;
-					#endif
-				} else if (memcmp(feature_start, "sha2", feature_length) == 0) {
-					#if CPUINFO_ARCH_ARM
-						proc_cpuinfo->features2 |= PROC_CPUINFO_FEATURE2_SHA2;
-					#elif CPUINFO_ARCH_ARM64
-						proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_SHA2;
-					#endif
-				} else if (memcmp(feature_start, "fphp", feature_length) == 0) {
-					#if CPUINFO_ARCH_ARM64
-						proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_FPHP;
-					#endif
-				} else if (memcmp(feature_start, "fcma", feature_length) == 0) {
-					#if CPUINFO_ARCH_ARM64
-						proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_FCMA;
-					#endif
-#if CPUINFO_ARCH_ARM
-				} else if (memcmp(feature_start, "half", feature_length) == 0) {
-					proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_HALF;
-				} else if (memcmp(feature_start, "edsp", feature_length) == 0) {
-					proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_EDSP;
-				} else if (memcmp(feature_start, "java", feature_length) == 0) {
-					proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_JAVA;
-				} else if (memcmp(feature_start, "neon", feature_length) == 0) {
-					proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_NEON;
-				} else if (memcmp(feature_start, "lpae", feature_length) == 0) {
-					proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_LPAE;
-#endif /* CPUINFO_ARCH_ARM */
-				} else {
-					goto unexpected;
-				}
-				break;
-			case 5:
-				if (memcmp(feature_start, "pmull", feature_length) == 0) {
-					#if CPUINFO_ARCH_ARM
-						proc_cpuinfo->features2 |= PROC_CPUINFO_FEATURE2_PMULL;
-					#elif CPUINFO_ARCH_ARM64
-						proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_PMULL;
-					#endif
-				} else if (memcmp(feature_start, "crc32", feature_length) == 0) {
-					#if CPUINFO_ARCH_ARM
-						proc_cpuinfo->features2 |= PROC_CPUINFO_FEATURE2_CRC32;
-					#elif CPUINFO_ARCH_ARM64
-						proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_CRC32;
-					#endif
-				} else if (memcmp(feature_start, "cpuid", feature_length) == 0) {
-					#if CPUINFO_ARCH_ARM64
-						proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_CPUID;
-					#endif
-				} else if (memcmp(feature_start, "jscvt", feature_length) == 0) {
-					#if CPUINFO_ARCH_ARM64
-						proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_JSCVT;
-					#endif
-				} else if (memcmp(feature_start, "lrcpc", feature_length) == 0) {
-					#if CPUINFO_ARCH_ARM64
-						proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_LRCPC;
-					#endif
-#if CPUINFO_ARCH_ARM
-				} else if (memcmp(feature_start, "thumb", feature_length) == 0) {
-					proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_THUMB;
-				} else if (memcmp(feature_start, "26bit", feature_length) == 0) {
-					proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_26BIT;
-				} else if (memcmp(feature_start, "vfpv3", feature_length) == 0) {
-					proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_VFPV3;
-				} else if (memcmp(feature_start, "vfpv4", feature_length) == 0) {
-					proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_VFPV4;
-				} else if (memcmp(feature_start, "idiva", feature_length) == 0) {
-					proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_IDIVA;
-				} else if (memcmp(feature_start, "idivt", feature_length) == 0) {
-					proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_IDIVT;
-#endif /* CPUINFO_ARCH_ARM */
-				} else {
-					goto unexpected;
-				}
- 				break;
-#if CPUINFO_ARCH_ARM
-			case 6:
-				if (memcmp(feature_start, "iwmmxt", feature_length) == 0) {
-					proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_IWMMXT;
-				} else if (memcmp(feature_start, "crunch", feature_length) == 0) {
-					proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_CRUNCH;
-				} else if (memcmp(feature_start, "vfpd32", feature_length) == 0) {
-					proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_VFPD32;
-				} else {
-					goto unexpected;
-				}
-				break;
-#endif /* CPUINFO_ARCH_ARM */
-			case 7:
-				if (memcmp(feature_start, "evtstrm", feature_length) == 0) {
-					proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_EVTSTRM;
-				} else if (memcmp(feature_start, "atomics", feature_length) == 0) {
-					#if CPUINFO_ARCH_ARM64
-						proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_ATOMICS;
-					#endif
-				} else if (memcmp(feature_start, "asimdhp", feature_length) == 0) {
-					#if CPUINFO_ARCH_ARM64
-						proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_ASIMDHP;
-					#endif
-#if CPUINFO_ARCH_ARM
-				} else if (memcmp(feature_start, "thumbee", feature_length) == 0) {
-					proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_THUMBEE;
-#endif /* CPUINFO_ARCH_ARM */
-				} else {
-					goto unexpected;
-				}
-				break;
-			case 8:
-				if (memcmp(feature_start, "asimdrdm", feature_length) == 0) {
-					#if CPUINFO_ARCH_ARM64
-						proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_ASIMDRDM;
-					#endif
-#if CPUINFO_ARCH_ARM
-				} else if (memcmp(feature_start, "fastmult", feature_length) == 0) {
-					proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_FASTMULT;
-				} else if (memcmp(feature_start, "vfpv3d16", feature_length) == 0) {
-					proc_cpuinfo->features |= PROC_CPUINFO_FEATURE_VFPV3D16;
-#endif /* CPUINFO_ARCH_ARM */
-				} else {
-					goto unexpected;
-				}
-				break;
-			default:
-			unexpected:
-				cpuinfo_log_warning("unexpected /proc/cpuinfo features %.*s is ignored",
-					(int) feature_length, feature_start);
-				break;
+		uint64_t feature_words[2];
+		if (!proc_cpuinfo_pack_name(feature_start, feature_length, feature_words) ||
+			!proc_cpuinfo_lookup_feature(feature_words, &features, &features2))
+		{
+			cpuinfo_log_warning("unexpected /proc/cpuinfo features %.*s is ignored",
+				(int) feature_length, feature_start);
 		}
+
 		feature_start = feature_end;
 		for (; feature_start != features_end; feature_start++) {
 			if (*feature_start != ' ') {
@@ -301,6 +183,15 @@ static void parse_features(
 			}
 		}
 	} while (feature_start != feature_end);
+
+	proc_cpuinfo->features |= features;
+	proc_cpuinfo->features2 |= features2;
+	*cache = (struct features_cache) {
+		.start = features_start,
+		.length = features_length,
+		.features = features,
+		.features2 = features2,
+	};
 }
 
 static void parse_cpu_architecture(
@@ -627,7 +518,8 @@ static uint32_t parse_line(
 	const char* line_start,
 	const char* line_end,
 	uint32_t processor_count,
-	struct proc_cpuinfo* proc_cpuinfo)
+	struct proc_cpuinfo* proc_cpuinfo,
+	struct features_cache features_cache[restrict static 1])
 {
 	/* Empty line. Skip. */
 	if (line_start == line_end) {
@@ -635,14 +527,9 @@ static uint32_t parse_line(
 	}
 	
 	/* Search for ':' on the line. */
-	const char* separator = line_start;
-	for (; separator != line_end; separator++) {
-		if (*separator == ':') {
-			break;
-		}
-	}
+	const char* separator = memchr(line_start, ':', (size_t) (line_end - line_start));
 	/* Skip line if no ':' separator was found. */
-	if (separator == line_end) {
+	if (separator == NULL) {
 		cpuinfo_log_warning("Line %.*s in /proc/cpuinfo is ignored: key/value separator ':' not found",
 			(int) (line_end - line_start), line_start);
 		return processor_count;
@@ -685,145 +572,174 @@ static uint32_t parse_line(
 	}
 
 	const size_t key_length = key_end - line_start;
-	switch (key_length) {
-		case 6:
-			if (memcmp(line_start, "Serial", key_length) == 0) {
-				/* Usually contains just zeros, useless */
-#if CPUINFO_ARCH_ARM
-			} else if (memcmp(line_start, "I size", key_length) == 0) {
-				parse_cache_number(value_start, value_end,
-					"instruction cache size", &proc_cpuinfo->cache.i_size,
-					&proc_cpuinfo->valid_mask, PROC_CPUINFO_VALID_ICACHE_SIZE);
-			} else if (memcmp(line_start, "I sets", key_length) == 0) {
-				parse_cache_number(value_start, value_end,
-					"instruction cache sets", &proc_cpuinfo->cache.i_sets,
-					&proc_cpuinfo->valid_mask, PROC_CPUINFO_VALID_ICACHE_SETS);
-			} else if (memcmp(line_start, "D size", key_length) == 0) {
-				parse_cache_number(value_start, value_end,
-					"data cache size", &proc_cpuinfo->cache.d_size,
-					&proc_cpuinfo->valid_mask, PROC_CPUINFO_VALID_DCACHE_SIZE);
-			} else if (memcmp(line_start, "D sets", key_length) == 0) {
-				parse_cache_number(value_start, value_end,
-					"data cache sets", &proc_cpuinfo->cache.d_sets,
-					&proc_cpuinfo->valid_mask, PROC_CPUINFO_VALID_DCACHE_SETS);
-#endif /* CPUINFO_ARCH_ARM */
-			} else {
-				goto unknown;
-			}
-			break;
-#if CPUINFO_ARCH_ARM
-		case 7:
-			if (memcmp(line_start, "I assoc", key_length) == 0) {
-				parse_cache_number(value_start, value_end,
-					"instruction cache associativity", &proc_cpuinfo->cache.i_assoc,
-					&proc_cpuinfo->valid_mask, PROC_CPUINFO_VALID_ICACHE_WAYS);
-			} else if (memcmp(line_start, "D assoc", key_length) == 0) {
-				parse_cache_number(value_start, value_end,
-					"data cache associativity", &proc_cpuinfo->cache.d_assoc,
-					&proc_cpuinfo->valid_mask, PROC_CPUINFO_VALID_DCACHE_WAYS);
-			} else {
-				goto unknown;
-			}
+	uint64_t key_words[2];
+	enum proc_cpuinfo_key key = proc_cpuinfo_key_unknown;
+	if (proc_cpuinfo_pack_name(line_start, key_length, key_words)) {
+		key = proc_cpuinfo_lookup_key(key_length, key_words);
+	}
+	switch (key) {
+		case proc_cpuinfo_key_ignored:
 			break;
-#endif /* CPUINFO_ARCH_ARM */
-		case 8:
-			if (memcmp(line_start, "CPU part", key_length) == 0) {
-				parse_cpu_part(value_start, value_end, proc_cpuinfo);
-			} else if (memcmp(line_start, "Features", key_length) == 0) {
-				parse_features(value_start, value_end, proc_cpuinfo);
-			} else if (memcmp(line_start, "BogoMIPS", key_length) == 0) {
-				/* BogoMIPS is useless, don't parse */
-			} else if (memcmp(line_start, "Hardware", key_length) == 0) {
-				/* TODO: parse to extract SoC name */
-			} else if (memcmp(line_start, "Revision", key_length) == 0) {
-				/* Board revision, no use for now */
+		case proc_cpuinfo_key_processor:
+		{
+			const uint32_t new_processor_number =
+				parse_processor_number(value_start, value_end, proc_cpuinfo);
+			const uint32_t new_processors_count = new_processor_number + 1;
+			if (new_processor_number < processor_count && new_processor_number != 0) {
+				cpuinfo_log_warning("ignored unexpectedly low processor number %"PRIu32" following processor %"PRIu32" in /proc/cpuinfo",
+					new_processor_number, processor_count - 1);
 			} else {
-				goto unknown;
-			}
-			break;
-		case 9:
-			if (memcmp(line_start, "processor", key_length) == 0) {
-				const uint32_t new_processor_number =
-					parse_processor_number(value_start, value_end, proc_cpuinfo);
-				const uint32_t new_processors_count = new_processor_number + 1;
-				if (new_processor_number < processor_count && new_processor_number != 0) {
-					cpuinfo_log_warning("ignored unexpectedly low processor number %"PRIu32" following processor %"PRIu32" in /proc/cpuinfo",
+				if (new_processor_number > processor_count) {
+					cpuinfo_log_info("unexpectedly high processor number %"PRIu32" following processor %"PRIu32" in /proc/cpuinfo",
 						new_processor_number, processor_count - 1);
-				} else {
-					if (new_processor_number > processor_count) {
-						cpuinfo_log_info("unexpectedly high processor number %"PRIu32" following processor %"PRIu32" in /proc/cpuinfo",
-							new_processor_number, processor_count - 1);
-						return new_processors_count;
-					}
-					return new_processors_count;
 				}
-			} else if (memcmp(line_start, "Processor", key_length) == 0) {
-				/* TODO: parse to fix misreported architecture, similar to Android's cpufeatures */
-			} else {
-				goto unknown;
+				return new_processors_count;
 			}
 			break;
-		case 11:
-			if (memcmp(line_start, "CPU variant", key_length) == 0) {
-				parse_cpu_variant(value_start, value_end, proc_cpuinfo);
-			} else {
-				goto unknown;
-			}
+		}
+		case proc_cpuinfo_key_features:
+			parse_features(value_start, value_end, proc_cpuinfo, features_cache);
 			break;
-		case 12:
-			if (memcmp(line_start, "CPU revision", key_length) == 0) {
-				parse_cpu_revision(value_start, value_end, proc_cpuinfo);
-			} else {
-				goto unknown;
-			}
+		case proc_cpuinfo_key_cpu_architecture:
+			parse_cpu_architecture(value_start, value_end, proc_cpuinfo);
+			break;
+		case proc_cpuinfo_key_cpu_implementer:
+			parse_cpu_implementer(value_start, value_end, proc_cpuinfo);
+			break;
+		case proc_cpuinfo_key_cpu_variant:
+			parse_cpu_variant(value_start, value_end, proc_cpuinfo);
+			break;
+		case proc_cpuinfo_key_cpu_part:
+			parse_cpu_part(value_start, value_end, proc_cpuinfo);
+			break;
+		case proc_cpuinfo_key_cpu_revision:
+			parse_cpu_revision(value_start, value_end, proc_cpuinfo);
 			break;
 #if CPUINFO_ARCH_ARM
-		case 13:
-			if (memcmp(line_start, "I line length", key_length) == 0) {
-				parse_cache_number(value_start, value_end,
-					"instruction cache line size", &proc_cpuinfo->cache.i_line_length,
-					&proc_cpuinfo->valid_mask, PROC_CPUINFO_VALID_ICACHE_LINE);
-			} else if (memcmp(line_start, "D line length", key_length) == 0) {
-				parse_cache_number(value_start, value_end,
-					"data cache line size", &proc_cpuinfo->cache.d_line_length,
-					&proc_cpuinfo->valid_mask, PROC_CPUINFO_VALID_DCACHE_LINE);
-			} else {
-				goto unknown;
-			}
+		case proc_cpuinfo_key_icache_size:
+			parse_cache_number(value_start, value_end,
+				"instruction cache size", &proc_cpuinfo->cache.i_size,
+				&proc_cpuinfo->valid_mask, PROC_CPUINFO_VALID_ICACHE_SIZE);
 			break;
-#endif /* CPUINFO_ARCH_ARM */
-		case 15:
-			if (memcmp(line_start, "CPU implementer", key_length) == 0) {
-				parse_cpu_implementer(value_start, value_end, proc_cpuinfo);
-			} else if (memcmp(line_start, "CPU implementor", key_length) == 0) {
-				parse_cpu_implementer(value_start, value_end, proc_cpuinfo);
-			} else {
-				goto unknown;
-			}
+		case proc_cpuinfo_key_icache_associativity:
+			parse_cache_number(value_start, value_end,
+				"instruction cache associativity", &proc_cpuinfo->cache.i_assoc,
+				&proc_cpuinfo->valid_mask, PROC_CPUINFO_VALID_ICACHE_WAYS);
 			break;
-		case 16:
-			if (memcmp(line_start, "CPU architecture", key_length) == 0) {
-				parse_cpu_architecture(value_start, value_end, proc_cpuinfo);
-			} else {
-				goto unknown;
-			}
+		case proc_cpuinfo_key_icache_line_length:
+			parse_cache_number(value_start, value_end,
+				"instruction cache line size", &proc_cpuinfo->cache.i_line_length,
+				&proc_cpuinfo->valid_mask, PROC_CPUINFO_VALID_ICACHE_LINE);
+			break;
+		case proc_cpuinfo_key_icache_sets:
+			parse_cache_number(value_start, value_end,
+				"instruction cache sets", &proc_cpuinfo->cache.i_sets,
+				&proc_cpuinfo->valid_mask, PROC_CPUINFO_VALID_ICACHE_SETS);
+			break;
+		case proc_cpuinfo_key_dcache_size:
+			parse_cache_number(value_start, value_end,
+				"data cache size", &proc_cpuinfo->cache.d_size,
+				&proc_cpuinfo->valid_mask, PROC_CPUINFO_VALID_DCACHE_SIZE);
 			break;
+		case proc_cpuinfo_key_dcache_associativity:
+			parse_cache_number(value_start, value_end,
+				"data cache associativity", &proc_cpuinfo->cache.d_assoc,
+				&proc_cpuinfo->valid_mask, PROC_CPUINFO_VALID_DCACHE_WAYS);
+			break;
+		case proc_cpuinfo_key_dcache_line_length:
+			parse_cache_number(value_start, value_end,
+				"data cache line size", &proc_cpuinfo->cache.d_line_length,
+				&proc_cpuinfo->valid_mask, PROC_CPUINFO_VALID_DCACHE_LINE);
+			break;
+		case proc_cpuinfo_key_dcache_sets:
+			parse_cache_number(value_start, value_end,
+				"data cache sets", &proc_cpuinfo->cache.d_sets,
+				&proc_cpuinfo->valid_mask, PROC_CPUINFO_VALID_DCACHE_SETS);
+			break;
+#endif /* CPUINFO_ARCH_ARM */
 		default:
-		unknown:
 			cpuinfo_log_debug("unknown /proc/cpuinfo key: %.*s", (int) key_length, line_start);
-
 	}
 	return processor_count;
 }
 
-struct proc_cpuinfo* cpuinfo_arm_linux_parse_proc_cpuinfo(uint32_t processors_count_ptr[restrict static 1]) {
+/* Returns the number of processors which may be brought online, or 0 if it is unknown */
+static uint32_t count_possible_processors(void) {
+	cpu_set_t possible_set;
+	if (!cpuinfo_linux_read_cpulist_at(cpuinfo_linux_sysfs_dir(), "possible", &possible_set)) {
+		return 0;
+	}
+	return (uint32_t) CPU_COUNT(&possible_set);
+}
+
+/*
+ * Reads the whole file into a heap-allocated buffer. Files in procfs report zero size, and the buffer grows
+ * geometrically until the end of file, but with a good initial capacity the contents arrive in a single call.
+ * The buffer keeps PROC_CPUINFO_MAX_NAME_LENGTH zero chars after the contents for proc_cpuinfo_pack_name.
+ */
+static char* read_file(const char* path, size_t capacity, size_t size_ptr[restrict static 1]) {
 	int file = -1;
+	char* buffer = NULL;
+	char* result = NULL;
+	size_t size = 0;
+
+	file = open(path, O_RDONLY);
+	if (file == -1) {
+		cpuinfo_log_error("failed to open %s: %s", path, strerror(errno));
+		goto cleanup;
+	}
+
+	buffer = malloc(capacity);
+	if (buffer == NULL) {
+		cpuinfo_log_error("failed to allocate %zu bytes for contents of %s", capacity, path);
+		goto cleanup;
+	}
+
+	ssize_t bytes_read;
+	do {
+		if (size + PROC_CPUINFO_MAX_NAME_LENGTH == capacity) {
+			char* new_buffer = realloc(buffer, capacity * 2);
+			if (new_buffer == NULL) {
+				cpuinfo_log_error("failed to allocate %zu bytes for contents of %s", capacity * 2, path);
+				goto cleanup;
+			}
+			buffer = new_buffer;
+			capacity *= 2;
+		}
+
+		bytes_read = read(file, &buffer[size], capacity - PROC_CPUINFO_MAX_NAME_LENGTH - size);
+		if (bytes_read < 0) {
+			cpuinfo_log_error("failed to read file %s at position %zu: %s", path, size, strerror(errno));
+			goto cleanup;
+		}
+		size += (size_t) bytes_read;
+	} while (bytes_read != 0);
+	memset(&buffer[size], 0, PROC_CPUINFO_MAX_NAME_LENGTH);
+
+	/* Commit */
+	result = buffer;
+	buffer = NULL;
+	*size_ptr = size;
+
+cleanup:
+	free(buffer);
+	if (file != -1) {
+		close(file);
+		file = -1;
+	}
+	return result;
+}
+
+struct proc_cpuinfo* cpuinfo_arm_linux_parse_proc_cpuinfo(uint32_t processors_count_ptr[restrict static 1]) {
+	char* text = NULL;
 	struct proc_cpuinfo* processors = NULL;
 	struct proc_cpuinfo* result = NULL;
-	uint32_t processors_capacity = 8;
 	uint32_t processors_count = 1;
-	char buffer[BUFFER_SIZE];
 
+	uint32_t processors_capacity = count_possible_processors();
+	if (processors_capacity < MIN_PROCESSORS_CAPACITY) {
+		processors_capacity = MIN_PROCESSORS_CAPACITY;
+	}
 	processors = calloc(processors_capacity, sizeof(struct proc_cpuinfo));
 	if (processors == NULL) {
 		cpuinfo_log_error("failed to allocate %zu bytes for /proc/cpuinfo data",
@@ -832,76 +748,49 @@ struct proc_cpuinfo* cpuinfo_arm_linux_parse_proc_cpuinfo(uint32_t processors_co
 	}
 
 	cpuinfo_log_debug("parsing cpu info from file %s", proc_cpuinfo_path);
-	file = open(proc_cpuinfo_path, O_RDONLY);
-	if (file == -1) {
-		cpuinfo_log_error("failed to open %s: %s", proc_cpuinfo_path, strerror(errno));
+	size_t text_size = 0;
+	text = read_file(proc_cpuinfo_path, (size_t) processors_capacity * PROC_CPUINFO_SIZE_PER_PROCESSOR, &text_size);
+	if (text == NULL) {
 		goto cleanup;
 	}
 
-	size_t position = 0;
-	const char* buffer_end = &buffer[BUFFER_SIZE];
-	char* data_start = buffer;
-	ssize_t bytes_read;
-	do {
-		bytes_read = read(file, data_start, (size_t) (buffer_end - data_start));
-		if (bytes_read < 0) {
-			cpuinfo_log_error("failed to read file %s at position %zu: %s", proc_cpuinfo_path, position, strerror(errno));
-			goto cleanup;
+	struct features_cache features_cache = { 0 };
+	const char* line_start = text;
+	const char* const text_end = text + text_size;
+	while (line_start != text_end) {
+		/* memchr is vectorized in the C library, and locates line ends much faster than a loop over chars */
+		const char* line_end = memchr(line_start, '\n', (size_t) (text_end - line_start));
+		if (line_end == NULL) {
+			/* The last line is not terminated */
+			line_end = text_end;
 		}
 
-		position += (size_t) bytes_read;
-		const char* data_end = data_start + (size_t) bytes_read;
-		const char* line_start = buffer;
-
-		if (bytes_read == 0) {
-			/* No more data in the file: process the remaining text in the buffer as a single entry */
-			const char* line_end = data_end;
-			const uint32_t new_processors_count =
-				parse_line(line_start, line_end, processors_count, &processors[processors_count - 1]);
-			if (new_processors_count > processors_capacity) {
-				processors = realloc(processors, new_processors_count * sizeof(struct proc_cpuinfo));
+		const uint32_t new_processors_count =
+			parse_line(line_start, line_end, processors_count, &processors[processors_count - 1], &features_cache);
+		if (new_processors_count > processors_capacity) {
+			uint32_t new_processors_capacity = processors_capacity * 2;
+			if (new_processors_capacity < new_processors_count) {
+				new_processors_capacity = new_processors_count;
 			}
-			memset(&processors[processors_count], 0, (new_processors_count - processors_count) * sizeof(struct proc_cpuinfo));
-			processors_count = processors_capacity = new_processors_count;
-		} else {
-			const char* line_end;
-			do {
-				/* Find the end of the entry, as indicated by a comma (',') */
-				for (line_end = line_start; line_end != data_end; line_end++) {
-					if (*line_end == '\n') {
-						break;
-					}
-				}
-
-				/*
-				 * If we located separator at the end of the entry, parse it.
-				 * Otherwise, there may be more data at the end; read the file once again.
-				 */
-				if (line_end != data_end) {
-					const uint32_t new_processors_count =
-						parse_line(line_start, line_end, processors_count, &processors[processors_count - 1]);
-					if (new_processors_count > processors_capacity) {
-						processors = realloc(processors, new_processors_count * sizeof(struct proc_cpuinfo));
-					}
-					memset(&processors[processors_count], 0, (new_processors_count - processors_count) * sizeof(struct proc_cpuinfo));
-					processors_count = processors_capacity = new_processors_count;
-					line_start = line_end + 1;
-				}
-			} while (line_end != data_end);
-
-			/* Move remaining partial line data at the end to the beginning of the buffer */
-			const size_t line_length = (size_t) (line_end - line_start);
-			memmove(buffer, line_start, line_length);
-			data_start = &buffer[line_length];
+			struct proc_cpuinfo* new_processors =
+				realloc(processors, new_processors_capacity * sizeof(struct proc_cpuinfo));
+			if (new_processors == NULL) {
+				cpuinfo_log_error("failed to allocate %zu bytes for /proc/cpuinfo data",
+					new_processors_capacity * sizeof(struct proc_cpuinfo));
+				goto cleanup;
+			}
+			memset(&new_processors[processors_capacity], 0,
+				(new_processors_capacity - processors_capacity) * sizeof(struct proc_cpuinfo));
+			processors = new_processors;
+			processors_capacity = new_processors_capacity;
 		}
+		processors_count = new_processors_count;
 
-		if (processors == NULL) {
-			cpuinfo_log_error("failed to allocate %zu bytes for /proc/cpuinfo data",
-				processors_capacity * sizeof(struct proc_cpuinfo));
-			goto cleanup;
+		if (line_end == text_end) {
+			break;
 		}
-	} while (bytes_read != 0);
-
+		line_start = line_end + 1;
+	}
 
 	uint32_t last_i = 0;
 	for (uint32_t i = processors_count; i != 0; i--) {
@@ -936,9 +825,7 @@ struct proc_cpuinfo* cpuinfo_arm_linux_parse_proc_cpuinfo(uint32_t processors_co
 cleanup:
 	free(processors);
 	processors = NULL;
-	if (file != -1) {
-		close(file);
-		file = -1;
-	}
+	free(text);
+	text = NULL;
 	return result;
 }
@@ -2,6 +2,9 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
+
+#include <sched.h>
 
 #include <cpuinfo.h>
 #include <arm/linux/api.h>
@@ -16,34 +19,82 @@ struct cpuinfo_arm_isa cpuinfo_isa = { 0 };
 
 void cpuinfo_arm_linux_init(void) {
 	uint32_t proc_cpuinfo_count = 0;
+	struct cpuinfo_arena arena = { 0 };
+	struct cpuinfo_tables* tables = NULL;
 	struct cpuinfo_processor* processors = NULL;
 	struct cpuinfo_cache* l1i = NULL;
 	struct cpuinfo_cache* l1d = NULL;
 	struct cpuinfo_cache* l2 = NULL;
+	struct cpuinfo_frequency_domain* frequency_domains = NULL;
+	uint32_t* online_mask = NULL;
+	uint32_t* available_processors = NULL;
+	uint32_t* isolated_processors = NULL;
 	uint32_t processors_count = 0;
 	uint32_t l1i_count = 0;
 	uint32_t l1d_count = 0;
 	uint32_t l2_count = 0;
+	uint32_t frequency_domains_count = 0;
+	struct cpuinfo_arm_isa isa = { 0 };
+	#if CPUINFO_ARCH_ARM64
+		struct cpuinfo_arm_sve sve = { 0 };
+	#endif
 
 	struct proc_cpuinfo* proc_cpuinfo_entries = cpuinfo_arm_linux_parse_proc_cpuinfo(&proc_cpuinfo_count);
 
 	if (proc_cpuinfo_count != 0) {
 		#if CPUINFO_ARCH_ARM
 			cpuinfo_arm_linux_decode_isa_from_proc_cpuinfo(
-				proc_cpuinfo_entries, proc_cpuinfo_count, &cpuinfo_isa);
+				proc_cpuinfo_entries, proc_cpuinfo_count, &isa);
 		#elif CPUINFO_ARCH_ARM64
-			cpuinfo_arm64_linux_decode_isa_from_proc_cpuinfo(
-				proc_cpuinfo_entries, &cpuinfo_isa);
+			/* Prefer the auxiliary vector: it needs no text parsing and lists every feature known to the kernel */
+			uint32_t isa_features = 0;
+			uint64_t isa_features2 = 0;
+			if (!cpuinfo_arm64_linux_read_hwcap(&isa_features, &isa_features2)) {
+				cpuinfo_log_debug("AT_HWCAP is not available: using features from /proc/cpuinfo");
+				isa_features = proc_cpuinfo_entries[0].features;
+				isa_features2 = proc_cpuinfo_entries[0].features2;
+			}
+			cpuinfo_arm64_linux_decode_isa(isa_features, isa_features2, &isa);
+			if (isa.sve) {
+				cpuinfo_arm64_linux_detect_sve(&sve);
+			}
 		#endif
 		processors_count = proc_cpuinfo_count;
 
-		processors = calloc(processors_count, sizeof(struct cpuinfo_processor));
-		if (processors == NULL) {
-			cpuinfo_log_error("failed to allocate %zu bytes for descriptions of %"PRIu32" logical processors",
-				proc_cpuinfo_count * sizeof(struct cpuinfo_processor), proc_cpuinfo_count);
+		/*
+		 * Presence of caches is decoded from the microarchitecture, which is only known after the processors
+		 * table is filled. Reserve private L1 caches for every processor and a shared L2 cache, and leave the
+		 * tables unpublished if the caches are not detected. Frequency domains are at most one per processor.
+		 */
+		const size_t tables_offset = cpuinfo_arena_reserve(&arena, 1, sizeof(struct cpuinfo_tables));
+		const size_t processors_offset =
+			cpuinfo_arena_reserve(&arena, processors_count, sizeof(struct cpuinfo_processor));
+		const size_t l1i_offset = cpuinfo_arena_reserve(&arena, processors_count, sizeof(struct cpuinfo_cache));
+		const size_t l1d_offset = cpuinfo_arena_reserve(&arena, processors_count, sizeof(struct cpuinfo_cache));
+		const size_t l2_offset  = cpuinfo_arena_reserve(&arena, 1, sizeof(struct cpuinfo_cache));
+		const size_t frequency_domains_offset =
+			cpuinfo_arena_reserve(&arena, processors_count, sizeof(struct cpuinfo_frequency_domain));
+		const size_t online_mask_offset =
+			cpuinfo_arena_reserve(&arena, (processors_count + 31) / 32, sizeof(uint32_t));
+		const size_t available_processors_offset =
+			cpuinfo_arena_reserve(&arena, processors_count, sizeof(uint32_t));
+		const size_t isolated_processors_offset =
+			cpuinfo_arena_reserve(&arena, processors_count, sizeof(uint32_t));
+		if (!cpuinfo_arena_allocate(&arena)) {
 			goto cleanup;
 		}
+		tables = cpuinfo_arena_table(&arena, tables_offset);
+		processors = cpuinfo_arena_table(&arena, processors_offset);
+		frequency_domains = cpuinfo_arena_table(&arena, frequency_domains_offset);
+		online_mask = cpuinfo_arena_table(&arena, online_mask_offset);
+		available_processors = cpuinfo_arena_table(&arena, available_processors_offset);
+		isolated_processors = cpuinfo_arena_table(&arena, isolated_processors_offset);
 		for (uint32_t i = 0; i < proc_cpuinfo_count; i++) {
+			/*
+			 * Some kernels print only one block of identification fields in /proc/cpuinfo, for the processor
+			 * which reads the file, and it is copied to all processors. Per-processor MIDR in sysfs is exact.
+			 */
+			cpuinfo_arm_linux_detect_midr(i, &proc_cpuinfo_entries[i], &processors[i].midr, &processors[i].revidr);
 			cpuinfo_arm_decode_vendor_uarch(
 				proc_cpuinfo_entries[i].implementer,
 				proc_cpuinfo_entries[i].part,
@@ -90,12 +141,7 @@ void cpuinfo_arm_linux_init(void) {
 		cpuinfo_log_info("detected %"PRIu32" L2 caches", l2_count);
 
 		if (l1i_count != 0) {
-			l1i = malloc(l1i_count * sizeof(struct cpuinfo_cache));
-			if (l1i == NULL) {
-				cpuinfo_log_error("failed to allocate %zu bytes for descriptions of %"PRIu32" L1I caches",
-					l1i_count * sizeof(struct cpuinfo_cache), l1i_count);
-				goto cleanup;
-			}
+			l1i = cpuinfo_arena_table(&arena, l1i_offset);
 			for (uint32_t i = 0; i < l1i_count; i++) {
 				/* L1I reported in /proc/cpuinfo overrides defaults */
 				#if CPUINFO_ARCH_ARM
@@ -125,15 +171,11 @@ void cpuinfo_arm_linux_init(void) {
 				#endif
 				l1i[i].thread_start = i;
 				l1i[i].thread_count = 1;
+				processors[i].cache.l1i = &l1i[i];
 			}
 		}
 		if (l1d_count != 0) {
-			l1d = malloc(l1d_count * sizeof(struct cpuinfo_cache));
-			if (l1d == NULL) {
-				cpuinfo_log_error("failed to allocate %zu bytes for descriptions of %"PRIu32" L1D caches",
-					l1d_count * sizeof(struct cpuinfo_cache), l1d_count);
-				goto cleanup;
-			}
+			l1d = cpuinfo_arena_table(&arena, l1d_offset);
 			for (uint32_t i = 0; i < l1d_count; i++) {
 				#if CPUINFO_ARCH_ARM
 					/* L1D reported in /proc/cpuinfo overrides defaults */
@@ -163,40 +205,74 @@ void cpuinfo_arm_linux_init(void) {
 				#endif
 				l1d[i].thread_start = i;
 				l1d[i].thread_count = 1;
+				processors[i].cache.l1d = &l1d[i];
 			}
 		}
 		if (l2_count != 0) {
-			l2 = malloc(l2_count * sizeof(struct cpuinfo_cache));
-			if (l2 == NULL) {
-				cpuinfo_log_error("failed to allocate %zu bytes for descriptions of %"PRIu32" L2 caches",
-					l2_count * sizeof(struct cpuinfo_cache), l2_count);
-				goto cleanup;
-			}
+			l2 = cpuinfo_arena_table(&arena, l2_offset);
 			/* L2 cache is never reported in /proc/cpuinfo; use defaults */
 			*l2 = shared_l2;
 			l2->thread_start = 0;
 			l2->thread_count = proc_cpuinfo_count;
+			for (uint32_t i = 0; i < proc_cpuinfo_count; i++) {
+				processors[i].cache.l2 = l2;
+			}
 		}
 	}
 
+	if (processors_count != 0) {
+		frequency_domains_count =
+			cpuinfo_linux_detect_frequency_domains(processors_count, processors, frequency_domains);
+	}
+
 	/* Commit */
-	cpuinfo_processors = processors;
-	cpuinfo_cache[cpuinfo_cache_level_1i] = l1i;
-	cpuinfo_cache[cpuinfo_cache_level_1d] = l1d;
-	cpuinfo_cache[cpuinfo_cache_level_2]  = l2;
+	if (tables == NULL) {
+		/* No processors detected: keep the tables of the previous initialization, if any */
+		goto cleanup;
+	}
+	tables->isa = isa;
+	#if CPUINFO_ARCH_ARM64
+		tables->sve = sve;
+	#endif
+	/* Hypervisors are not detected on ARM */
+	tables->hypervisor = (struct cpuinfo_hypervisor) { .topology_trusted = true };
+	/* Kernel configuration of resource allocation takes precedence over processor capabilities */
+	cpuinfo_linux_detect_resctrl(&tables->qos);
+	tables->arena = arena;
+	tables->processors = processors;
+	tables->cache[cpuinfo_cache_level_1i] = l1i;
+	tables->cache[cpuinfo_cache_level_1d] = l1d;
+	tables->cache[cpuinfo_cache_level_2]  = l2;
+	tables->frequency_domains = frequency_domains_count != 0 ? frequency_domains : NULL;
 
-	cpuinfo_processors_count = processors_count;
-	cpuinfo_cache_count[cpuinfo_cache_level_1i] = l1i_count;
-	cpuinfo_cache_count[cpuinfo_cache_level_1d] = l1d_count;
-	cpuinfo_cache_count[cpuinfo_cache_level_2]  = l2_count;
+	tables->processors_count = processors_count;
+	tables->cache_count[cpuinfo_cache_level_1i] = l1i_count;
+	tables->cache_count[cpuinfo_cache_level_1d] = l1d_count;
+	tables->cache_count[cpuinfo_cache_level_2]  = l2_count;
+	tables->frequency_domains_count = frequency_domains_count;
+
+	/* /proc/cpuinfo lists only online processors, but the kernel may not report the online set */
+	cpu_set_t online_set;
+	const bool online_set_valid = cpuinfo_linux_read_cpulist_at(cpuinfo_linux_sysfs_dir(), "online", &online_set);
+	tables->online_mask = online_mask;
+	cpuinfo_linux_update_online_processors(tables, online_set_valid ? &online_set : NULL);
+
+	cpu_set_t affinity;
+	const bool affinity_valid = sched_getaffinity(0, sizeof(cpu_set_t), &affinity) == 0;
+	if (!affinity_valid) {
+		cpuinfo_log_warning("sched_getaffinity failed: %s", strerror(errno));
+	}
+	cpuinfo_linux_detect_isolation(processors_count, processors);
+	tables->available_processors = available_processors;
+	tables->isolated_processors = isolated_processors;
+	cpuinfo_linux_detect_available_processors(tables, affinity_valid ? &affinity : NULL);
 
-	processors = NULL;
-	l1i = l1d = l2 = NULL;
+	cpuinfo_isa = isa;
+	cpuinfo_publish_tables(tables);
+	arena = (struct cpuinfo_arena) { 0 };
 
 cleanup:
-	free(processors);
-	free(l1i);
-	free(l1d);
-	free(l2);
+	cpuinfo_arena_free(&arena);
 	free(proc_cpuinfo_entries);
+	cpuinfo_linux_sysfs_close();
 }
@@ -0,0 +1,79 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <cpuinfo.h>
+#include <arm/linux/api.h>
+#include <linux/api.h>
+#include <log.h>
+
+
+#define MIDR_IMPLEMENTER_OFFSET  24
+#define MIDR_VARIANT_OFFSET      20
+#define MIDR_ARCHITECTURE_OFFSET 16
+#define MIDR_PART_OFFSET          4
+#define MIDR_REVISION_OFFSET      0
+
+#define MIDR_IMPLEMENTER_MASK  UINT32_C(0xFF000000)
+#define MIDR_VARIANT_MASK      UINT32_C(0x00F00000)
+#define MIDR_ARCHITECTURE_MASK UINT32_C(0x000F0000)
+#define MIDR_PART_MASK         UINT32_C(0x0000FFF0)
+#define MIDR_REVISION_MASK     UINT32_C(0x0000000F)
+
+/* Value of the architecture field for processors which use CPUID identification scheme (ARMv6 and later) */
+#define MIDR_ARCHITECTURE_CPUID_SCHEME UINT32_C(0xF)
+
+#define PROC_CPUINFO_VALID_MIDR \
+	(PROC_CPUINFO_VALID_IMPLEMENTER | PROC_CPUINFO_VALID_VARIANT | PROC_CPUINFO_VALID_PART | PROC_CPUINFO_VALID_REVISION)
+
+
+/*
+ * Reads a hexadecimal register value, as printed by the kernel in regs/identification sysfs files (e.g. 0x00000000410fd034).
+ * Returns false if the file does not exist or can not be parsed.
+ */
+static bool read_register(uint32_t processor, const char* name, uint64_t value_ptr[restrict static 1]) {
+	return cpuinfo_linux_read_number_at(cpuinfo_linux_sysfs_processor_dir(processor), name, 16, value_ptr);
+}
+
+static uint32_t encode_midr(const struct proc_cpuinfo proc_cpuinfo[restrict static 1]) {
+	return ((proc_cpuinfo->implementer << MIDR_IMPLEMENTER_OFFSET) & MIDR_IMPLEMENTER_MASK) |
+		((proc_cpuinfo->variant << MIDR_VARIANT_OFFSET) & MIDR_VARIANT_MASK) |
+		(MIDR_ARCHITECTURE_CPUID_SCHEME << MIDR_ARCHITECTURE_OFFSET) |
+		((proc_cpuinfo->part << MIDR_PART_OFFSET) & MIDR_PART_MASK) |
+		((proc_cpuinfo->revision << MIDR_REVISION_OFFSET) & MIDR_REVISION_MASK);
+}
+
+bool cpuinfo_arm_linux_detect_midr(
+	uint32_t processor,
+	struct proc_cpuinfo proc_cpuinfo[restrict static 1],
+	uint32_t midr_ptr[restrict static 1],
+	uint32_t revidr_ptr[restrict static 1])
+{
+	uint64_t midr = 0, revidr = 0;
+	if (!read_register(processor, "regs/identification/midr_el1", &midr)) {
+		*midr_ptr = encode_midr(proc_cpuinfo);
+		*revidr_ptr = 0;
+		return false;
+	}
+	if (!read_register(processor, "regs/identification/revidr_el1", &revidr)) {
+		revidr = 0;
+	}
+
+	/* Only the lower 32 bits of MIDR_EL1 and REVIDR_EL1 are defined */
+	const uint32_t midr32 = (uint32_t) midr;
+	if ((proc_cpuinfo->valid_mask & PROC_CPUINFO_VALID_MIDR) == PROC_CPUINFO_VALID_MIDR) {
+		const uint32_t proc_cpuinfo_midr = encode_midr(proc_cpuinfo);
+		if ((proc_cpuinfo_midr & ~MIDR_ARCHITECTURE_MASK) != (midr32 & ~MIDR_ARCHITECTURE_MASK)) {
+			cpuinfo_log_info("MIDR 0x%08"PRIx32" of processor %"PRIu32" in sysfs overrides 0x%08"PRIx32" in /proc/cpuinfo",
+				midr32, processor, proc_cpuinfo_midr);
+		}
+	}
+	proc_cpuinfo->implementer = (midr32 & MIDR_IMPLEMENTER_MASK) >> MIDR_IMPLEMENTER_OFFSET;
+	proc_cpuinfo->variant = (midr32 & MIDR_VARIANT_MASK) >> MIDR_VARIANT_OFFSET;
+	proc_cpuinfo->part = (midr32 & MIDR_PART_MASK) >> MIDR_PART_OFFSET;
+	proc_cpuinfo->revision = (midr32 & MIDR_REVISION_MASK) >> MIDR_REVISION_OFFSET;
+	proc_cpuinfo->valid_mask |= PROC_CPUINFO_VALID_MIDR;
+
+	*midr_ptr = midr32;
+	*revidr_ptr = (uint32_t) revidr;
+	return true;
+}
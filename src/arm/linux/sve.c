@@ -0,0 +1,170 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/prctl.h>
+
+#if CPUINFO_MOCK
+	#include <cpuinfo-mock.h>
+#endif
+#include <cpuinfo.h>
+#include <arm/linux/api.h>
+#include <linux/api.h>
+#include <api.h>
+#include <log.h>
+
+
+/* Values from include/uapi/linux/prctl.h, missing in older C library headers */
+#ifndef PR_SVE_SET_VL
+	#define PR_SVE_SET_VL 50
+#endif
+#ifndef PR_SVE_GET_VL
+	#define PR_SVE_GET_VL 51
+#endif
+#ifndef PR_SVE_VL_LEN_MASK
+	#define PR_SVE_VL_LEN_MASK 0xFFFF
+#endif
+#ifndef PR_SVE_VL_INHERIT
+	#define PR_SVE_VL_INHERIT (1 << 17)
+#endif
+
+/* Vector length is a multiple of 128 bits */
+#define SVE_VL_GRANULE 16
+/* Largest vector length accepted by the kernel; requests above the hardware limit are clamped to it */
+#define SVE_VL_MAX 8192
+
+static const char* proc_sys_abi_path = "/proc/sys/abi";
+
+#if CPUINFO_MOCK
+	static uint32_t mock_vector_length = 0;
+	static uint32_t mock_max_vector_length = 0;
+
+	void CPUINFO_ABI cpuinfo_set_proc_sys_abi_path(const char* path) {
+		/* Note: this leaks memory */
+		proc_sys_abi_path = strdup(path);
+	}
+
+	void CPUINFO_ABI cpuinfo_set_sve_max_vector_length(uint32_t max_vector_length) {
+		mock_max_vector_length = max_vector_length;
+		mock_vector_length = max_vector_length;
+	}
+#endif
+
+
+/* Returns vector length and flags, or -1 on failure, as the PR_SVE_GET_VL and PR_SVE_SET_VL calls do */
+static int sve_prctl(int option, unsigned long arg) {
+	#if CPUINFO_MOCK
+		if (mock_max_vector_length == 0) {
+			errno = EINVAL;
+			return -1;
+		}
+		if (option == PR_SVE_SET_VL) {
+			uint32_t vector_length = (uint32_t) (arg & PR_SVE_VL_LEN_MASK);
+			if (vector_length < SVE_VL_GRANULE || vector_length > SVE_VL_MAX) {
+				errno = EINVAL;
+				return -1;
+			}
+			if (vector_length > mock_max_vector_length) {
+				vector_length = mock_max_vector_length;
+			}
+			mock_vector_length = vector_length - vector_length % SVE_VL_GRANULE;
+			return (int) (mock_vector_length | (arg & PR_SVE_VL_INHERIT));
+		}
+		return (int) mock_vector_length;
+	#else
+		return prctl(option, arg, 0, 0, 0);
+	#endif
+}
+
+/* Reads a decimal number of bytes from a file in /proc/sys/abi, or returns 0 on failure */
+static uint32_t read_proc_sys_abi(const char* name) {
+	const int dir = cpuinfo_linux_open_dir(AT_FDCWD, proc_sys_abi_path);
+	if (dir == -1) {
+		return 0;
+	}
+
+	uint64_t value = 0;
+	if (!cpuinfo_linux_read_number_at(dir, name, 10, &value)) {
+		value = 0;
+	}
+	close(dir);
+	return (uint32_t) value;
+}
+
+void cpuinfo_arm64_linux_detect_sve(struct cpuinfo_arm_sve sve[restrict static 1]) {
+	sve->default_vector_length = read_proc_sys_abi("sve_default_vector_length");
+
+	const int vl = sve_prctl(PR_SVE_GET_VL, 0);
+	if (vl < 0) {
+		cpuinfo_log_warning("failed to query SVE vector length: %s", strerror(errno));
+		return;
+	}
+	sve->vector_length = (uint32_t) vl & PR_SVE_VL_LEN_MASK;
+}
+
+struct cpuinfo_arm_sve CPUINFO_ABI cpuinfo_get_sve(void) {
+	return cpuinfo_get_tables()->sve;
+}
+
+uint32_t CPUINFO_ABI cpuinfo_get_sve_vector_length(void) {
+	if (!cpuinfo_get_tables()->isa.sve) {
+		return 0;
+	}
+	const int vl = sve_prctl(PR_SVE_GET_VL, 0);
+	if (vl < 0) {
+		return 0;
+	}
+	return (uint32_t) vl & PR_SVE_VL_LEN_MASK;
+}
+
+uint32_t CPUINFO_ABI cpuinfo_probe_sve_max_vector_length(void) {
+	if (!cpuinfo_get_tables()->isa.sve) {
+		return 0;
+	}
+	const int vl = sve_prctl(PR_SVE_GET_VL, 0);
+	if (vl < 0) {
+		cpuinfo_log_warning("failed to query SVE vector length: %s", strerror(errno));
+		return 0;
+	}
+
+	/*
+	 * The kernel clamps requested vector length to the largest one supported by all processors.
+	 * Setting vector length also cancels a length deferred with PR_SVE_SET_VL_ONEXEC, which
+	 * PR_SVE_GET_VL does not report, so the probe is done only on request.
+	 */
+	const int max_vl = sve_prctl(PR_SVE_SET_VL, SVE_VL_MAX);
+	if (max_vl < 0) {
+		cpuinfo_log_warning("failed to probe maximum SVE vector length: %s", strerror(errno));
+		return 0;
+	}
+	if (sve_prctl(PR_SVE_SET_VL, (unsigned long) vl & (PR_SVE_VL_LEN_MASK | PR_SVE_VL_INHERIT)) < 0) {
+		cpuinfo_log_error("failed to restore SVE vector length %"PRIu32": %s",
+			(uint32_t) vl & PR_SVE_VL_LEN_MASK, strerror(errno));
+	}
+	return (uint32_t) max_vl & PR_SVE_VL_LEN_MASK;
+}
+
+uint32_t CPUINFO_ABI cpuinfo_set_sve_vector_length(uint32_t vector_length, bool inherit) {
+	if (!cpuinfo_get_tables()->isa.sve) {
+		cpuinfo_log_warning("can not set SVE vector length: SVE is not supported");
+		return 0;
+	}
+	if (vector_length < SVE_VL_GRANULE || vector_length > SVE_VL_MAX || vector_length % SVE_VL_GRANULE != 0) {
+		cpuinfo_log_warning("invalid SVE vector length %"PRIu32": expected a multiple of %d bytes between %d and %d",
+			vector_length, SVE_VL_GRANULE, SVE_VL_GRANULE, SVE_VL_MAX);
+		return 0;
+	}
+	unsigned long arg = vector_length;
+	if (inherit) {
+		arg |= PR_SVE_VL_INHERIT;
+	}
+	const int vl = sve_prctl(PR_SVE_SET_VL, arg);
+	if (vl < 0) {
+		cpuinfo_log_warning("failed to set SVE vector length %"PRIu32": %s", vector_length, strerror(errno));
+		return 0;
+	}
+	return (uint32_t) vl & PR_SVE_VL_LEN_MASK;
+}
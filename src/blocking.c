@@ -0,0 +1,113 @@
+#include <stdint.h>
+#include <stddef.h>
+
+#include <cpuinfo.h>
+#include <api.h>
+#include <log.h>
+
+
+static inline uint32_t min(uint32_t a, uint32_t b) {
+	return a < b ? a : b;
+}
+
+static inline uint32_t max(uint32_t a, uint32_t b) {
+	return a > b ? a : b;
+}
+
+/*
+ * Estimates the number of bytes in the cache available to one logical processor for blocked data:
+ * - One way of associativity is left to the stack, loop-invariant data, and imperfect LRU replacement.
+ * - Capacity is split between the logical processors sharing the cache and running the blocked code.
+ * - Exclusive caches hold only data evicted from the inner level, and add its capacity. Non-inclusive caches
+ *   may still duplicate inner data, and add nothing.
+ */
+static uint32_t usable_capacity(
+	const struct cpuinfo_cache cache[restrict static 1],
+	uint32_t inner_capacity,
+	uint32_t smt_threads_per_core,
+	uint32_t smt_threads_active)
+{
+	const uint32_t ways = max(cache->associativity, 1);
+	const uint32_t way_size = cache->size / ways;
+	const uint32_t usable_ways = ways > 1 ? ways - 1 : 1;
+
+	const uint32_t threads = max(cache->thread_count, 1);
+	uint32_t sharers = threads;
+	if (threads >= smt_threads_per_core) {
+		sharers = (threads / smt_threads_per_core) * smt_threads_active;
+	}
+	sharers = max(sharers, 1);
+
+	uint32_t capacity = (uint32_t) ((uint64_t) usable_ways * (uint64_t) way_size / sharers);
+	if (cache->flags & CPUINFO_CACHE_EXCLUSIVE) {
+		capacity += inner_capacity;
+	}
+	return capacity;
+}
+
+static uint32_t block_elements(
+	const struct cpuinfo_cache cache[restrict static 1],
+	uint32_t capacity,
+	const struct cpuinfo_working_set working_set[restrict static 1])
+{
+	uint32_t stream_bytes = capacity / working_set->streams;
+	if (working_set->reuse == cpuinfo_reuse_streaming) {
+		/* Half of the capacity holds the block being consumed, the other half the block being brought in */
+		stream_bytes /= 2;
+	}
+
+	uint32_t elements = stream_bytes / working_set->element_size;
+
+	/* Round down to whole cache lines so that blocks of different streams do not share lines */
+	const uint32_t line_elements = cache->line_size / working_set->element_size;
+	if (line_elements > 1 && elements >= line_elements) {
+		elements -= elements % line_elements;
+	}
+	return elements;
+}
+
+struct cpuinfo_blocking CPUINFO_ABI cpuinfo_get_blocking(
+	const struct cpuinfo_working_set* working_set, uint32_t processor)
+{
+	struct cpuinfo_blocking blocking = { 0 };
+	if (working_set == NULL || working_set->element_size == 0 || working_set->streams == 0) {
+		cpuinfo_log_warning("invalid working set description: blocking advice is not available");
+		return blocking;
+	}
+	const struct cpuinfo_tables* tables = cpuinfo_get_tables();
+	if (processor >= tables->processors_count) {
+		cpuinfo_log_warning("invalid processor %"PRIu32" (%"PRIu32" processors detected): blocking advice is not available",
+			processor, tables->processors_count);
+		return blocking;
+	}
+
+	const struct cpuinfo_cache* l1d = tables->processors[processor].cache.l1d;
+	const struct cpuinfo_cache* l2  = tables->processors[processor].cache.l2;
+	const struct cpuinfo_cache* l3  = tables->processors[processor].cache.l3;
+
+	/* L1 data cache is private to a core, thus it is shared only by SMT threads */
+	uint32_t smt_threads_per_core = 1;
+	if (l1d != NULL && l1d->thread_count != 0) {
+		smt_threads_per_core = l1d->thread_count;
+	}
+	uint32_t smt_threads_active = smt_threads_per_core;
+	/* On virtual machines SMT siblings may be fake, or run other guests, and are not assumed to be idle */
+	if (working_set->smt_threads != 0 && tables->hypervisor.topology_trusted) {
+		smt_threads_active = min(working_set->smt_threads, smt_threads_per_core);
+	}
+
+	uint32_t inner_capacity = 0;
+	if (l1d != NULL && l1d->size != 0) {
+		inner_capacity = usable_capacity(l1d, 0, smt_threads_per_core, smt_threads_active);
+		blocking.l1 = block_elements(l1d, inner_capacity, working_set);
+	}
+	if (l2 != NULL && l2->size != 0) {
+		inner_capacity = usable_capacity(l2, inner_capacity, smt_threads_per_core, smt_threads_active);
+		blocking.l2 = block_elements(l2, inner_capacity, working_set);
+	}
+	if (l3 != NULL && l3->size != 0) {
+		inner_capacity = usable_capacity(l3, inner_capacity, smt_threads_per_core, smt_threads_active);
+		blocking.l3 = block_elements(l3, inner_capacity, working_set);
+	}
+	return blocking;
+}
@@ -4,40 +4,30 @@
 #include <api.h>
 
 
-struct cpuinfo_cache* cpuinfo_cache[cpuinfo_cache_level_max] = { NULL };
-uint32_t cpuinfo_cache_count[cpuinfo_cache_level_max] = { 0 };
-
-struct cpuinfo_caches CPUINFO_ABI cpuinfo_get_l1i_cache(void) {
+static inline struct cpuinfo_caches get_caches(enum cpuinfo_cache_level level) {
+	const struct cpuinfo_tables* tables = cpuinfo_get_tables();
 	return (struct cpuinfo_caches) {
-		.count = cpuinfo_cache_count[cpuinfo_cache_level_1i],
-		.instances = cpuinfo_cache[cpuinfo_cache_level_1i]
+		.count = tables->cache_count[level],
+		.instances = tables->cache[level]
 	};
 }
 
+struct cpuinfo_caches CPUINFO_ABI cpuinfo_get_l1i_cache(void) {
+	return get_caches(cpuinfo_cache_level_1i);
+}
+
 struct cpuinfo_caches CPUINFO_ABI cpuinfo_get_l1d_cache(void) {
-	return (struct cpuinfo_caches) {
-		.count = cpuinfo_cache_count[cpuinfo_cache_level_1d],
-		.instances = cpuinfo_cache[cpuinfo_cache_level_1d]
-	};
+	return get_caches(cpuinfo_cache_level_1d);
 }
 
 struct cpuinfo_caches CPUINFO_ABI cpuinfo_get_l2_cache(void) {
-	return (struct cpuinfo_caches) {
-		.count = cpuinfo_cache_count[cpuinfo_cache_level_2],
-		.instances = cpuinfo_cache[cpuinfo_cache_level_2]
-	};
+	return get_caches(cpuinfo_cache_level_2);
 }
 
 struct cpuinfo_caches CPUINFO_ABI cpuinfo_get_l3_cache(void) {
-	return (struct cpuinfo_caches) {
-		.count = cpuinfo_cache_count[cpuinfo_cache_level_3],
-		.instances = cpuinfo_cache[cpuinfo_cache_level_3]
-	};
+	return get_caches(cpuinfo_cache_level_3);
 }
 
 struct cpuinfo_caches CPUINFO_ABI cpuinfo_get_l4_cache(void) {
-	return (struct cpuinfo_caches) {
-		.count = cpuinfo_cache_count[cpuinfo_cache_level_4],
-		.instances = cpuinfo_cache[cpuinfo_cache_level_4]
-	};
+	return get_caches(cpuinfo_cache_level_4);
 }
@@ -0,0 +1,22 @@
+#include <stdint.h>
+#include <stddef.h>
+
+#include <cpuinfo.h>
+#include <api.h>
+
+
+uint32_t CPUINFO_ABI cpuinfo_get_core_type_processors(
+	enum cpuinfo_core_type core_type, uint32_t max_count, uint32_t* processors)
+{
+	const struct cpuinfo_tables* tables = cpuinfo_get_tables();
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < tables->processors_count; i++) {
+		if (tables->processors[i].core_type == core_type) {
+			if (count < max_count) {
+				processors[count] = i;
+			}
+			count++;
+		}
+	}
+	return count;
+}
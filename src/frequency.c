@@ -0,0 +1,13 @@
+#include <stddef.h>
+
+#include <cpuinfo.h>
+#include <api.h>
+
+
+struct cpuinfo_frequency_domains CPUINFO_ABI cpuinfo_get_frequency_domains(void) {
+	const struct cpuinfo_tables* tables = cpuinfo_get_tables();
+	return (struct cpuinfo_frequency_domains) {
+		.count = tables->frequency_domains_count,
+		.instances = tables->frequency_domains
+	};
+}
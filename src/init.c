@@ -1,7 +1,14 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
 #include <pthread.h>
 
 #include <cpuinfo.h>
 #include <api.h>
+#if defined(__linux__)
+	#include <linux/api.h>
+#endif
 
 
 struct cpuinfo_processor* cpuinfo_processors = NULL;
@@ -12,28 +19,200 @@ uint32_t cpuinfo_processors_count = 0;
 uint32_t cpuinfo_cores_count = 0;
 uint32_t cpuinfo_packages_count = 0;
 
+/* Physical hardware, unless architecture-specific initialization detects a hypervisor */
+static const struct cpuinfo_tables no_tables = { .hypervisor = { .topology_trusted = true } };
+const struct cpuinfo_tables* cpuinfo_tables = &no_tables;
 
-static pthread_once_t init_guard = PTHREAD_ONCE_INIT;
+/*
+ * Initialization, re-initialization, and de-initialization are serialized by the mutex.
+ * Readers never take it: they load the tables pointer, which is replaced only after the new tables are complete.
+ */
+static pthread_mutex_t init_mutex = PTHREAD_MUTEX_INITIALIZER;
+static bool initialized = false;
+static uint64_t tables_version = 0;
 
-void CPUINFO_ABI cpuinfo_initialize(void) {
+/* Changes on every publication and update of the tables. 32-bit to stay lock-free on all targets. */
+static uint32_t generation = 0;
+
+
+/* Frees the tables together with all tables they replaced */
+static void free_tables(struct cpuinfo_tables* tables) {
+	while (tables != NULL) {
+		struct cpuinfo_tables* retired = tables->retired;
+		/* The descriptor of the arena is inside the arena */
+		struct cpuinfo_arena arena = tables->arena;
+		cpuinfo_arena_free(&arena);
+		tables = retired;
+	}
+}
+
+void cpuinfo_publish_tables(struct cpuinfo_tables tables[restrict static 1]) {
+	tables->version = ++tables_version;
+
+	/* Readers which loaded the previous tables may use them at any time, so they are never freed before deinit */
+	const struct cpuinfo_tables* previous_tables = cpuinfo_tables;
+	tables->retired = previous_tables != &no_tables ? (struct cpuinfo_tables*) previous_tables : NULL;
+	__atomic_store_n(&cpuinfo_tables, tables, __ATOMIC_RELEASE);
+
+	/* Legacy variables are not published atomically, see cpuinfo_reinitialize */
+	cpuinfo_processors = tables->processors;
+	cpuinfo_processors_count = tables->processors_count;
+	cpuinfo_advance_generation();
+}
+
+void cpuinfo_lock_initialization(void) {
+	pthread_mutex_lock(&init_mutex);
+}
+
+void cpuinfo_unlock_initialization(void) {
+	pthread_mutex_unlock(&init_mutex);
+}
+
+void cpuinfo_advance_generation(void) {
+	__atomic_add_fetch(&generation, 1, __ATOMIC_RELEASE);
+}
+
+static void detect(void) {
 #if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
 	#if defined(__MACH__) && defined(__APPLE__)
-		pthread_once(&init_guard, &cpuinfo_x86_mach_init);
+		cpuinfo_x86_mach_init();
 	#elif defined(__linux__)
-		pthread_once(&init_guard, &cpuinfo_x86_linux_init);
+		cpuinfo_x86_linux_init();
 	#else
 		#error Unsupported target OS
 	#endif
 #elif CPUINFO_ARCH_ARM || CPUINFO_ARCH_ARM64
 	#if defined(__linux__)
-		pthread_once(&init_guard, &cpuinfo_arm_linux_init);
+		cpuinfo_arm_linux_init();
 	#else
 		#error Unsupported target OS
 	#endif
 #else
 	#error Unsupported target architecture
 #endif
+	__atomic_store_n(&initialized, true, __ATOMIC_RELEASE);
+}
+
+void CPUINFO_ABI cpuinfo_initialize(void) {
+	if (__atomic_load_n(&initialized, __ATOMIC_ACQUIRE)) {
+		return;
+	}
+
+	pthread_mutex_lock(&init_mutex);
+	if (!initialized) {
+		detect();
+	}
+	pthread_mutex_unlock(&init_mutex);
+}
+
+void CPUINFO_ABI cpuinfo_reinitialize(void) {
+	pthread_mutex_lock(&init_mutex);
+	detect();
+	pthread_mutex_unlock(&init_mutex);
 }
 
 void CPUINFO_ABI cpuinfo_deinitialize(void) {
+	#if defined(__linux__)
+		/* Background threads read the tables, and are stopped before the tables are freed */
+		cpuinfo_frequency_monitor_stop();
+		cpuinfo_online_watcher_stop();
+		cpuinfo_linux_free_frequency_history();
+	#endif
+
+	pthread_mutex_lock(&init_mutex);
+	const struct cpuinfo_tables* current_tables = cpuinfo_tables;
+	__atomic_store_n(&cpuinfo_tables, &no_tables, __ATOMIC_RELEASE);
+	cpuinfo_processors = NULL;
+	cpuinfo_processors_count = 0;
+
+	if (current_tables != &no_tables) {
+		free_tables((struct cpuinfo_tables*) current_tables);
+		cpuinfo_advance_generation();
+	}
+	__atomic_store_n(&initialized, false, __ATOMIC_RELEASE);
+	pthread_mutex_unlock(&init_mutex);
+}
+
+struct cpuinfo_processors CPUINFO_ABI cpuinfo_get_processors(void) {
+	const struct cpuinfo_tables* tables = cpuinfo_get_tables();
+	return (struct cpuinfo_processors) {
+		.count = tables->processors_count,
+		.instances = tables->processors
+	};
+}
+
+uint32_t CPUINFO_ABI cpuinfo_get_generation(void) {
+	return __atomic_load_n(&generation, __ATOMIC_ACQUIRE);
+}
+
+bool CPUINFO_ABI cpuinfo_is_processor_online(uint32_t processor) {
+	const struct cpuinfo_tables* tables = cpuinfo_get_tables();
+	if (processor >= tables->processors_count) {
+		return false;
+	}
+	if (tables->online_mask == NULL) {
+		return true;
+	}
+	const uint32_t online_word = __atomic_load_n(&tables->online_mask[processor / 32], __ATOMIC_RELAXED);
+	return (online_word >> (processor % 32)) & 1;
+}
+
+uint32_t CPUINFO_ABI cpuinfo_get_available_processors(uint32_t max_count, uint32_t* processors) {
+	const struct cpuinfo_tables* tables = cpuinfo_get_tables();
+	if (tables->available_processors == NULL) {
+		for (uint32_t i = 0; i < tables->processors_count && i < max_count; i++) {
+			processors[i] = i;
+		}
+		return tables->processors_count;
+	}
+
+	const uint32_t count = tables->available_processors_count;
+	for (uint32_t i = 0; i < count && i < max_count; i++) {
+		processors[i] = tables->available_processors[i];
+	}
+	return count;
+}
+
+uint32_t CPUINFO_ABI cpuinfo_get_effective_parallelism(void) {
+	const struct cpuinfo_tables* tables = cpuinfo_get_tables();
+	if (tables->available_processors == NULL) {
+		return tables->processors_count;
+	}
+	return tables->effective_parallelism;
+}
+
+uint32_t CPUINFO_ABI cpuinfo_get_role_processors(
+	enum cpuinfo_thread_role role, uint32_t max_count, uint32_t* processors)
+{
+	const struct cpuinfo_tables* tables = cpuinfo_get_tables();
+	uint32_t count = 0;
+	switch (role) {
+		case cpuinfo_thread_role_latency:
+			count = tables->isolated_processors_count;
+			for (uint32_t i = 0; i < count && i < max_count; i++) {
+				processors[i] = tables->isolated_processors[i];
+			}
+			break;
+		case cpuinfo_thread_role_housekeeping:
+			if (tables->available_processors != NULL) {
+				for (uint32_t i = 0; i < tables->available_processors_count; i++) {
+					const uint32_t processor = tables->available_processors[i];
+					if (tables->processors[processor].isolation == 0) {
+						if (count < max_count) {
+							processors[count] = processor;
+						}
+						count++;
+					}
+				}
+			}
+			break;
+	}
+	if (count == 0) {
+		count = cpuinfo_get_available_processors(max_count, processors);
+	}
+	return count;
+}
+
+struct cpuinfo_hypervisor CPUINFO_ABI cpuinfo_get_hypervisor(void) {
+	return cpuinfo_get_tables()->hypervisor;
 }
@@ -0,0 +1,97 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include <cpuinfo.h>
+#include <api.h>
+
+
+#if CPUINFO_ARCH_X86_64
+	/*
+	 * Levels are defined in the x86-64 psABI. The baseline (CMOV, CMPXCHG8B, FPU, FXSR, MMX, SSE, SSE2)
+	 * is implied by the 64-bit mode. AVX and AVX-512 flags of the ISA are set only when the OS
+	 * saves the corresponding register state, which covers the OSXSAVE requirement of levels 3 and 4.
+	 */
+	uint32_t CPUINFO_ABI cpuinfo_get_x86_64_level(void) {
+		const struct cpuinfo_x86_isa* isa = &cpuinfo_get_tables()->isa;
+		const bool v2 = isa->cmpxchg16b && isa->lahf_sahf && isa->popcnt &&
+			isa->sse3 && isa->ssse3 && isa->sse4_1 && isa->sse4_2;
+		if (!v2) {
+			return 1;
+		}
+
+		const bool v3 = isa->avx && isa->avx2 && isa->bmi && isa->bmi2 &&
+			isa->f16c && isa->fma3 && isa->lzcnt && isa->movbe;
+		if (!v3) {
+			return 2;
+		}
+
+		const bool v4 = isa->avx512f && isa->avx512bw && isa->avx512cd &&
+			isa->avx512dq && isa->avx512vl;
+		if (!v4) {
+			return 3;
+		}
+
+		return 4;
+	}
+#endif
+
+#if CPUINFO_ARCH_ARM64
+	/*
+	 * Only features mandatory in each Armv8.x-A extension and visible to user space are checked.
+	 * Mandatory features not tracked in struct cpuinfo_arm_isa (e.g. pointer authentication, BTI) are ignored.
+	 */
+	uint32_t CPUINFO_ABI cpuinfo_get_armv8_level(void) {
+		const struct cpuinfo_arm_isa* isa = &cpuinfo_get_tables()->isa;
+		/* Armv8.1: Large System Extensions (LSE) atomics, SQRDMLAH/SQRDMLSH, CRC32 */
+		if (!(isa->atomics && isa->rdm && isa->crc32)) {
+			return 0;
+		}
+		/* Armv8.2: DC CVAP */
+		if (!isa->dcpop) {
+			return 1;
+		}
+		/* Armv8.3: JavaScript conversion, complex number arithmetics, RCpc loads */
+		if (!(isa->jscvt && isa->fcma && isa->lrcpc)) {
+			return 2;
+		}
+		/* Armv8.4: flag manipulation, RCpc unscaled loads/stores, dot product */
+		if (!(isa->flagm && isa->lrcpc2 && isa->dot)) {
+			return 3;
+		}
+		/* Armv8.5: FRINT, second flag manipulation extension, speculation barrier, DC CVADP */
+		if (!(isa->frint && isa->flagm2 && isa->sb && isa->dcpodp)) {
+			return 4;
+		}
+		/* Armv8.6: INT8 matrix multiplication, BFloat16 */
+		if (!(isa->i8mm && isa->bf16)) {
+			return 5;
+		}
+		return 6;
+	}
+#endif
+
+const char* CPUINFO_ABI cpuinfo_get_isa_level_name(void) {
+	#if CPUINFO_ARCH_X86_64
+		static const char* const names[5] = {
+			[1] = "x86-64",
+			[2] = "x86-64-v2",
+			[3] = "x86-64-v3",
+			[4] = "x86-64-v4",
+		};
+		return names[cpuinfo_get_x86_64_level()];
+	#elif CPUINFO_ARCH_ARM64
+		static const char* const names[7] = {
+			[0] = "armv8-a",
+			[1] = "armv8.1-a",
+			[2] = "armv8.2-a",
+			[3] = "armv8.3-a",
+			[4] = "armv8.4-a",
+			[5] = "armv8.5-a",
+			[6] = "armv8.6-a",
+		};
+		return names[cpuinfo_get_armv8_level()];
+	#else
+		return NULL;
+	#endif
+}
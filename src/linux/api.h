@@ -1,5 +1,73 @@
 #pragma once
 
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
 #include <sched.h>
 
-bool cpuinfo_linux_parse_cpuset(const char* filename, cpu_set_t* cpuset);
+#include <cpuinfo.h>
+
+bool cpuinfo_linux_parse_cpulist(const char* text_start, const char* text_end, cpu_set_t cpuset[restrict static 1]);
+bool cpuinfo_linux_parse_cpumask(const char* text_start, const char* text_end, cpu_set_t cpuset[restrict static 1]);
+void cpuinfo_linux_detect_resctrl(struct cpuinfo_qos qos[restrict static 1]);
+bool cpuinfo_linux_format_cpufreq_path(int processor, const char* name, size_t path_size, char path[restrict static 1]);
+
+/*
+ * Directories for openat-based reads. Cached descriptors of sysfs directories stay open
+ * until cpuinfo_linux_sysfs_close; descriptors from cpuinfo_linux_open_dir are owned by the caller.
+ * All functions return -1 if the directory can not be opened.
+ */
+int cpuinfo_linux_open_dir(int parent_dir, const char* path);
+int cpuinfo_linux_sysfs_dir(void);
+int cpuinfo_linux_sysfs_processor_dir(uint32_t processor);
+void cpuinfo_linux_sysfs_close(void);
+
+/* Read a small file relative to a directory (or AT_FDCWD) into an on-stack buffer, without allocations */
+bool cpuinfo_linux_read_file_at(
+	int dir,
+	const char* name,
+	size_t buffer_size,
+	char buffer[restrict static 1],
+	size_t length_ptr[restrict static 1]);
+bool cpuinfo_linux_read_number_at(int dir, const char* name, uint32_t base, uint64_t value_ptr[restrict static 1]);
+bool cpuinfo_linux_read_cpulist_at(int dir, const char* name, cpu_set_t cpuset[restrict static 1]);
+bool cpuinfo_linux_read_cpumask_at(int dir, const char* name, cpu_set_t cpuset[restrict static 1]);
+
+/*
+ * Sets online bits of processors in the tables from the set of online processors, or marks all processors online
+ * if the set is NULL. Returns true if any bit or the number of untracked online processors changed.
+ */
+struct cpuinfo_tables;
+bool cpuinfo_linux_update_online_processors(struct cpuinfo_tables* tables, const cpu_set_t* online_set);
+
+/* Frees samples of the frequency monitor. The monitor must be stopped, and samples must not be read concurrently. */
+void cpuinfo_linux_free_frequency_history(void);
+
+/*
+ * Reads limits of the cgroup of the calling process: the set of allowed CPUs, which has all CPUs if not limited,
+ * and the CPU bandwidth quota in whole processors, which is UINT32_MAX if not limited.
+ * Returns false if cgroups are not available.
+ */
+bool cpuinfo_linux_detect_cgroup_limits(
+	cpu_set_t cpuset[restrict static 1],
+	uint32_t quota_processors_ptr[restrict static 1]);
+
+/* Sets isolation flags of processors from sysfs and the kernel command line */
+void cpuinfo_linux_detect_isolation(uint32_t processors_count, struct cpuinfo_processor processors[restrict static 1]);
+
+/*
+ * Fills available processors and effective parallelism of the tables from the affinity mask, if not NULL,
+ * and the cgroup limits, and isolated processors from isolation flags and the cgroup cpuset.
+ * The available and isolated processors tables must have capacity for all processors.
+ */
+void cpuinfo_linux_detect_available_processors(struct cpuinfo_tables* tables, const cpu_set_t* affinity);
+
+/*
+ * Fills up to processors_count zero-initialized domains, and returns the number of detected domains.
+ * Both arrays must have processors_count elements.
+ */
+uint32_t cpuinfo_linux_detect_frequency_domains(
+	uint32_t processors_count,
+	struct cpuinfo_processor* processors,
+	struct cpuinfo_frequency_domain* domains);
@@ -0,0 +1,359 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sched.h>
+
+#if CPUINFO_MOCK
+	#include <cpuinfo-mock.h>
+#endif
+#include <cpuinfo.h>
+#include <linux/api.h>
+#include <api.h>
+#include <log.h>
+
+
+static const char* cgroup_path = "/sys/fs/cgroup";
+static const char* proc_self_cgroup_path = "/proc/self/cgroup";
+
+#if CPUINFO_MOCK
+	void CPUINFO_ABI cpuinfo_set_cgroup_path(const char* path) {
+		/* Note: this leaks memory */
+		cgroup_path = strdup(path);
+	}
+
+	void CPUINFO_ABI cpuinfo_set_proc_self_cgroup_path(const char* path) {
+		/* Note: this leaks memory */
+		proc_self_cgroup_path = strdup(path);
+	}
+#endif
+
+
+/* Size, in chars, of the on-stack buffers for paths of cgroup directories and for /proc/self/cgroup */
+#define PATH_SIZE 4096
+
+/* Size, in chars, of the on-stack buffers for contents of CPU bandwidth files */
+#define BUFFER_SIZE 64
+
+/*
+ * Directory of a cgroup in one hierarchy. The path is shortened in place to visit ancestors of the cgroup,
+ * and never above the root of the hierarchy, which is the first root_length chars.
+ */
+struct cgroup_dir {
+	char path[PATH_SIZE];
+	size_t length;
+	size_t root_length;
+};
+
+/* Position of a cgroup in one line of /proc/self/cgroup, e.g. "4:cpu,cpuacct:/docker/0123abcd" */
+struct cgroup_entry {
+	const char* controllers;
+	size_t controllers_length;
+	const char* path;
+	size_t path_length;
+	bool valid;
+};
+
+static bool has_controller(const struct cgroup_entry entry[restrict static 1], const char* controller) {
+	const size_t controller_length = strlen(controller);
+	const char* const controllers_end = entry->controllers + entry->controllers_length;
+	for (const char* start = entry->controllers; start < controllers_end; ) {
+		const char* end = memchr(start, ',', (size_t) (controllers_end - start));
+		if (end == NULL) {
+			end = controllers_end;
+		}
+		if ((size_t) (end - start) == controller_length && memcmp(start, controller, controller_length) == 0) {
+			return true;
+		}
+		start = end + 1;
+	}
+	return false;
+}
+
+/*
+ * Formats the directory of the cgroup at root/mount/path. Without cgroup namespaces a container may see the
+ * path of its cgroup on the host, but only its own cgroup mounted: then the root of the hierarchy is used.
+ */
+static bool init_cgroup_dir(
+	struct cgroup_dir dir[restrict static 1],
+	const char* mount, size_t mount_length,
+	const struct cgroup_entry entry[restrict static 1])
+{
+	int root_length;
+	if (mount_length != 0) {
+		root_length = snprintf(dir->path, PATH_SIZE, "%s/%.*s", cgroup_path, (int) mount_length, mount);
+	} else {
+		root_length = snprintf(dir->path, PATH_SIZE, "%s", cgroup_path);
+	}
+	const int length = snprintf(dir->path + root_length, PATH_SIZE - (size_t) root_length,
+		"%.*s", (int) entry->path_length, entry->path);
+	if (root_length <= 0 || length < 0 || (size_t) (root_length + length) >= PATH_SIZE) {
+		cpuinfo_log_warning("path to cgroup %.*s is too long", (int) entry->path_length, entry->path);
+		return false;
+	}
+	dir->root_length = (size_t) root_length;
+	dir->length = (size_t) (root_length + length);
+	while (dir->length > dir->root_length && dir->path[dir->length - 1] == '/') {
+		dir->path[--dir->length] = '\0';
+	}
+
+	if (access(dir->path, F_OK) != 0) {
+		cpuinfo_log_debug("cgroup directory %s is not accessible: using the root of the hierarchy", dir->path);
+		dir->length = dir->root_length;
+		dir->path[dir->length] = '\0';
+	}
+	return true;
+}
+
+/* Moves to the parent cgroup. Returns false at the root of the hierarchy. */
+static bool parent_cgroup_dir(struct cgroup_dir dir[restrict static 1]) {
+	if (dir->length <= dir->root_length) {
+		return false;
+	}
+	while (dir->length > dir->root_length && dir->path[dir->length - 1] != '/') {
+		dir->length--;
+	}
+	if (dir->length > dir->root_length) {
+		/* Remove the separator */
+		dir->length--;
+	}
+	dir->path[dir->length] = '\0';
+	return true;
+}
+
+/* Locale-independent. Advances the pointer past the digits. */
+static bool parse_number(const char* text[restrict static 1], uint64_t number_ptr[restrict static 1]) {
+	const char* digit_ptr = *text;
+	uint64_t number = 0;
+	for (; *digit_ptr >= '0' && *digit_ptr <= '9'; digit_ptr++) {
+		number = number * 10 + (uint64_t) (*digit_ptr - '0');
+	}
+	if (digit_ptr == *text) {
+		return false;
+	}
+	*number_ptr = number;
+	*text = digit_ptr;
+	return true;
+}
+
+/* Rounds up the quota to whole processors, as runtimes which size thread pools by the quota do */
+static uint32_t quota_to_processors(uint64_t quota, uint64_t period) {
+	if (period == 0) {
+		return UINT32_MAX;
+	}
+	const uint64_t processors = (quota + period - 1) / period;
+	if (processors == 0) {
+		return 1;
+	}
+	return processors < UINT32_MAX ? (uint32_t) processors : UINT32_MAX;
+}
+
+/* cgroup v2 cpu.max: "max 100000" without quota, or "$QUOTA $PERIOD", both in microseconds */
+static uint32_t read_cpu_max(int dir) {
+	char buffer[BUFFER_SIZE];
+	size_t length = 0;
+	if (!cpuinfo_linux_read_file_at(dir, "cpu.max", BUFFER_SIZE, buffer, &length)) {
+		return UINT32_MAX;
+	}
+
+	const char* text = buffer;
+	uint64_t quota = 0, period = 0;
+	if (!parse_number(&text, &quota)) {
+		/* "max" */
+		return UINT32_MAX;
+	}
+	if (*text++ != ' ' || !parse_number(&text, &period)) {
+		cpuinfo_log_warning("failed to parse cpu.max: \"%.*s\"", (int) length, buffer);
+		return UINT32_MAX;
+	}
+	return quota_to_processors(quota, period);
+}
+
+/* cgroup v1 cpu.cfs_quota_us is -1 without quota */
+static uint32_t read_cfs_quota(int dir) {
+	char buffer[BUFFER_SIZE];
+	size_t length = 0;
+	if (!cpuinfo_linux_read_file_at(dir, "cpu.cfs_quota_us", BUFFER_SIZE, buffer, &length)) {
+		return UINT32_MAX;
+	}
+
+	const char* text = buffer;
+	uint64_t quota = 0, period = 0;
+	if (!parse_number(&text, &quota)) {
+		return UINT32_MAX;
+	}
+	if (!cpuinfo_linux_read_number_at(dir, "cpu.cfs_period_us", 10, &period)) {
+		return UINT32_MAX;
+	}
+	return quota_to_processors(quota, period);
+}
+
+/* Bandwidth limits of ancestors apply to the cgroup too: the smallest quota of all of them is effective */
+static uint32_t read_quota(struct cgroup_dir dir[restrict static 1], bool unified) {
+	uint32_t quota_processors = UINT32_MAX;
+	do {
+		const int cgroup_dir = cpuinfo_linux_open_dir(AT_FDCWD, dir->path);
+		if (cgroup_dir != -1) {
+			const uint32_t processors = unified ? read_cpu_max(cgroup_dir) : read_cfs_quota(cgroup_dir);
+			if (processors < quota_processors) {
+				quota_processors = processors;
+			}
+			close(cgroup_dir);
+		}
+	} while (parent_cgroup_dir(dir));
+	return quota_processors;
+}
+
+/*
+ * The effective cpuset reflects the cpusets of ancestors. If the cpuset controller is not enabled for the cgroup,
+ * its file is missing, and the cpuset of the closest ancestor with the controller applies.
+ */
+static bool read_cpuset(struct cgroup_dir dir[restrict static 1], bool unified, cpu_set_t cpuset[restrict static 1]) {
+	do {
+		const int cgroup_dir = cpuinfo_linux_open_dir(AT_FDCWD, dir->path);
+		if (cgroup_dir != -1) {
+			cpu_set_t cgroup_cpuset;
+			bool cpuset_valid;
+			if (unified) {
+				cpuset_valid = cpuinfo_linux_read_cpulist_at(cgroup_dir, "cpuset.cpus.effective", &cgroup_cpuset);
+			} else {
+				cpuset_valid = cpuinfo_linux_read_cpulist_at(cgroup_dir, "cpuset.effective_cpus", &cgroup_cpuset) ||
+					cpuinfo_linux_read_cpulist_at(cgroup_dir, "cpuset.cpus", &cgroup_cpuset);
+			}
+			close(cgroup_dir);
+			/* The root cgroup of a container may list no processors until they are configured */
+			if (cpuset_valid && CPU_COUNT(&cgroup_cpuset) != 0) {
+				*cpuset = cgroup_cpuset;
+				return true;
+			}
+		}
+	} while (parent_cgroup_dir(dir));
+	return false;
+}
+
+bool cpuinfo_linux_detect_cgroup_limits(
+	cpu_set_t cpuset[restrict static 1],
+	uint32_t quota_processors_ptr[restrict static 1])
+{
+	for (uint32_t cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+		CPU_SET(cpu, cpuset);
+	}
+	*quota_processors_ptr = UINT32_MAX;
+
+	char buffer[PATH_SIZE];
+	size_t length = 0;
+	if (!cpuinfo_linux_read_file_at(AT_FDCWD, proc_self_cgroup_path, PATH_SIZE, buffer, &length)) {
+		return false;
+	}
+
+	/*
+	 * Lines of cgroup v1 hierarchies list their controllers, e.g. "12:cpuset:/docker/0123abcd".
+	 * The line of the unified cgroup v2 hierarchy has ID 0 and no controllers, e.g. "0::/user.slice".
+	 * With both, as in the hybrid layout of systemd, v1 controllers take precedence.
+	 */
+	struct cgroup_entry cpuset_entry = { 0 };
+	struct cgroup_entry cpu_entry = { 0 };
+	struct cgroup_entry unified_entry = { 0 };
+	const char* const buffer_end = buffer + length;
+	for (const char* line_start = buffer; line_start < buffer_end; ) {
+		const char* line_end = memchr(line_start, '\n', (size_t) (buffer_end - line_start));
+		if (line_end == NULL) {
+			line_end = buffer_end;
+		}
+		const char* controllers_start = memchr(line_start, ':', (size_t) (line_end - line_start));
+		const char* path_start = controllers_start == NULL ? NULL :
+			memchr(controllers_start + 1, ':', (size_t) (line_end - controllers_start - 1));
+		if (path_start != NULL) {
+			struct cgroup_entry entry = {
+				.controllers = controllers_start + 1,
+				.controllers_length = (size_t) (path_start - controllers_start - 1),
+				.path = path_start + 1,
+				.path_length = (size_t) (line_end - path_start - 1),
+				.valid = true,
+			};
+			if (entry.controllers_length == 0) {
+				if (controllers_start - line_start == 1 && line_start[0] == '0') {
+					unified_entry = entry;
+				}
+			} else {
+				if (has_controller(&entry, "cpuset")) {
+					cpuset_entry = entry;
+				}
+				if (has_controller(&entry, "cpu")) {
+					cpu_entry = entry;
+				}
+			}
+		}
+		line_start = line_end + 1;
+	}
+
+	/* The unified hierarchy is mounted at the root, or at "unified" in the hybrid layout */
+	const char* unified_mount = "";
+	if (unified_entry.valid && (cpuset_entry.valid || cpu_entry.valid)) {
+		unified_mount = "unified";
+	}
+
+	struct cgroup_dir dir;
+	if (cpuset_entry.valid) {
+		if (init_cgroup_dir(&dir, cpuset_entry.controllers, cpuset_entry.controllers_length, &cpuset_entry)) {
+			read_cpuset(&dir, false, cpuset);
+		}
+	} else if (unified_entry.valid) {
+		if (init_cgroup_dir(&dir, unified_mount, strlen(unified_mount), &unified_entry)) {
+			read_cpuset(&dir, true, cpuset);
+		}
+	}
+
+	if (cpu_entry.valid) {
+		if (init_cgroup_dir(&dir, cpu_entry.controllers, cpu_entry.controllers_length, &cpu_entry)) {
+			*quota_processors_ptr = read_quota(&dir, false);
+		}
+	} else if (unified_entry.valid) {
+		if (init_cgroup_dir(&dir, unified_mount, strlen(unified_mount), &unified_entry)) {
+			*quota_processors_ptr = read_quota(&dir, true);
+		}
+	}
+	return true;
+}
+
+void cpuinfo_linux_detect_available_processors(struct cpuinfo_tables* tables, const cpu_set_t* affinity) {
+	cpu_set_t cgroup_cpuset;
+	uint32_t quota_processors = UINT32_MAX;
+	cpuinfo_linux_detect_cgroup_limits(&cgroup_cpuset, &quota_processors);
+
+	uint32_t available_count = 0;
+	for (uint32_t i = 0; i < tables->processors_count; i++) {
+		const int linux_id = tables->processors[i].topology.linux_id;
+		if ((affinity == NULL || CPU_ISSET(linux_id, affinity)) && CPU_ISSET(linux_id, &cgroup_cpuset)) {
+			tables->available_processors[available_count++] = i;
+		}
+	}
+	if (available_count == 0) {
+		cpuinfo_log_warning("no detected processor is allowed by affinity and cpuset: assuming all are available");
+		for (uint32_t i = 0; i < tables->processors_count; i++) {
+			tables->available_processors[i] = i;
+		}
+		available_count = tables->processors_count;
+	}
+	tables->available_processors_count = available_count;
+
+	/* isolcpus removes processors from the default affinity mask: only the cgroup limits pinning to them */
+	uint32_t isolated_count = 0;
+	for (uint32_t flags = 3; flags != 0; flags--) {
+		for (uint32_t i = 0; i < tables->processors_count; i++) {
+			const uint32_t isolation = tables->processors[i].isolation;
+			if (isolation != 0 && (uint32_t) __builtin_popcount(isolation) == flags &&
+				CPU_ISSET(tables->processors[i].topology.linux_id, &cgroup_cpuset))
+			{
+				tables->isolated_processors[isolated_count++] = i;
+			}
+		}
+	}
+	tables->isolated_processors_count = isolated_count;
+	tables->effective_parallelism = available_count < quota_processors ? available_count : quota_processors;
+	cpuinfo_log_debug("%"PRIu32" of %"PRIu32" logical processors are available, effective parallelism %"PRIu32,
+		available_count, tables->processors_count, tables->effective_parallelism);
+}
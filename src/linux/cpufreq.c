@@ -0,0 +1,91 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <sched.h>
+
+#include <cpuinfo.h>
+#include <linux/api.h>
+#include <log.h>
+
+
+#define HZ_PER_KHZ UINT64_C(1000)
+
+
+/* Reads frequency in kHz, as reported by cpufreq, and returns it in Hz, or 0 on failure */
+static uint64_t read_frequency(int processor, const char* name) {
+	uint64_t frequency = 0;
+	if (!cpuinfo_linux_read_number_at(cpuinfo_linux_sysfs_processor_dir((uint32_t) processor), name, 10, &frequency)) {
+		return 0;
+	}
+	return frequency * HZ_PER_KHZ;
+}
+
+uint32_t cpuinfo_linux_detect_frequency_domains(
+	uint32_t processors_count,
+	struct cpuinfo_processor* processors,
+	struct cpuinfo_frequency_domain* domains)
+{
+	uint32_t domains_count = 0;
+	uint32_t* processor_domains = calloc(processors_count, sizeof(uint32_t));
+	if (processor_domains == NULL) {
+		cpuinfo_log_error("failed to allocate %zu bytes for frequency domains of %"PRIu32" logical processors",
+			processors_count * sizeof(uint32_t), processors_count);
+		goto cleanup;
+	}
+
+	/* First pass: group processors into domains according to related_cpus */
+	for (uint32_t i = 0; i < processors_count; i++) {
+		processor_domains[i] = UINT32_MAX;
+	}
+	for (uint32_t i = 0; i < processors_count; i++) {
+		if (processor_domains[i] != UINT32_MAX) {
+			continue;
+		}
+
+		const int linux_id = processors[i].topology.linux_id;
+		if (read_frequency(linux_id, "cpufreq/cpuinfo_max_freq") == 0) {
+			/* No cpufreq policy for this processor */
+			continue;
+		}
+
+		const uint32_t domain = domains_count++;
+		processor_domains[i] = domain;
+
+		cpu_set_t related_cpus;
+		if (cpuinfo_linux_read_cpulist_at(cpuinfo_linux_sysfs_processor_dir((uint32_t) linux_id), "cpufreq/related_cpus", &related_cpus)) {
+			for (uint32_t j = i + 1; j < processors_count; j++) {
+				if (processor_domains[j] == UINT32_MAX && CPU_ISSET(processors[j].topology.linux_id, &related_cpus)) {
+					processor_domains[j] = domain;
+				}
+			}
+		}
+	}
+
+	if (domains_count == 0) {
+		cpuinfo_log_debug("frequency limits are not reported by cpufreq");
+		goto cleanup;
+	}
+
+	/* Second pass: read frequency limits once per domain and attach domains to processors */
+	for (uint32_t i = 0; i < processors_count; i++) {
+		const uint32_t domain = processor_domains[i];
+		if (domain == UINT32_MAX) {
+			continue;
+		}
+
+		if (domains[domain].processor_count++ == 0) {
+			const int linux_id = processors[i].topology.linux_id;
+			domains[domain].min_frequency  = read_frequency(linux_id, "cpufreq/cpuinfo_min_freq");
+			domains[domain].max_frequency  = read_frequency(linux_id, "cpufreq/cpuinfo_max_freq");
+			/* Reported only by some drivers, e.g. intel_pstate */
+			domains[domain].base_frequency = read_frequency(linux_id, "cpufreq/base_frequency");
+		}
+		processors[i].frequency_domain = &domains[domain];
+	}
+	cpuinfo_log_info("detected %"PRIu32" frequency domains", domains_count);
+
+cleanup:
+	free(processor_domains);
+	return domains_count;
+}
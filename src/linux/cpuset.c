@@ -1,28 +1,14 @@
 #include <stdbool.h>
 #include <stdint.h>
-#include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
-#include <errno.h>
 
-#include <sys/types.h>
-#include <sys/stat.h>
-#include <unistd.h>
-#include <fcntl.h>
 #include <sched.h>
 
 #include <linux/api.h>
 #include <log.h>
 
 
-/*
- * Size, in chars, of the on-stack buffer used for parsing cpu lists.
- * This is also the limit on the length of a single entry
- * (<cpu-number> or <cpu-number-start>-<cpu-number-end>)
- * in the cpu list.
- */
-#define BUFFER_SIZE 256
-
-
 /* Locale-independent */
 inline static bool is_whitespace(char c) {
 	switch (c) {
@@ -41,13 +27,13 @@ inline static const char* parse_number(const char* string, const char* end, uint
 	while (string != end) {
 		const uint32_t digit = (uint32_t) (*string) - (uint32_t) '0';
 		if (digit >= 10) {
-			return string;
+			break;
 		}
 		number = number * UINT32_C(10) + digit;
 		string += 1;
 	}
 	*number_ptr = number;
-	return end;
+	return string;
 }
 
 inline static bool parse_entry(const char* entry_start, const char* entry_end, cpu_set_t* cpuset) {
@@ -113,6 +99,16 @@ inline static bool parse_entry(const char* entry_start, const char* entry_end, c
 		return false;
 	}
 
+	/* Ranges are not bounded by the kernel format, but cpu_set_t is */
+	if (last_cpu >= CPU_SETSIZE) {
+		cpuinfo_log_warning("processors above %d in cpu list entry \"%.*s\" exceed the limit of cpu set: ignored",
+			CPU_SETSIZE - 1, (int) entry_length, entry_start);
+		if (first_cpu >= CPU_SETSIZE) {
+			return false;
+		}
+		last_cpu = CPU_SETSIZE - 1;
+	}
+
 	/* Parsed both parts of the entry; update CPU set */
 	for (uint32_t i = first_cpu; i <= last_cpu; i++) {
 		CPU_SET((int) i, cpuset);
@@ -120,73 +116,133 @@ inline static bool parse_entry(const char* entry_start, const char* entry_end, c
 	return true;
 }
 
-bool cpuinfo_linux_parse_cpuset(const char* filename, cpu_set_t* cpuset) {
+bool cpuinfo_linux_parse_cpulist(const char* text_start, const char* text_end, cpu_set_t cpuset[restrict static 1]) {
 	bool status = true;
-	int file = -1;
-	char buffer[BUFFER_SIZE];
-	CPU_ZERO(cpuset);
-	cpuinfo_log_debug("parsing cpu list from file %s", filename);
-
-	file = open(filename, O_RDONLY);
-	if (file == -1) {
-		cpuinfo_log_error("failed to open %s: %s", filename, strerror(errno));
-		status = false;
-		goto cleanup;
-	}
-
-	size_t position = 0;
-	const char* buffer_end = &buffer[BUFFER_SIZE];
-	char* data_start = buffer;
-	ssize_t bytes_read;
+	const char* entry_start = text_start;
+	const char* entry_end;
 	do {
-		bytes_read = read(file, data_start, (size_t) (buffer_end - data_start));
-		if (bytes_read < 0) {
-			cpuinfo_log_error("failed to read file %s at position %zu: %s", filename, position, strerror(errno));
-			status = false;
-			goto cleanup;
+		/* Find the end of the entry, as indicated by a comma (',') */
+		for (entry_end = entry_start; entry_end != text_end; entry_end++) {
+			if (*entry_end == ',') {
+				break;
+			}
+		}
+
+		const bool entry_status = parse_entry(entry_start, entry_end, cpuset);
+		status &= entry_status;
+		entry_start = entry_end + 1;
+	} while (entry_end != text_end);
+	return status;
+}
+
+/* Number of hexadecimal digits in a comma-separated group of a cpu mask */
+#define CPUMASK_GROUP_DIGITS 8
+
+/*
+ * Converts 8 hexadecimal digits, most significant first, to a 32-bit number.
+ * All digits are validated and converted at once, in 8-bit lanes of a 64-bit word.
+ */
+inline static bool parse_hex_group(const char digits[restrict static CPUMASK_GROUP_DIGITS], uint32_t group_ptr[restrict static 1]) {
+	const uint64_t ones = UINT64_C(0x0101010101010101);
+
+	/* Lane i holds digits[i] */
+	uint64_t chars;
+	memcpy(&chars, digits, sizeof(chars));
+	#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+		chars = __builtin_bswap64(chars);
+	#endif
+
+	/* 1 in the lanes with letters: '0'-'9' are 0x30-0x39, 'A'-'F' are 0x41-0x46, 'a'-'f' are 0x61-0x66 */
+	const uint64_t letters = (chars >> 6) & ones;
+	const uint64_t high = (chars | (letters << 5)) & (ones * 0xF0);
+	const uint64_t low = chars & (ones * 0x0F);
+	const uint64_t values = low + letters * 9;
+
+	/* Upper halves must be 0x3 for digits and 0x6 for (lowercased) letters */
+	const bool valid_high = high == ones * 0x30 + letters * 0x30;
+	/* Values must not exceed 9 for digits and 15 for letters */
+	const bool valid_range = ((values + (ones - letters) * 6) & (ones * 0x10)) == 0;
+	/* Letters must not be 0x40 ('@') or 0x60 ('`') */
+	const bool valid_letters = (letters & ~((low + ones * 0x0F) >> 4)) == 0;
+	if (!(valid_high && valid_range && valid_letters)) {
+		return false;
+	}
+
+	/* Merge lanes pairwise: nibbles into bytes, bytes into 16-bit and 32-bit values */
+	uint64_t group = values;
+	group = ((group << 4) | (group >> 8)) & UINT64_C(0x00FF00FF00FF00FF);
+	group = ((group << 8) | (group >> 16)) & UINT64_C(0x0000FFFF0000FFFF);
+	group = ((group << 16) | (group >> 32)) & UINT64_C(0x00000000FFFFFFFF);
+	*group_ptr = (uint32_t) group;
+	return true;
+}
+
+/*
+ * Parses a cpu mask, as printed by the kernel in e.g. shared_cpu_map or smp_affinity:
+ * comma-separated groups of 8 hexadecimal digits for 32 processors each, the most significant first.
+ * The most significant group may have fewer digits.
+ */
+bool cpuinfo_linux_parse_cpumask(const char* text_start, const char* text_end, cpu_set_t cpuset[restrict static 1]) {
+	/* Skip whitespace around the mask */
+	for (; text_start != text_end; text_start++) {
+		if (!is_whitespace(*text_start)) {
+			break;
+		}
+	}
+	for (; text_end != text_start; text_end--) {
+		if (!is_whitespace(text_end[-1])) {
+			break;
+		}
+	}
+	if (text_start == text_end) {
+		cpuinfo_log_warning("unexpected empty cpu mask ignored");
+		return false;
+	}
+
+	/* Parse groups from the least significant one at the end */
+	const char* group_end = text_end;
+	for (uint32_t first_cpu = 0; ; first_cpu += 32) {
+		const char* group_start = group_end;
+		for (; group_start != text_start; group_start--) {
+			if (group_start[-1] == ',') {
+				break;
+			}
+		}
+
+		const size_t group_length = (size_t) (group_end - group_start);
+		if (group_length == 0 || group_length > CPUMASK_GROUP_DIGITS ||
+			(group_length != CPUMASK_GROUP_DIGITS && group_start != text_start))
+		{
+			cpuinfo_log_warning("invalid group \"%.*s\" in cpu mask \"%.*s\": expected %d hexadecimal digits",
+				(int) group_length, group_start, (int) (text_end - text_start), text_start, CPUMASK_GROUP_DIGITS);
+			return false;
 		}
 
-		position += (size_t) bytes_read;
-		const char* data_end = data_start + (size_t) bytes_read;
-		const char* entry_start = buffer;
-
-		if (bytes_read == 0) {
-			/* No more data in the file: process the remaining text in the buffer as a single entry */
-			const char* entry_end = data_end;
-			const bool entry_status = parse_entry(entry_start, entry_end, cpuset);
-			status &= entry_status;
-		} else {
-			const char* entry_end;
-			do {
-				/* Find the end of the entry, as indicated by a comma (',') */
-				for (entry_end = entry_start; entry_end != data_end; entry_end++) {
-					if (*entry_end == ',') {
-						break;
-					}
-				}
-
-				/*
-				 * If we located separator at the end of the entry, parse it.
-				 * Otherwise, there may be more data at the end; read the file once again.
-				 */
-				if (entry_end != data_end) {
-					const bool entry_status = parse_entry(entry_start, entry_end, cpuset);
-					status &= entry_status;
-					entry_start = entry_end + 1;
-				}
-			} while (entry_end != data_end);
-
-			/* Move remaining partial entry data at the end to the beginning of the buffer */
-			const size_t entry_length = (size_t) (entry_end - entry_start);
-			memmove(buffer, entry_start, entry_length);
-			data_start = &buffer[entry_length];
+		/* Pad a short most significant group with leading zeroes */
+		char digits[CPUMASK_GROUP_DIGITS];
+		memset(digits, '0', CPUMASK_GROUP_DIGITS - group_length);
+		memcpy(&digits[CPUMASK_GROUP_DIGITS - group_length], group_start, group_length);
+
+		uint32_t group;
+		if (!parse_hex_group(digits, &group)) {
+			cpuinfo_log_warning("invalid group \"%.*s\" in cpu mask \"%.*s\": expected %d hexadecimal digits",
+				(int) group_length, group_start, (int) (text_end - text_start), text_start, CPUMASK_GROUP_DIGITS);
+			return false;
 		}
-	} while (bytes_read != 0);
 
-cleanup:
-	if (file != -1) {
-		close(file);
-		file = -1;
+		for (; group != 0; group &= group - 1) {
+			const uint32_t cpu = first_cpu + (uint32_t) __builtin_ctz(group);
+			if (cpu >= CPU_SETSIZE) {
+				cpuinfo_log_warning("processor %"PRIu32" in cpu mask exceeds the limit of %d processors: ignored",
+					cpu, CPU_SETSIZE);
+				break;
+			}
+			CPU_SET((int) cpu, cpuset);
+		}
+
+		if (group_start == text_start) {
+			return true;
+		}
+		group_end = group_start - 1;
 	}
-	return status;
 }
@@ -0,0 +1,121 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <fcntl.h>
+#include <sched.h>
+
+#if CPUINFO_MOCK
+	#include <cpuinfo-mock.h>
+#endif
+#include <cpuinfo.h>
+#include <linux/api.h>
+#include <log.h>
+
+
+static const char* proc_cmdline_path = "/proc/cmdline";
+
+#if CPUINFO_MOCK
+	void CPUINFO_ABI cpuinfo_set_proc_cmdline_path(const char* path) {
+		/* Note: this leaks memory */
+		proc_cmdline_path = strdup(path);
+	}
+#endif
+
+
+/* Size, in chars, of the on-stack buffers for cpu lists and the kernel command line. Both never exceed a page. */
+#define BUFFER_SIZE 4096
+
+/* Locale-independent */
+inline static bool is_whitespace(char c) {
+	return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+/* Parses a cpu list, which is empty (or "(null)" in nohz_full) if the kernel isolates no processors */
+static bool parse_optional_cpulist(const char* text_start, const char* text_end, cpu_set_t cpuset[restrict static 1]) {
+	CPU_ZERO(cpuset);
+	for (; text_start != text_end && is_whitespace(*text_start); text_start++);
+	if (text_start == text_end || *text_start == '(') {
+		return false;
+	}
+	return cpuinfo_linux_parse_cpulist(text_start, text_end, cpuset);
+}
+
+static bool read_optional_cpulist(int dir, const char* name, cpu_set_t cpuset[restrict static 1]) {
+	char buffer[BUFFER_SIZE];
+	size_t length = 0;
+	if (!cpuinfo_linux_read_file_at(dir, name, BUFFER_SIZE, buffer, &length)) {
+		CPU_ZERO(cpuset);
+		return false;
+	}
+	return parse_optional_cpulist(buffer, buffer + length, cpuset);
+}
+
+/*
+ * Offloading of RCU callbacks is not reported in sysfs, and is parsed from the "rcu_nocbs=" kernel parameter.
+ * The last occurrence of the parameter takes effect. Without a value, or with "all", it applies to all processors.
+ * Kernel extensions of the cpu list syntax, e.g. "N" for the last processor, are not supported.
+ */
+static bool read_rcu_nocbs(cpu_set_t cpuset[restrict static 1]) {
+	static const char parameter[] = "rcu_nocbs";
+	const size_t parameter_length = sizeof(parameter) - 1;
+
+	CPU_ZERO(cpuset);
+	char buffer[BUFFER_SIZE];
+	size_t length = 0;
+	if (!cpuinfo_linux_read_file_at(AT_FDCWD, proc_cmdline_path, BUFFER_SIZE, buffer, &length)) {
+		return false;
+	}
+
+	bool found = false;
+	const char* const buffer_end = buffer + length;
+	for (const char* token_start = buffer; token_start < buffer_end; ) {
+		const char* token_end = token_start;
+		for (; token_end != buffer_end && !is_whitespace(*token_end); token_end++);
+
+		const size_t token_length = (size_t) (token_end - token_start);
+		if (token_length >= parameter_length && memcmp(token_start, parameter, parameter_length) == 0) {
+			const char* value_start = token_start + parameter_length;
+			if (value_start == token_end || (token_end - value_start == 4 && memcmp(value_start, "=all", 4) == 0)) {
+				for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+					CPU_SET(cpu, cpuset);
+				}
+				found = true;
+			} else if (*value_start == '=') {
+				found = parse_optional_cpulist(value_start + 1, token_end, cpuset);
+			}
+		}
+		token_start = token_end + 1;
+	}
+	return found;
+}
+
+void cpuinfo_linux_detect_isolation(uint32_t processors_count, struct cpuinfo_processor processors[restrict static 1]) {
+	cpu_set_t isolated_set, nohz_full_set, rcu_nocbs_set;
+	const int sysfs_dir = cpuinfo_linux_sysfs_dir();
+	const bool isolated = read_optional_cpulist(sysfs_dir, "isolated", &isolated_set);
+	const bool nohz_full = read_optional_cpulist(sysfs_dir, "nohz_full", &nohz_full_set);
+	const bool rcu_nocbs = read_rcu_nocbs(&rcu_nocbs_set);
+	if (!(isolated || nohz_full || rcu_nocbs)) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < processors_count; i++) {
+		const int linux_id = processors[i].topology.linux_id;
+		uint32_t isolation = 0;
+		if (CPU_ISSET(linux_id, &isolated_set)) {
+			isolation |= CPUINFO_ISOLATION_DOMAIN;
+		}
+		if (CPU_ISSET(linux_id, &nohz_full_set)) {
+			isolation |= CPUINFO_ISOLATION_NOHZ_FULL;
+		}
+		if (CPU_ISSET(linux_id, &rcu_nocbs_set)) {
+			isolation |= CPUINFO_ISOLATION_RCU_NOCBS;
+		}
+		processors[i].isolation = isolation;
+		if (isolation != 0) {
+			cpuinfo_log_debug("logical processor %"PRIu32" (Linux CPU %d) isolation flags: 0x%08"PRIx32,
+				i, linux_id, isolation);
+		}
+	}
+}
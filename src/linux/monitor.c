@@ -0,0 +1,443 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+
+#include <cpuinfo.h>
+#include <linux/api.h>
+#include <api.h>
+#include <log.h>
+
+
+/* Lower bound on the sampling period of the background thread, limits the sampling overhead to about 0.1% */
+#define MIN_PERIOD_US 1000
+
+#define NANOSECONDS_PER_SECOND UINT64_C(1000000000)
+#define NANOSECONDS_PER_MICROSECOND UINT64_C(1000)
+#define HZ_PER_KHZ UINT64_C(1000)
+
+/* Size, in chars, of the on-stack buffers for file paths and contents of cpufreq files */
+#define BUFFER_SIZE 256
+
+#define MSR_MPERF 0x000000E7
+#define MSR_APERF 0x000000E8
+
+/* Alignment of per-processor ring buffers to avoid false sharing between processors */
+#define RING_ALIGNMENT 64
+
+/*
+ * Sample slot protected by a sequence lock.
+ * All fields are 32-bit to stay lock-free on 32-bit targets without 64-bit atomics.
+ * The sequence number is odd while the slot is written, and 2 * (index + 1) after sample #index is written.
+ */
+struct frequency_slot {
+	uint32_t sequence;
+	uint32_t timestamp_lo;
+	uint32_t timestamp_hi;
+	uint32_t frequency_khz;
+};
+
+/* Single-producer, multiple-consumer ring buffer of samples of one logical processor */
+struct frequency_ring {
+	/* Number of samples written */
+	uint32_t head;
+	struct frequency_slot slots[CPUINFO_FREQUENCY_MONITOR_HISTORY];
+} __attribute__((__aligned__(RING_ALIGNMENT)));
+
+/* Ring buffers of all logical processors in one version of the tables */
+struct frequency_rings {
+	/* Version of the tables which the rings are indexed by */
+	uint64_t version;
+	uint32_t count;
+	/* Rings of previous versions; never released, so that readers never access freed memory */
+	struct frequency_rings* retired;
+	struct frequency_ring rings[];
+};
+
+/* State of the sampling of one logical processor, private to the sampling thread */
+struct processor_sampler {
+	int file;
+	uint64_t aperf;
+	uint64_t mperf;
+	bool valid;
+};
+
+static pthread_mutex_t monitor_mutex = PTHREAD_MUTEX_INITIALIZER;
+static struct frequency_rings* monitor_rings = NULL;
+
+static enum cpuinfo_frequency_source monitor_source = cpuinfo_frequency_source_none;
+static struct processor_sampler* monitor_samplers = NULL;
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+	static uint64_t monitor_reference_frequency = 0;
+#endif
+
+static pthread_t monitor_thread;
+static bool monitor_thread_started = false;
+static uint32_t monitor_period_us = 0;
+static uint32_t monitor_stop_requested = 0;
+
+
+static uint64_t read_monotonic_clock(void) {
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (uint64_t) time.tv_sec * NANOSECONDS_PER_SECOND + (uint64_t) time.tv_nsec;
+}
+
+static void publish_sample(struct frequency_ring ring[restrict static 1], uint64_t timestamp, uint64_t frequency) {
+	const uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+	struct frequency_slot* slot = &ring->slots[head % CPUINFO_FREQUENCY_MONITOR_HISTORY];
+
+	__atomic_store_n(&slot->sequence, 2 * head + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	__atomic_store_n(&slot->timestamp_lo, (uint32_t) timestamp, __ATOMIC_RELAXED);
+	__atomic_store_n(&slot->timestamp_hi, (uint32_t) (timestamp >> 32), __ATOMIC_RELAXED);
+	__atomic_store_n(&slot->frequency_khz, (uint32_t) (frequency / HZ_PER_KHZ), __ATOMIC_RELAXED);
+	__atomic_store_n(&slot->sequence, 2 * head + 2, __ATOMIC_RELEASE);
+	__atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+/* Returns false if the slot of the sample was not yet written, or is concurrently overwritten */
+static bool read_sample(
+	const struct frequency_ring ring[restrict static 1], uint32_t index,
+	struct cpuinfo_frequency_sample sample[restrict static 1])
+{
+	const struct frequency_slot* slot = &ring->slots[index % CPUINFO_FREQUENCY_MONITOR_HISTORY];
+	const uint32_t expected_sequence = 2 * index + 2;
+	if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != expected_sequence) {
+		return false;
+	}
+	const uint32_t timestamp_lo = __atomic_load_n(&slot->timestamp_lo, __ATOMIC_RELAXED);
+	const uint32_t timestamp_hi = __atomic_load_n(&slot->timestamp_hi, __ATOMIC_RELAXED);
+	const uint32_t frequency_khz = __atomic_load_n(&slot->frequency_khz, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	if (__atomic_load_n(&slot->sequence, __ATOMIC_RELAXED) != expected_sequence) {
+		return false;
+	}
+
+	sample->timestamp = ((uint64_t) timestamp_hi << 32) | (uint64_t) timestamp_lo;
+	sample->frequency = (uint64_t) frequency_khz * HZ_PER_KHZ;
+	return true;
+}
+
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+	static bool read_msr(int file, uint32_t index, uint64_t value[restrict static 1]) {
+		return pread(file, value, sizeof(uint64_t), (off_t) index) == (ssize_t) sizeof(uint64_t);
+	}
+
+	static bool sample_aperf_mperf(
+		struct processor_sampler sampler[restrict static 1],
+		uint64_t frequency[restrict static 1])
+	{
+		uint64_t aperf, mperf;
+		if (!read_msr(sampler->file, MSR_APERF, &aperf) || !read_msr(sampler->file, MSR_MPERF, &mperf)) {
+			return false;
+		}
+
+		const bool valid = sampler->valid;
+		const uint64_t aperf_delta = aperf - sampler->aperf;
+		const uint64_t mperf_delta = mperf - sampler->mperf;
+		sampler->aperf = aperf;
+		sampler->mperf = mperf;
+		sampler->valid = true;
+		if (!valid || mperf_delta == 0) {
+			/* The first reading only establishes the baseline; processor idle during the whole period is skipped */
+			return false;
+		}
+
+		/* MPERF increments at the TSC rate while the processor is not idle, APERF at the actual clock rate */
+		*frequency = (uint64_t) ((double) monitor_reference_frequency * (double) aperf_delta / (double) mperf_delta);
+		return true;
+	}
+#endif
+
+static bool sample_cpufreq(
+	struct processor_sampler sampler[restrict static 1],
+	uint64_t frequency[restrict static 1])
+{
+	char buffer[32];
+	const ssize_t bytes_read = pread(sampler->file, buffer, sizeof(buffer), 0);
+	if (bytes_read <= 0) {
+		return false;
+	}
+
+	/* Locale-independent */
+	uint64_t frequency_khz = 0;
+	ssize_t digits = 0;
+	for (; digits < bytes_read; digits++) {
+		const uint32_t digit = (uint32_t) (buffer[digits] - '0');
+		if (digit >= 10) {
+			break;
+		}
+		frequency_khz = frequency_khz * 10 + digit;
+	}
+	if (digits == 0) {
+		return false;
+	}
+
+	*frequency = frequency_khz * HZ_PER_KHZ;
+	return true;
+}
+
+static void sample_processors(void) {
+	for (uint32_t i = 0; i < monitor_rings->count; i++) {
+		struct processor_sampler* sampler = &monitor_samplers[i];
+		if (sampler->file == -1) {
+			continue;
+		}
+
+		uint64_t frequency = 0;
+		bool sampled = false;
+		switch (monitor_source) {
+			#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+				case cpuinfo_frequency_source_aperf_mperf:
+					sampled = sample_aperf_mperf(sampler, &frequency);
+					break;
+			#endif
+			case cpuinfo_frequency_source_cpufreq:
+				sampled = sample_cpufreq(sampler, &frequency);
+				break;
+			default:
+				break;
+		}
+		if (sampled) {
+			publish_sample(&monitor_rings->rings[i], read_monotonic_clock(), frequency);
+		}
+	}
+}
+
+static void* monitor_thread_main(void* argument) {
+	(void) argument;
+
+	struct timespec deadline;
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	while (!__atomic_load_n(&monitor_stop_requested, __ATOMIC_ACQUIRE)) {
+		sample_processors();
+
+		/* Absolute deadlines keep the sampling period stable regardless of the sampling duration */
+		uint64_t deadline_nanoseconds = (uint64_t) deadline.tv_nsec + monitor_period_us * NANOSECONDS_PER_MICROSECOND;
+		deadline.tv_sec += (time_t) (deadline_nanoseconds / NANOSECONDS_PER_SECOND);
+		deadline.tv_nsec = (long) (deadline_nanoseconds % NANOSECONDS_PER_SECOND);
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR);
+	}
+	return NULL;
+}
+
+static void close_sampler_files(void) {
+	for (uint32_t i = 0; i < monitor_rings->count; i++) {
+		if (monitor_samplers[i].file != -1) {
+			close(monitor_samplers[i].file);
+			monitor_samplers[i].file = -1;
+		}
+	}
+}
+
+/* Opens the per-processor files of the source, and returns the number of processors which can be sampled */
+static uint32_t open_samplers(enum cpuinfo_frequency_source source) {
+	const struct cpuinfo_tables* tables = cpuinfo_get_tables();
+	uint32_t opened = 0;
+	for (uint32_t i = 0; i < monitor_rings->count; i++) {
+		monitor_samplers[i] = (struct processor_sampler) { .file = -1 };
+
+		const int linux_id = tables->processors[i].topology.linux_id;
+		char path[BUFFER_SIZE];
+		bool path_valid = false;
+		switch (source) {
+			case cpuinfo_frequency_source_aperf_mperf:
+			{
+				const int path_length = snprintf(path, BUFFER_SIZE, "/dev/cpu/%d/msr", linux_id);
+				path_valid = path_length > 0 && path_length < BUFFER_SIZE;
+				break;
+			}
+			case cpuinfo_frequency_source_cpufreq:
+				path_valid = cpuinfo_linux_format_cpufreq_path(linux_id, "scaling_cur_freq", BUFFER_SIZE, path);
+				break;
+			default:
+				break;
+		}
+
+		if (path_valid) {
+			monitor_samplers[i].file = open(path, O_RDONLY);
+			if (monitor_samplers[i].file == -1) {
+				cpuinfo_log_debug("failed to open %s: %s", path, strerror(errno));
+			} else {
+				opened += 1;
+			}
+		}
+	}
+	return opened;
+}
+
+/*
+ * Allocates rings for the published tables, unless the current rings were allocated for the same version.
+ * Re-initialization may renumber processors, so samples of previous versions are not reused.
+ */
+static bool allocate_rings(void) {
+	const struct cpuinfo_tables* tables = cpuinfo_get_tables();
+	if (monitor_rings != NULL && monitor_rings->version == tables->version) {
+		return true;
+	}
+
+	const uint32_t processors_count = tables->processors_count;
+	void* rings = NULL;
+	const size_t rings_size = sizeof(struct frequency_rings) + processors_count * sizeof(struct frequency_ring);
+	if (posix_memalign(&rings, RING_ALIGNMENT, rings_size) != 0) {
+		cpuinfo_log_error("failed to allocate %zu bytes for frequency samples of %"PRIu32" logical processors",
+			rings_size, processors_count);
+		return false;
+	}
+	memset(rings, 0, rings_size);
+	struct frequency_rings* new_rings = (struct frequency_rings*) rings;
+	new_rings->version = tables->version;
+	new_rings->count = processors_count;
+	new_rings->retired = monitor_rings;
+	__atomic_store_n(&monitor_rings, new_rings, __ATOMIC_RELEASE);
+	return true;
+}
+
+static enum cpuinfo_frequency_source open_source(void) {
+	#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+		/* APERF/MPERF is preferred: it averages over the whole period rather than reporting the requested frequency */
+		monitor_reference_frequency = cpuinfo_get_tsc().frequency;
+		if (monitor_reference_frequency != 0) {
+			if (open_samplers(cpuinfo_frequency_source_aperf_mperf) == monitor_rings->count) {
+				return cpuinfo_frequency_source_aperf_mperf;
+			}
+			close_sampler_files();
+		}
+	#endif
+	if (open_samplers(cpuinfo_frequency_source_cpufreq) != 0) {
+		return cpuinfo_frequency_source_cpufreq;
+	}
+	return cpuinfo_frequency_source_none;
+}
+
+enum cpuinfo_frequency_source CPUINFO_ABI cpuinfo_frequency_monitor_start(uint32_t period_us) {
+	cpuinfo_initialize();
+
+	pthread_mutex_lock(&monitor_mutex);
+	if (monitor_source != cpuinfo_frequency_source_none) {
+		cpuinfo_log_warning("frequency monitor is already started");
+		goto cleanup;
+	}
+	if (cpuinfo_get_tables()->processors_count == 0 || !allocate_rings()) {
+		goto cleanup;
+	}
+
+	monitor_samplers = calloc(monitor_rings->count, sizeof(struct processor_sampler));
+	if (monitor_samplers == NULL) {
+		cpuinfo_log_error("failed to allocate %zu bytes for frequency samplers of %"PRIu32" logical processors",
+			monitor_rings->count * sizeof(struct processor_sampler), monitor_rings->count);
+		goto cleanup;
+	}
+
+	monitor_source = open_source();
+	if (monitor_source == cpuinfo_frequency_source_none) {
+		cpuinfo_log_info("frequency monitoring is not supported: neither msr device nor cpufreq is accessible");
+		goto cleanup;
+	}
+	/* Establish the baseline of APERF and MPERF counters */
+	sample_processors();
+
+	if (period_us != 0) {
+		monitor_period_us = period_us < MIN_PERIOD_US ? MIN_PERIOD_US : period_us;
+		__atomic_store_n(&monitor_stop_requested, 0, __ATOMIC_RELEASE);
+		const int error = pthread_create(&monitor_thread, NULL, monitor_thread_main, NULL);
+		if (error != 0) {
+			cpuinfo_log_error("failed to create frequency monitor thread: %s", strerror(error));
+			close_sampler_files();
+			monitor_source = cpuinfo_frequency_source_none;
+			goto cleanup;
+		}
+		monitor_thread_started = true;
+	}
+
+cleanup:
+	if (monitor_source == cpuinfo_frequency_source_none) {
+		free(monitor_samplers);
+		monitor_samplers = NULL;
+	}
+	const enum cpuinfo_frequency_source source = monitor_source;
+	pthread_mutex_unlock(&monitor_mutex);
+	return source;
+}
+
+void CPUINFO_ABI cpuinfo_frequency_monitor_stop(void) {
+	pthread_mutex_lock(&monitor_mutex);
+	if (monitor_thread_started) {
+		__atomic_store_n(&monitor_stop_requested, 1, __ATOMIC_RELEASE);
+		pthread_join(monitor_thread, NULL);
+		monitor_thread_started = false;
+	}
+	if (monitor_samplers != NULL) {
+		close_sampler_files();
+		free(monitor_samplers);
+		monitor_samplers = NULL;
+	}
+	monitor_source = cpuinfo_frequency_source_none;
+	pthread_mutex_unlock(&monitor_mutex);
+}
+
+void cpuinfo_linux_free_frequency_history(void) {
+	pthread_mutex_lock(&monitor_mutex);
+	struct frequency_rings* rings = monitor_rings;
+	__atomic_store_n(&monitor_rings, NULL, __ATOMIC_RELEASE);
+	while (rings != NULL) {
+		struct frequency_rings* retired = rings->retired;
+		free(rings);
+		rings = retired;
+	}
+	pthread_mutex_unlock(&monitor_mutex);
+}
+
+bool CPUINFO_ABI cpuinfo_frequency_monitor_sample(void) {
+	pthread_mutex_lock(&monitor_mutex);
+	/* Ring buffers support only one writer */
+	const bool can_sample = monitor_source != cpuinfo_frequency_source_none && !monitor_thread_started;
+	if (can_sample) {
+		sample_processors();
+	}
+	pthread_mutex_unlock(&monitor_mutex);
+	return can_sample;
+}
+
+bool CPUINFO_ABI cpuinfo_get_frequency_sample(uint32_t processor, struct cpuinfo_frequency_sample* sample) {
+	return cpuinfo_get_frequency_history(processor, sample, 1) == 1;
+}
+
+uint32_t CPUINFO_ABI cpuinfo_get_frequency_history(
+	uint32_t processor, struct cpuinfo_frequency_sample* samples, uint32_t max_samples)
+{
+	const struct frequency_rings* rings = __atomic_load_n(&monitor_rings, __ATOMIC_ACQUIRE);
+	if (rings == NULL || processor >= rings->count || samples == NULL) {
+		return 0;
+	}
+	if (rings->version != cpuinfo_get_tables()->version) {
+		/* Processor numbers changed on re-initialization, and the monitor was not restarted since */
+		return 0;
+	}
+
+	const struct frequency_ring* ring = &rings->rings[processor];
+	const uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+	uint32_t available = head < CPUINFO_FREQUENCY_MONITOR_HISTORY ? head : CPUINFO_FREQUENCY_MONITOR_HISTORY;
+	if (available > max_samples) {
+		available = max_samples;
+	}
+
+	uint32_t count = 0;
+	for (; count < available; count++) {
+		/* Stop at the first sample overwritten by the concurrent writer: older samples are overwritten too */
+		if (!read_sample(ring, head - 1 - count, &samples[count])) {
+			break;
+		}
+	}
+	return count;
+}
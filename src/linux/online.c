@@ -0,0 +1,240 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <linux/netlink.h>
+
+#include <cpuinfo.h>
+#include <linux/api.h>
+#include <api.h>
+#include <log.h>
+
+
+/* Lower bound on the polling period of the watcher thread */
+#define MIN_PERIOD_US 1000
+
+#define NANOSECONDS_PER_MILLISECOND UINT64_C(1000000)
+#define NANOSECONDS_PER_MICROSECOND UINT64_C(1000)
+
+/* Size, in chars, of the on-stack buffer for one uevent message. The kernel limits uevents to 2 KB of variables. */
+#define UEVENT_BUFFER_SIZE 4096
+
+/* Multicast group of uevents sent by the kernel, as opposed to uevents re-broadcast by udev */
+#define UEVENT_KERNEL_GROUP 1
+
+static pthread_mutex_t watcher_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_t watcher_thread;
+static bool watcher_thread_started = false;
+static uint32_t watcher_period_us = 0;
+static uint32_t watcher_stop_requested = 0;
+static int watcher_socket = -1;
+/* Event signalled by cpuinfo_online_watcher_stop, to wake the thread without waiting for the end of the period */
+static int watcher_wakeup = -1;
+
+
+bool cpuinfo_linux_update_online_processors(struct cpuinfo_tables* tables, const cpu_set_t* online_set) {
+	bool changed = false;
+	cpu_set_t tracked_set;
+	CPU_ZERO(&tracked_set);
+	for (uint32_t i = 0; i < tables->processors_count; i++) {
+		const int linux_id = tables->processors[i].topology.linux_id;
+		CPU_SET(linux_id, &tracked_set);
+
+		const bool online = online_set == NULL || CPU_ISSET(linux_id, online_set);
+		uint32_t* online_word = &tables->online_mask[i / 32];
+		const uint32_t online_bit = UINT32_C(1) << (i % 32);
+		const bool was_online = (__atomic_load_n(online_word, __ATOMIC_RELAXED) & online_bit) != 0;
+		if (online != was_online) {
+			if (online) {
+				__atomic_fetch_or(online_word, online_bit, __ATOMIC_RELAXED);
+			} else {
+				__atomic_fetch_and(online_word, ~online_bit, __ATOMIC_RELAXED);
+			}
+			if (tables->version != 0) {
+				cpuinfo_log_info("logical processor %"PRIu32" (Linux CPU %d) went %s",
+					i, linux_id, online ? "online" : "offline");
+			}
+			changed = true;
+		}
+	}
+
+	uint32_t untracked_online_count = 0;
+	if (online_set != NULL) {
+		cpu_set_t untracked_online_set;
+		CPU_OR(&untracked_online_set, online_set, &tracked_set);
+		CPU_XOR(&untracked_online_set, &untracked_online_set, &tracked_set);
+		untracked_online_count = (uint32_t) CPU_COUNT(&untracked_online_set);
+	}
+	if (untracked_online_count != tables->untracked_online_count) {
+		if (untracked_online_count != 0) {
+			cpuinfo_log_info("%"PRIu32" online processors are not detected: re-initialize to detect them",
+				untracked_online_count);
+		}
+		tables->untracked_online_count = untracked_online_count;
+		changed = true;
+	}
+	return changed;
+}
+
+bool CPUINFO_ABI cpuinfo_update_online_processors(void) {
+	bool changed = false;
+	cpuinfo_lock_initialization();
+	/* Only the online state is updated, and only under the initialization lock */
+	struct cpuinfo_tables* tables = (struct cpuinfo_tables*) cpuinfo_get_tables();
+	if (tables->online_mask != NULL) {
+		cpu_set_t online_set;
+		if (cpuinfo_linux_read_cpulist_at(cpuinfo_linux_sysfs_dir(), "online", &online_set)) {
+			changed = cpuinfo_linux_update_online_processors(tables, &online_set);
+		}
+		cpuinfo_linux_sysfs_close();
+	}
+	if (changed) {
+		cpuinfo_advance_generation();
+	}
+	cpuinfo_unlock_initialization();
+	return changed;
+}
+
+static int open_uevent_socket(void) {
+	const int socket_fd = socket(AF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_KOBJECT_UEVENT);
+	if (socket_fd == -1) {
+		cpuinfo_log_debug("failed to create uevent socket: %s", strerror(errno));
+		return -1;
+	}
+
+	const struct sockaddr_nl address = {
+		.nl_family = AF_NETLINK,
+		.nl_groups = UEVENT_KERNEL_GROUP,
+	};
+	if (bind(socket_fd, (const struct sockaddr*) &address, sizeof(address)) != 0) {
+		cpuinfo_log_debug("failed to bind uevent socket: %s", strerror(errno));
+		close(socket_fd);
+		return -1;
+	}
+	return socket_fd;
+}
+
+/*
+ * Receives all pending uevents, and checks if any of them is about a processor,
+ * e.g. "offline@/devices/system/cpu/cpu3". Variables after the header are not parsed: the online set is re-read anyway.
+ */
+static bool receive_processor_uevents(void) {
+	static const char devpath_prefix[] = "@/devices/system/cpu/cpu";
+	bool processor_uevent = false;
+	char buffer[UEVENT_BUFFER_SIZE];
+	ssize_t length;
+	while ((length = recv(watcher_socket, buffer, UEVENT_BUFFER_SIZE - 1, MSG_DONTWAIT)) > 0) {
+		buffer[length] = '\0';
+		const char* at = strchr(buffer, '@');
+		if (at != NULL && strncmp(at, devpath_prefix, sizeof(devpath_prefix) - 1) == 0) {
+			processor_uevent = true;
+		}
+	}
+	return processor_uevent;
+}
+
+static uint64_t read_monotonic_clock(void) {
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (uint64_t) time.tv_sec * UINT64_C(1000000000) + (uint64_t) time.tv_nsec;
+}
+
+static void* watcher_thread_main(void* argument) {
+	(void) argument;
+
+	const uint64_t period_nanoseconds = watcher_period_us * NANOSECONDS_PER_MICROSECOND;
+	uint64_t deadline = read_monotonic_clock() + period_nanoseconds;
+	while (!__atomic_load_n(&watcher_stop_requested, __ATOMIC_ACQUIRE)) {
+		const uint64_t now = read_monotonic_clock();
+		if (now < deadline) {
+			/* Round the timeout up, so that polling does not spin before the deadline */
+			const int timeout_ms =
+				(int) ((deadline - now + NANOSECONDS_PER_MILLISECOND - 1) / NANOSECONDS_PER_MILLISECOND);
+			/* poll ignores the uevent socket if it is not open */
+			struct pollfd pollfds[2] = {
+				{ .fd = watcher_wakeup, .events = POLLIN },
+				{ .fd = watcher_socket, .events = POLLIN },
+			};
+			if (poll(pollfds, 2, timeout_ms) <= 0 || !(pollfds[1].revents & POLLIN) || !receive_processor_uevents()) {
+				continue;
+			}
+		}
+
+		cpuinfo_update_online_processors();
+		deadline = read_monotonic_clock() + period_nanoseconds;
+	}
+	return NULL;
+}
+
+static void close_watcher_descriptors(void) {
+	if (watcher_socket != -1) {
+		close(watcher_socket);
+		watcher_socket = -1;
+	}
+	if (watcher_wakeup != -1) {
+		close(watcher_wakeup);
+		watcher_wakeup = -1;
+	}
+}
+
+bool CPUINFO_ABI cpuinfo_online_watcher_start(uint32_t period_us) {
+	cpuinfo_initialize();
+
+	bool started = false;
+	pthread_mutex_lock(&watcher_mutex);
+	if (watcher_thread_started) {
+		cpuinfo_log_warning("online watcher is already started");
+		goto cleanup;
+	}
+
+	/* Catch up with changes since initialization */
+	cpuinfo_update_online_processors();
+
+	watcher_wakeup = eventfd(0, EFD_CLOEXEC);
+	if (watcher_wakeup == -1) {
+		cpuinfo_log_error("failed to create online watcher wakeup event: %s", strerror(errno));
+		goto cleanup;
+	}
+
+	watcher_socket = open_uevent_socket();
+	if (watcher_socket == -1) {
+		cpuinfo_log_info("CPU hotplug uevents are not available: online state is only polled");
+	}
+	watcher_period_us = period_us < MIN_PERIOD_US ? MIN_PERIOD_US : period_us;
+	__atomic_store_n(&watcher_stop_requested, 0, __ATOMIC_RELEASE);
+	const int error = pthread_create(&watcher_thread, NULL, watcher_thread_main, NULL);
+	if (error != 0) {
+		cpuinfo_log_error("failed to create online watcher thread: %s", strerror(error));
+		close_watcher_descriptors();
+		goto cleanup;
+	}
+	watcher_thread_started = true;
+	started = true;
+
+cleanup:
+	pthread_mutex_unlock(&watcher_mutex);
+	return started;
+}
+
+void CPUINFO_ABI cpuinfo_online_watcher_stop(void) {
+	pthread_mutex_lock(&watcher_mutex);
+	if (watcher_thread_started) {
+		__atomic_store_n(&watcher_stop_requested, 1, __ATOMIC_RELEASE);
+		if (eventfd_write(watcher_wakeup, 1) != 0) {
+			cpuinfo_log_warning("failed to wake online watcher: %s", strerror(errno));
+		}
+		pthread_join(watcher_thread, NULL);
+		watcher_thread_started = false;
+	}
+	close_watcher_descriptors();
+	pthread_mutex_unlock(&watcher_mutex);
+}
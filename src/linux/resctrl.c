@@ -0,0 +1,152 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <unistd.h>
+#include <fcntl.h>
+
+#if CPUINFO_MOCK
+	#include <cpuinfo-mock.h>
+#endif
+#include <cpuinfo.h>
+#include <linux/api.h>
+#include <log.h>
+
+
+static const char* resctrl_path = "/sys/fs/resctrl";
+
+#if CPUINFO_MOCK
+	void CPUINFO_ABI cpuinfo_set_resctrl_path(const char* path) {
+		/* Note: this leaks memory */
+		resctrl_path = strdup(path);
+	}
+#endif
+
+
+/* Size, in chars, of the on-stack buffers for names and contents of resctrl info files */
+#define BUFFER_SIZE 256
+
+
+/* Formats the path of an info file relative to the info directory of resctrl */
+static bool format_info_path(const char* resource, const char* name, char path[restrict static BUFFER_SIZE]) {
+	const int path_length = snprintf(path, BUFFER_SIZE, "%s/%s", resource, name);
+	if (path_length <= 0 || path_length >= BUFFER_SIZE) {
+		cpuinfo_log_warning("path to resctrl info file %s/%s is too long", resource, name);
+		return false;
+	}
+	return true;
+}
+
+static bool read_info_file(int info_dir, const char* resource, const char* name, char buffer[restrict static BUFFER_SIZE]) {
+	char path[BUFFER_SIZE];
+	if (!format_info_path(resource, name, path)) {
+		return false;
+	}
+
+	size_t length = 0;
+	return cpuinfo_linux_read_file_at(info_dir, path, BUFFER_SIZE, buffer, &length);
+}
+
+static bool read_info_number(int info_dir, const char* resource, const char* name, uint32_t base, uint32_t number_ptr[restrict static 1]) {
+	char path[BUFFER_SIZE];
+	if (!format_info_path(resource, name, path)) {
+		return false;
+	}
+
+	uint64_t number = 0;
+	if (!cpuinfo_linux_read_number_at(info_dir, path, base, &number)) {
+		return false;
+	}
+	*number_ptr = (uint32_t) number;
+	return true;
+}
+
+static uint32_t count_bits(uint32_t mask) {
+	uint32_t bits = 0;
+	for (; mask != 0; mask &= mask - 1) {
+		bits += 1;
+	}
+	return bits;
+}
+
+/*
+ * With Code and Data Prioritization enabled, the kernel replaces the resource directory (e.g. L3)
+ * with a pair of directories for code (e.g. L3CODE) and data (e.g. L3DATA) capacity bitmasks.
+ */
+static void detect_cache_allocation(
+	int info_dir, const char* resource, const char* code_resource,
+	struct cpuinfo_cache_allocation allocation[restrict static 1])
+{
+	uint32_t classes = 0;
+	bool cdp = false;
+	if (read_info_number(info_dir, code_resource, "num_closids", 10, &classes)) {
+		resource = code_resource;
+		cdp = true;
+	} else if (!read_info_number(info_dir, resource, "num_closids", 10, &classes)) {
+		return;
+	}
+
+	allocation->classes = classes;
+	allocation->cdp |= cdp;
+
+	uint32_t cbm_mask = 0;
+	if (read_info_number(info_dir, resource, "cbm_mask", 16, &cbm_mask)) {
+		allocation->bitmask_length = count_bits(cbm_mask);
+	}
+	uint32_t shareable_bits = 0;
+	if (read_info_number(info_dir, resource, "shareable_bits", 16, &shareable_bits)) {
+		allocation->shareable_bits = shareable_bits;
+	}
+}
+
+static void detect_bandwidth_allocation(int info_dir, struct cpuinfo_bandwidth_allocation allocation[restrict static 1]) {
+	uint32_t classes = 0;
+	if (!read_info_number(info_dir, "MB", "num_closids", 10, &classes)) {
+		return;
+	}
+
+	allocation->classes = classes;
+
+	uint32_t granularity = 0;
+	if (read_info_number(info_dir, "MB", "bandwidth_gran", 10, &granularity)) {
+		allocation->granularity = granularity;
+	}
+	uint32_t linear = 0;
+	if (read_info_number(info_dir, "MB", "delay_linear", 10, &linear)) {
+		allocation->linear = linear != 0;
+	}
+}
+
+static void detect_cache_monitoring(int info_dir, struct cpuinfo_cache_monitoring monitoring[restrict static 1]) {
+	uint32_t rmids = 0;
+	if (!read_info_number(info_dir, "L3_MON", "num_rmids", 10, &rmids)) {
+		return;
+	}
+
+	monitoring->rmids = rmids;
+
+	/* One monitoring event name per line */
+	char buffer[BUFFER_SIZE];
+	if (read_info_file(info_dir, "L3_MON", "mon_features", buffer)) {
+		monitoring->occupancy = strstr(buffer, "llc_occupancy") != NULL;
+		monitoring->total_bandwidth = strstr(buffer, "mbm_total_bytes") != NULL;
+		monitoring->local_bandwidth = strstr(buffer, "mbm_local_bytes") != NULL;
+	}
+}
+
+void cpuinfo_linux_detect_resctrl(struct cpuinfo_qos qos[restrict static 1]) {
+	char path[BUFFER_SIZE];
+	const int path_length = snprintf(path, BUFFER_SIZE, "%s/info", resctrl_path);
+	const int info_dir = path_length <= 0 || path_length >= BUFFER_SIZE ? -1 : cpuinfo_linux_open_dir(AT_FDCWD, path);
+	if (info_dir == -1) {
+		cpuinfo_log_debug("resctrl filesystem is not mounted at %s", resctrl_path);
+		return;
+	}
+
+	detect_cache_allocation(info_dir, "L3", "L3CODE", &qos->l3);
+	detect_cache_allocation(info_dir, "L2", "L2CODE", &qos->l2);
+	detect_bandwidth_allocation(info_dir, &qos->memory_bandwidth);
+	detect_cache_monitoring(info_dir, &qos->l3_monitoring);
+	close(info_dir);
+}
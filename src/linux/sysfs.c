@@ -0,0 +1,221 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include <sys/types.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sched.h>
+
+#if CPUINFO_MOCK
+	#include <cpuinfo-mock.h>
+#endif
+#include <cpuinfo.h>
+#include <linux/api.h>
+#include <log.h>
+
+
+/* Size, in chars, of the on-stack buffers for sysfs file names and numbers */
+#define BUFFER_SIZE 64
+
+/* Size, in chars, of the on-stack buffer for cpu lists and masks. sysfs attributes never exceed a page. */
+#define CPULIST_BUFFER_SIZE 4096
+
+/* Values of cached descriptors for directories which were not opened yet, and which failed to open */
+#define DIR_NOT_OPENED -1
+#define DIR_MISSING    -2
+
+static const char* sysfs_cpu_path = "/sys/devices/system/cpu";
+
+/*
+ * Descriptors of the sysfs cpu directory and its cpu<N> subdirectories, opened on first use.
+ * Files inside are opened relative to them, so the kernel resolves only the last path components.
+ * The cache is not thread-safe, and is only used during initialization.
+ */
+static int sysfs_cpu_dir = DIR_NOT_OPENED;
+static int* processor_dirs = NULL;
+static uint32_t processor_dirs_count = 0;
+
+#if CPUINFO_MOCK
+	void CPUINFO_ABI cpuinfo_set_sysfs_cpu_path(const char* path) {
+		cpuinfo_linux_sysfs_close();
+		/* Note: this leaks memory */
+		sysfs_cpu_path = strdup(path);
+	}
+#endif
+
+
+bool cpuinfo_linux_format_cpufreq_path(int processor, const char* name, size_t path_size, char path[restrict static 1]) {
+	const int path_length = snprintf(path, path_size, "%s/cpu%d/cpufreq/%s", sysfs_cpu_path, processor, name);
+	if (path_length <= 0 || (size_t) path_length >= path_size) {
+		cpuinfo_log_warning("path to cpufreq file %s of processor %d is too long", name, processor);
+		return false;
+	}
+	return true;
+}
+
+int cpuinfo_linux_open_dir(int parent_dir, const char* path) {
+	const int dir = openat(parent_dir, path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if (dir == -1) {
+		cpuinfo_log_debug("failed to open directory %s: %s", path, strerror(errno));
+	}
+	return dir;
+}
+
+int cpuinfo_linux_sysfs_dir(void) {
+	if (sysfs_cpu_dir == DIR_NOT_OPENED) {
+		const int dir = cpuinfo_linux_open_dir(AT_FDCWD, sysfs_cpu_path);
+		sysfs_cpu_dir = dir == -1 ? DIR_MISSING : dir;
+	}
+	return sysfs_cpu_dir < 0 ? -1 : sysfs_cpu_dir;
+}
+
+int cpuinfo_linux_sysfs_processor_dir(uint32_t processor) {
+	if (processor >= processor_dirs_count) {
+		uint32_t new_processor_dirs_count = processor_dirs_count == 0 ? 64 : processor_dirs_count * 2;
+		if (new_processor_dirs_count <= processor) {
+			new_processor_dirs_count = processor + 1;
+		}
+		int* new_processor_dirs = realloc(processor_dirs, new_processor_dirs_count * sizeof(int));
+		if (new_processor_dirs == NULL) {
+			cpuinfo_log_error("failed to allocate %zu bytes for sysfs directories of %"PRIu32" processors",
+				new_processor_dirs_count * sizeof(int), new_processor_dirs_count);
+			return -1;
+		}
+		for (uint32_t i = processor_dirs_count; i < new_processor_dirs_count; i++) {
+			new_processor_dirs[i] = DIR_NOT_OPENED;
+		}
+		processor_dirs = new_processor_dirs;
+		processor_dirs_count = new_processor_dirs_count;
+	}
+
+	if (processor_dirs[processor] == DIR_NOT_OPENED) {
+		const int sysfs_dir = cpuinfo_linux_sysfs_dir();
+		if (sysfs_dir == -1) {
+			return -1;
+		}
+
+		char name[BUFFER_SIZE];
+		snprintf(name, BUFFER_SIZE, "cpu%"PRIu32, processor);
+		const int dir = cpuinfo_linux_open_dir(sysfs_dir, name);
+		processor_dirs[processor] = dir == -1 ? DIR_MISSING : dir;
+	}
+	return processor_dirs[processor] < 0 ? -1 : processor_dirs[processor];
+}
+
+void cpuinfo_linux_sysfs_close(void) {
+	for (uint32_t i = 0; i < processor_dirs_count; i++) {
+		if (processor_dirs[i] >= 0) {
+			close(processor_dirs[i]);
+		}
+	}
+	free(processor_dirs);
+	processor_dirs = NULL;
+	processor_dirs_count = 0;
+
+	if (sysfs_cpu_dir >= 0) {
+		close(sysfs_cpu_dir);
+	}
+	sysfs_cpu_dir = DIR_NOT_OPENED;
+}
+
+bool cpuinfo_linux_read_file_at(
+	int dir,
+	const char* name,
+	size_t buffer_size,
+	char buffer[restrict static 1],
+	size_t length_ptr[restrict static 1])
+{
+	if (dir == -1) {
+		return false;
+	}
+
+	const int file = openat(dir, name, O_RDONLY | O_CLOEXEC);
+	if (file == -1) {
+		cpuinfo_log_debug("failed to open %s: %s", name, strerror(errno));
+		return false;
+	}
+
+	size_t length = 0;
+	ssize_t bytes_read;
+	do {
+		bytes_read = read(file, &buffer[length], buffer_size - 1 - length);
+		if (bytes_read < 0) {
+			cpuinfo_log_warning("failed to read %s: %s", name, strerror(errno));
+			close(file);
+			return false;
+		}
+		length += (size_t) bytes_read;
+	} while (bytes_read != 0 && length < buffer_size - 1);
+	close(file);
+
+	buffer[length] = '\0';
+	*length_ptr = length;
+	return true;
+}
+
+/* Locale-independent */
+bool cpuinfo_linux_read_number_at(int dir, const char* name, uint32_t base, uint64_t value_ptr[restrict static 1]) {
+	char buffer[BUFFER_SIZE];
+	size_t length = 0;
+	if (!cpuinfo_linux_read_file_at(dir, name, BUFFER_SIZE, buffer, &length)) {
+		return false;
+	}
+
+	const char* digit_ptr = buffer;
+	if (base == 16 && length >= 2 && buffer[0] == '0' && (buffer[1] == 'x' || buffer[1] == 'X')) {
+		digit_ptr += 2;
+	}
+
+	uint64_t value = 0;
+	const char* const digits_start = digit_ptr;
+	for (; *digit_ptr != '\0'; digit_ptr++) {
+		const char c = *digit_ptr;
+		uint32_t digit;
+		if (c >= '0' && c <= '9') {
+			digit = (uint32_t) (c - '0');
+		} else if (c >= 'a' && c <= 'f') {
+			digit = 10 + (uint32_t) (c - 'a');
+		} else if (c >= 'A' && c <= 'F') {
+			digit = 10 + (uint32_t) (c - 'A');
+		} else {
+			break;
+		}
+		if (digit >= base) {
+			break;
+		}
+		value = value * base + digit;
+	}
+	if (digit_ptr == digits_start) {
+		cpuinfo_log_warning("failed to parse %s: \"%.*s\" is not a number", name, (int) length, buffer);
+		return false;
+	}
+
+	*value_ptr = value;
+	return true;
+}
+
+bool cpuinfo_linux_read_cpulist_at(int dir, const char* name, cpu_set_t cpuset[restrict static 1]) {
+	CPU_ZERO(cpuset);
+
+	char buffer[CPULIST_BUFFER_SIZE];
+	size_t length = 0;
+	if (!cpuinfo_linux_read_file_at(dir, name, CPULIST_BUFFER_SIZE, buffer, &length)) {
+		return false;
+	}
+	return cpuinfo_linux_parse_cpulist(buffer, buffer + length, cpuset);
+}
+
+bool cpuinfo_linux_read_cpumask_at(int dir, const char* name, cpu_set_t cpuset[restrict static 1]) {
+	CPU_ZERO(cpuset);
+
+	char buffer[CPULIST_BUFFER_SIZE];
+	size_t length = 0;
+	if (!cpuinfo_linux_read_file_at(dir, name, CPULIST_BUFFER_SIZE, buffer, &length)) {
+		return false;
+	}
+	return cpuinfo_linux_parse_cpumask(buffer, buffer + length, cpuset);
+}
@@ -0,0 +1,33 @@
+#include <stddef.h>
+
+#include <cpuinfo.h>
+#include <api.h>
+
+
+/*
+ * Each bit of the capacity bitmask controls an equal share of the cache.
+ * On all known implementations the share is a whole number of ways, usually exactly one.
+ */
+static void map_allocation_to_cache(
+	struct cpuinfo_cache_allocation allocation[restrict static 1],
+	const struct cpuinfo_tables tables[restrict static 1],
+	enum cpuinfo_cache_level level)
+{
+	if (allocation->bitmask_length == 0 || tables->cache_count[level] == 0) {
+		return;
+	}
+
+	const struct cpuinfo_cache* cache = &tables->cache[level][0];
+	if (cache->associativity % allocation->bitmask_length == 0) {
+		allocation->ways_per_bit = cache->associativity / allocation->bitmask_length;
+	}
+	allocation->bytes_per_bit = cache->size / allocation->bitmask_length;
+}
+
+struct cpuinfo_qos CPUINFO_ABI cpuinfo_get_qos(void) {
+	const struct cpuinfo_tables* tables = cpuinfo_get_tables();
+	struct cpuinfo_qos qos = tables->qos;
+	map_allocation_to_cache(&qos.l2, tables, cpuinfo_cache_level_2);
+	map_allocation_to_cache(&qos.l3, tables, cpuinfo_cache_level_3);
+	return qos;
+}
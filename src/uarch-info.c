@@ -0,0 +1,74 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include <cpuinfo.h>
+#include <utils.h>
+
+
+/*
+ * Characteristics are per core, and describe peak throughput with all execution ports busy.
+ * Microarchitectures with uncertain or undocumented characteristics are not listed.
+ */
+static const struct {
+	enum cpuinfo_uarch uarch;
+	struct cpuinfo_uarch_info info;
+} uarch_infos[] = {
+	/* Intel big cores */
+	{ cpuinfo_uarch_conroe,       { 128, 0,  16, 16, false, false } },
+	{ cpuinfo_uarch_penryn,       { 128, 0,  16, 16, false, false } },
+	{ cpuinfo_uarch_nehalem,      { 128, 0,  16, 16, false, false } },
+	/* Two 128-bit load ports; a 256-bit load occupies one port for two cycles */
+	{ cpuinfo_uarch_sandy_bridge, { 256, 0,  32, 16, false, false } },
+	{ cpuinfo_uarch_ivy_bridge,   { 256, 0,  32, 16, false, false } },
+	{ cpuinfo_uarch_haswell,      { 256, 2,  64, 32, false, true  } },
+	{ cpuinfo_uarch_broadwell,    { 256, 2,  64, 32, false, true  } },
+	{ cpuinfo_uarch_sky_lake,     { 256, 2,  64, 32, false, true  } },
+	{ cpuinfo_uarch_kaby_lake,    { 256, 2,  64, 32, false, true  } },
+	/* Sky Lake server cores (Xeon Scalable) have 512-bit execution units and two 64-byte load ports */
+	{ cpuinfo_uarch_sky_lake_server, { 512, 2, 128, 64, false, true } },
+	/* Three load and two store ports; AVX-512 is disabled on hybrid processors */
+	{ cpuinfo_uarch_golden_cove,  { 256, 2,  96, 64, false, false } },
+	{ cpuinfo_uarch_raptor_cove,  { 256, 2,  96, 64, false, false } },
+	{ cpuinfo_uarch_redwood_cove, { 256, 2,  96, 64, false, false } },
+	{ cpuinfo_uarch_golden_cove_server, { 512, 2, 128, 64, false, true } },
+	/* Intel low-power cores */
+	{ cpuinfo_uarch_bonnell,      { 128, 0,  16, 16, false, false } },
+	{ cpuinfo_uarch_saltwell,     { 128, 0,  16, 16, false, false } },
+	{ cpuinfo_uarch_silvermont,   { 128, 0,  16, 16, false, false } },
+	{ cpuinfo_uarch_airmont,      { 128, 0,  16, 16, false, false } },
+	/* 256-bit AVX instructions are split into two 128-bit operations */
+	{ cpuinfo_uarch_gracemont,    { 128, 2,  32, 32, true,  false } },
+	{ cpuinfo_uarch_crestmont,    { 128, 2,  32, 32, true,  false } },
+	/* Intel Knights-series cores */
+	{ cpuinfo_uarch_knights_landing, { 512, 2, 128, 64, false, true } },
+	{ cpuinfo_uarch_knights_mill,    { 512, 2, 128, 64, false, true } },
+	/* AMD cores; two FMA units of a Bulldozer-family module are shared by its two cores */
+	{ cpuinfo_uarch_k10,          { 128, 0,  32, 16, false, false } },
+	{ cpuinfo_uarch_bulldozer,    { 128, 2,  32, 16, true,  false } },
+	{ cpuinfo_uarch_piledriver,   { 128, 2,  32, 16, true,  false } },
+	{ cpuinfo_uarch_steamroller,  { 128, 2,  32, 16, true,  false } },
+	{ cpuinfo_uarch_excavator,    { 128, 2,  32, 16, true,  false } },
+	{ cpuinfo_uarch_zen,          { 128, 2,  32, 16, true,  false } },
+	{ cpuinfo_uarch_zen3,         { 256, 2,  64, 32, false, false } },
+	/* AVX-512 instructions execute as two 256-bit halves without frequency reduction */
+	{ cpuinfo_uarch_zen4,         { 256, 2,  64, 32, true,  false } },
+	{ cpuinfo_uarch_jaguar,       { 128, 0,  16, 16, true,  false } },
+	/* ARM cores; 128-bit NEON instructions are split on cores with 64-bit NEON datapath */
+	{ cpuinfo_uarch_cortex_a7,    {  64, 1,   8,  8, true,  false } },
+	{ cpuinfo_uarch_cortex_a9,    {  64, 0,   8,  8, true,  false } },
+	{ cpuinfo_uarch_cortex_a15,   { 128, 1,  16, 16, false, false } },
+	{ cpuinfo_uarch_cortex_a53,   {  64, 1,   8,  8, true,  false } },
+	{ cpuinfo_uarch_cortex_a57,   { 128, 1,  16, 16, false, false } },
+	{ cpuinfo_uarch_cortex_a72,   { 128, 1,  16, 16, false, false } },
+	{ cpuinfo_uarch_cortex_a73,   { 128, 1,  16, 16, false, false } },
+};
+
+struct cpuinfo_uarch_info CPUINFO_ABI cpuinfo_get_uarch_info(enum cpuinfo_uarch uarch) {
+	for (size_t i = 0; i < CPUINFO_COUNT_OF(uarch_infos); i++) {
+		if (uarch_infos[i].uarch == uarch) {
+			return uarch_infos[i].info;
+		}
+	}
+	return (struct cpuinfo_uarch_info) { 0 };
+}
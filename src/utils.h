@@ -3,6 +3,9 @@
 #include <stdint.h>
 
 
+#define CPUINFO_COUNT_OF(array) (sizeof(array) / sizeof(0[array]))
+
+
 inline static uint32_t bit_length(uint32_t n) {
 	const uint32_t n_minus_1 = n - 1;
 	if (n_minus_1 == 0) {
@@ -0,0 +1,84 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(__linux__)
+	#include <errno.h>
+	#include <string.h>
+	#include <unistd.h>
+	#include <sys/syscall.h>
+#endif
+
+#include <cpuinfo.h>
+#include <x86/cpuid.h>
+#include <x86/api.h>
+#include <api.h>
+#include <log.h>
+
+
+#if defined(__linux__)
+	/* Constants from arch/x86/include/uapi/asm/prctl.h, missing in older kernel headers */
+	#ifndef ARCH_REQ_XCOMP_PERM
+		#define ARCH_REQ_XCOMP_PERM 0x1023
+	#endif
+
+	/* Index of tile data state component in XCR0 */
+	#define XFEATURE_XTILEDATA 18
+#endif
+
+struct cpuinfo_amx cpuinfo_x86_detect_amx(uint32_t max_base_index) {
+	struct cpuinfo_amx amx = { 0 };
+
+	/*
+	 * Tile information:
+	 * - Intel: eax in sub-leaf 0 of tile information leaf 0x1D = highest palette ID.
+	 * - Intel: eax[bits 0-15] in sub-leaf 1 = total tile bytes.
+	 * - Intel: eax[bits 16-31] in sub-leaf 1 = bytes per tile.
+	 * - Intel: ebx[bits 0-15] in sub-leaf 1 = bytes per row.
+	 * - Intel: ebx[bits 16-31] in sub-leaf 1 = number of tile registers.
+	 * - Intel: ecx[bits 0-15] in sub-leaf 1 = maximum number of rows.
+	 */
+	if (max_base_index >= UINT32_C(0x1D)) {
+		amx.max_palette = cpuidex(UINT32_C(0x1D), 0).eax;
+		if (amx.max_palette >= 1) {
+			const struct cpuid_regs palette_info = cpuidex(UINT32_C(0x1D), 1);
+			amx.total_tile_bytes = palette_info.eax & UINT32_C(0x0000FFFF);
+			amx.bytes_per_tile   = palette_info.eax >> 16;
+			amx.bytes_per_row    = palette_info.ebx & UINT32_C(0x0000FFFF);
+			amx.tiles            = palette_info.ebx >> 16;
+			amx.max_rows         = palette_info.ecx & UINT32_C(0x0000FFFF);
+		}
+	}
+
+	/*
+	 * TMUL information:
+	 * - Intel: ebx[bits 0-7] in sub-leaf 0 of TMUL information leaf 0x1E = maximum K dimension.
+	 * - Intel: ebx[bits 8-23] in sub-leaf 0 = maximum N dimension in bytes.
+	 */
+	if (max_base_index >= UINT32_C(0x1E)) {
+		const struct cpuid_regs tmul_info = cpuidex(UINT32_C(0x1E), 0);
+		amx.tmul_max_k = tmul_info.ebx & UINT32_C(0x000000FF);
+		amx.tmul_max_n = (tmul_info.ebx >> 8) & UINT32_C(0x0000FFFF);
+	}
+
+	cpuinfo_log_debug("AMX palettes: %"PRIu32", %"PRIu32" tiles of %"PRIu32" rows x %"PRIu32" bytes",
+		amx.max_palette, amx.tiles, amx.max_rows, amx.bytes_per_row);
+	return amx;
+}
+
+struct cpuinfo_amx CPUINFO_ABI cpuinfo_get_amx(void) {
+	return cpuinfo_get_tables()->amx;
+}
+
+bool CPUINFO_ABI cpuinfo_request_amx_permission(void) {
+	if (!cpuinfo_get_tables()->isa.amx_tile) {
+		return false;
+	}
+
+	#if defined(__linux__)
+		if (syscall(SYS_arch_prctl, ARCH_REQ_XCOMP_PERM, XFEATURE_XTILEDATA) != 0) {
+			cpuinfo_log_warning("failed to request permission for AMX tile data: %s", strerror(errno));
+			return false;
+		}
+	#endif
+	return true;
+}
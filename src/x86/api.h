@@ -47,6 +47,8 @@ struct cpuinfo_x86_topology {
 struct cpuinfo_x86_processor {
 	enum cpuinfo_vendor vendor;
 	enum cpuinfo_uarch uarch;
+	enum cpuinfo_core_type core_type;
+	uint32_t native_model_id;
 	struct cpuinfo_x86_model_info model_info;
 	struct cpuinfo_x86_caches cache;
 	struct {
@@ -74,6 +76,9 @@ struct cpuinfo_x86_model_info cpuinfo_x86_decode_model_info(uint32_t eax);
 enum cpuinfo_uarch cpuinfo_x86_decode_uarch(
 	enum cpuinfo_vendor vendor,
 	const struct cpuinfo_x86_model_info model_info[restrict static 1]);
+enum cpuinfo_uarch cpuinfo_x86_decode_hybrid_uarch(
+	enum cpuinfo_uarch uarch,
+	enum cpuinfo_core_type core_type);
 
 struct cpuinfo_x86_isa cpuinfo_x86_detect_isa(
 	const struct cpuid_regs basic_info, const struct cpuid_regs extended_info,
@@ -81,6 +86,32 @@ struct cpuinfo_x86_isa cpuinfo_x86_detect_isa(
 	enum cpuinfo_vendor vendor, enum cpuinfo_uarch uarch);
 struct cpuinfo_x86_isa cpuinfo_x86_nacl_detect_isa(void);
 
+struct cpuinfo_qos cpuinfo_x86_detect_qos(uint32_t max_base_index, uint32_t max_extended_index);
+
+struct cpuinfo_tables;
+
+struct cpuinfo_tsc cpuinfo_x86_detect_tsc(
+	uint32_t max_base_index, uint32_t max_extended_index, struct cpuid_regs leaf1,
+	const struct cpuinfo_x86_model_info model_info[restrict static 1]);
+/* Calibrates TSC of the tables if its frequency is not reported by CPUID, and computes the tick conversion */
+void cpuinfo_x86_init_tsc(struct cpuinfo_tables* tables);
+
+struct cpuinfo_hypervisor cpuinfo_x86_detect_hypervisor(struct cpuid_regs leaf1);
+
+struct cpuinfo_amx cpuinfo_x86_detect_amx(uint32_t max_base_index);
+
+void cpuinfo_x86_detect_xsave(
+	uint32_t max_base_index, struct cpuid_regs leaf1,
+	struct cpuinfo_xsave xsave[restrict static 1],
+	struct cpuinfo_xsave_component components[restrict static CPUINFO_XSAVE_MAX_COMPONENTS]);
+
+/*
+ * Fills capabilities of the platform in new tables: ISA from cpuinfo_x86_init_processor, and hypervisor, QoS, TSC,
+ * AMX, and XSAVE from CPUID of the calling processor. Called once per initialization, after all processors.
+ * Fields of the tables must be zero-initialized.
+ */
+void cpuinfo_x86_detect_platform(struct cpuinfo_tables* tables);
+
 void cpuinfo_x86_detect_topology(
 	uint32_t max_base_index,
 	uint32_t max_extended_index,
@@ -84,5 +84,10 @@ iterate_descriptors:
 		do {
 			leaf0x8000001D = cpuidex(UINT32_C(0x8000001D), input_ecx++);
 		} while (cpuinfo_x86_decode_cache_properties(leaf0x8000001D, cache));
+
+		/* L3 of AMD processors with topology extensions (Bulldozer, Zen) is a victim cache of L2 */
+		if (vendor == cpuinfo_vendor_amd && cache->l3.size != 0 && !(cache->l3.flags & CPUINFO_CACHE_INCLUSIVE)) {
+			cache->l3.flags |= CPUINFO_CACHE_EXCLUSIVE;
+		}
 	}
 }
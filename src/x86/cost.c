@@ -0,0 +1,223 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <cpuinfo.h>
+
+
+#define COST(latency, reciprocal_throughput) { latency, reciprocal_throughput, false }
+#define MICROCODED(latency, reciprocal_throughput) { latency, reciprocal_throughput, true }
+
+enum cost_table {
+	cost_table_haswell = 0,
+	cost_table_broadwell,
+	cost_table_sky_lake,
+	cost_table_sky_lake_server,
+	cost_table_zen,
+	cost_table_zen3,
+	cost_table_zen4,
+	cost_table_count,
+};
+
+/*
+ * Zero entries are unknown or not supported by the microarchitecture.
+ * Gather latency depends on the memory hierarchy, and is not listed.
+ */
+static const struct cpuinfo_x86_instruction_cost cost_tables[cost_table_count][cpuinfo_x86_instruction_count] = {
+	[cost_table_haswell] = {
+		[cpuinfo_x86_instruction_popcnt_r64]     = COST(3, 100),
+		[cpuinfo_x86_instruction_lzcnt_r64]      = COST(3, 100),
+		[cpuinfo_x86_instruction_tzcnt_r64]      = COST(3, 100),
+		[cpuinfo_x86_instruction_pdep_r64]       = COST(3, 100),
+		[cpuinfo_x86_instruction_pext_r64]       = COST(3, 100),
+		[cpuinfo_x86_instruction_imul_r64]       = COST(3, 100),
+		[cpuinfo_x86_instruction_mulx_r64]       = COST(4, 100),
+		[cpuinfo_x86_instruction_crc32_r64]      = COST(3, 100),
+		[cpuinfo_x86_instruction_pshufb_xmm]     = COST(1, 100),
+		[cpuinfo_x86_instruction_vpshufb_ymm]    = COST(1, 100),
+		[cpuinfo_x86_instruction_vpermd_ymm]     = COST(3, 100),
+		[cpuinfo_x86_instruction_vpermps_ymm]    = COST(3, 100),
+		[cpuinfo_x86_instruction_vpgatherdd_ymm] = COST(0, 1200),
+		[cpuinfo_x86_instruction_vfmadd_ps_ymm]  = COST(5, 50),
+		[cpuinfo_x86_instruction_vpmaddubsw_ymm] = COST(5, 100),
+		[cpuinfo_x86_instruction_vpmaddwd_ymm]   = COST(5, 100),
+		[cpuinfo_x86_instruction_aesenc_xmm]     = COST(7, 100),
+		[cpuinfo_x86_instruction_pclmulqdq_xmm]  = COST(7, 200),
+		[cpuinfo_x86_instruction_vdivps_ymm]     = COST(21, 1400),
+	},
+	[cost_table_broadwell] = {
+		[cpuinfo_x86_instruction_popcnt_r64]     = COST(3, 100),
+		[cpuinfo_x86_instruction_lzcnt_r64]      = COST(3, 100),
+		[cpuinfo_x86_instruction_tzcnt_r64]      = COST(3, 100),
+		[cpuinfo_x86_instruction_pdep_r64]       = COST(3, 100),
+		[cpuinfo_x86_instruction_pext_r64]       = COST(3, 100),
+		[cpuinfo_x86_instruction_imul_r64]       = COST(3, 100),
+		[cpuinfo_x86_instruction_mulx_r64]       = COST(4, 100),
+		[cpuinfo_x86_instruction_adcx_r64]       = COST(1, 100),
+		[cpuinfo_x86_instruction_crc32_r64]      = COST(3, 100),
+		[cpuinfo_x86_instruction_pshufb_xmm]     = COST(1, 100),
+		[cpuinfo_x86_instruction_vpshufb_ymm]    = COST(1, 100),
+		[cpuinfo_x86_instruction_vpermd_ymm]     = COST(3, 100),
+		[cpuinfo_x86_instruction_vpermps_ymm]    = COST(3, 100),
+		[cpuinfo_x86_instruction_vpgatherdd_ymm] = COST(0, 600),
+		[cpuinfo_x86_instruction_vfmadd_ps_ymm]  = COST(5, 50),
+		[cpuinfo_x86_instruction_vpmaddubsw_ymm] = COST(5, 100),
+		[cpuinfo_x86_instruction_vpmaddwd_ymm]   = COST(5, 100),
+		[cpuinfo_x86_instruction_aesenc_xmm]     = COST(7, 100),
+		[cpuinfo_x86_instruction_pclmulqdq_xmm]  = COST(5, 100),
+		[cpuinfo_x86_instruction_vdivps_ymm]     = COST(17, 1000),
+	},
+	/* Also Kaby Lake */
+	[cost_table_sky_lake] = {
+		[cpuinfo_x86_instruction_popcnt_r64]     = COST(3, 100),
+		[cpuinfo_x86_instruction_lzcnt_r64]      = COST(3, 100),
+		[cpuinfo_x86_instruction_tzcnt_r64]      = COST(3, 100),
+		[cpuinfo_x86_instruction_pdep_r64]       = COST(3, 100),
+		[cpuinfo_x86_instruction_pext_r64]       = COST(3, 100),
+		[cpuinfo_x86_instruction_imul_r64]       = COST(3, 100),
+		[cpuinfo_x86_instruction_mulx_r64]       = COST(4, 100),
+		[cpuinfo_x86_instruction_adcx_r64]       = COST(1, 100),
+		[cpuinfo_x86_instruction_crc32_r64]      = COST(3, 100),
+		[cpuinfo_x86_instruction_pshufb_xmm]     = COST(1, 100),
+		[cpuinfo_x86_instruction_vpshufb_ymm]    = COST(1, 100),
+		[cpuinfo_x86_instruction_vpermd_ymm]     = COST(3, 100),
+		[cpuinfo_x86_instruction_vpermps_ymm]    = COST(3, 100),
+		[cpuinfo_x86_instruction_vpgatherdd_ymm] = COST(0, 400),
+		[cpuinfo_x86_instruction_vfmadd_ps_ymm]  = COST(4, 50),
+		[cpuinfo_x86_instruction_vpmaddubsw_ymm] = COST(5, 50),
+		[cpuinfo_x86_instruction_vpmaddwd_ymm]   = COST(5, 50),
+		[cpuinfo_x86_instruction_aesenc_xmm]     = COST(4, 100),
+		[cpuinfo_x86_instruction_pclmulqdq_xmm]  = COST(7, 100),
+		[cpuinfo_x86_instruction_vdivps_ymm]     = COST(11, 500),
+	},
+	/* Xeon Scalable processors with two 512-bit FMA units */
+	[cost_table_sky_lake_server] = {
+		[cpuinfo_x86_instruction_popcnt_r64]     = COST(3, 100),
+		[cpuinfo_x86_instruction_lzcnt_r64]      = COST(3, 100),
+		[cpuinfo_x86_instruction_tzcnt_r64]      = COST(3, 100),
+		[cpuinfo_x86_instruction_pdep_r64]       = COST(3, 100),
+		[cpuinfo_x86_instruction_pext_r64]       = COST(3, 100),
+		[cpuinfo_x86_instruction_imul_r64]       = COST(3, 100),
+		[cpuinfo_x86_instruction_mulx_r64]       = COST(4, 100),
+		[cpuinfo_x86_instruction_adcx_r64]       = COST(1, 100),
+		[cpuinfo_x86_instruction_crc32_r64]      = COST(3, 100),
+		[cpuinfo_x86_instruction_pshufb_xmm]     = COST(1, 100),
+		[cpuinfo_x86_instruction_vpshufb_ymm]    = COST(1, 100),
+		[cpuinfo_x86_instruction_vpermd_ymm]     = COST(3, 100),
+		[cpuinfo_x86_instruction_vpermps_ymm]    = COST(3, 100),
+		[cpuinfo_x86_instruction_vpgatherdd_ymm] = COST(0, 400),
+		[cpuinfo_x86_instruction_vfmadd_ps_ymm]  = COST(4, 50),
+		[cpuinfo_x86_instruction_vfmadd_ps_zmm]  = COST(4, 50),
+		[cpuinfo_x86_instruction_vpmaddubsw_ymm] = COST(5, 50),
+		[cpuinfo_x86_instruction_vpmaddwd_ymm]   = COST(5, 50),
+		[cpuinfo_x86_instruction_aesenc_xmm]     = COST(4, 100),
+		[cpuinfo_x86_instruction_pclmulqdq_xmm]  = COST(7, 100),
+		[cpuinfo_x86_instruction_vdivps_ymm]     = COST(11, 500),
+	},
+	/* Zen, Zen+, and Zen 2. 256-bit operations are split into two 128-bit halves */
+	[cost_table_zen] = {
+		[cpuinfo_x86_instruction_popcnt_r64]     = COST(1, 25),
+		[cpuinfo_x86_instruction_lzcnt_r64]      = COST(1, 25),
+		[cpuinfo_x86_instruction_tzcnt_r64]      = COST(2, 50),
+		[cpuinfo_x86_instruction_pdep_r64]       = MICROCODED(18, 1800),
+		[cpuinfo_x86_instruction_pext_r64]       = MICROCODED(18, 1800),
+		[cpuinfo_x86_instruction_imul_r64]       = COST(3, 100),
+		[cpuinfo_x86_instruction_mulx_r64]       = COST(4, 200),
+		[cpuinfo_x86_instruction_adcx_r64]       = COST(1, 100),
+		[cpuinfo_x86_instruction_crc32_r64]      = COST(3, 300),
+		[cpuinfo_x86_instruction_pshufb_xmm]     = COST(1, 50),
+		[cpuinfo_x86_instruction_vpshufb_ymm]    = COST(1, 100),
+		[cpuinfo_x86_instruction_vpermd_ymm]     = COST(5, 400),
+		[cpuinfo_x86_instruction_vpermps_ymm]    = COST(5, 400),
+		[cpuinfo_x86_instruction_vpgatherdd_ymm] = COST(0, 1300),
+		[cpuinfo_x86_instruction_vfmadd_ps_ymm]  = COST(5, 100),
+		[cpuinfo_x86_instruction_vpmaddubsw_ymm] = COST(4, 100),
+		[cpuinfo_x86_instruction_vpmaddwd_ymm]   = COST(3, 100),
+		[cpuinfo_x86_instruction_aesenc_xmm]     = COST(4, 50),
+		[cpuinfo_x86_instruction_pclmulqdq_xmm]  = COST(4, 200),
+		[cpuinfo_x86_instruction_vdivps_ymm]     = COST(10, 600),
+	},
+	/* PDEP and PEXT are implemented in hardware since Zen 3 */
+	[cost_table_zen3] = {
+		[cpuinfo_x86_instruction_popcnt_r64]     = COST(1, 25),
+		[cpuinfo_x86_instruction_lzcnt_r64]      = COST(1, 25),
+		[cpuinfo_x86_instruction_tzcnt_r64]      = COST(2, 50),
+		[cpuinfo_x86_instruction_pdep_r64]       = COST(3, 100),
+		[cpuinfo_x86_instruction_pext_r64]       = COST(3, 100),
+		[cpuinfo_x86_instruction_imul_r64]       = COST(3, 100),
+		[cpuinfo_x86_instruction_mulx_r64]       = COST(4, 100),
+		[cpuinfo_x86_instruction_adcx_r64]       = COST(1, 100),
+		[cpuinfo_x86_instruction_crc32_r64]      = COST(3, 100),
+		[cpuinfo_x86_instruction_pshufb_xmm]     = COST(1, 50),
+		[cpuinfo_x86_instruction_vpshufb_ymm]    = COST(1, 50),
+		[cpuinfo_x86_instruction_vpermd_ymm]     = COST(4, 100),
+		[cpuinfo_x86_instruction_vpermps_ymm]    = COST(4, 100),
+		[cpuinfo_x86_instruction_vfmadd_ps_ymm]  = COST(4, 50),
+		[cpuinfo_x86_instruction_vpmaddubsw_ymm] = COST(3, 50),
+		[cpuinfo_x86_instruction_vpmaddwd_ymm]   = COST(3, 50),
+		[cpuinfo_x86_instruction_aesenc_xmm]     = COST(4, 50),
+		[cpuinfo_x86_instruction_pclmulqdq_xmm]  = COST(4, 100),
+		[cpuinfo_x86_instruction_vdivps_ymm]     = COST(11, 350),
+	},
+	/* 512-bit operations are split into two 256-bit halves */
+	[cost_table_zen4] = {
+		[cpuinfo_x86_instruction_popcnt_r64]     = COST(1, 25),
+		[cpuinfo_x86_instruction_lzcnt_r64]      = COST(1, 25),
+		[cpuinfo_x86_instruction_tzcnt_r64]      = COST(2, 50),
+		[cpuinfo_x86_instruction_pdep_r64]       = COST(3, 100),
+		[cpuinfo_x86_instruction_pext_r64]       = COST(3, 100),
+		[cpuinfo_x86_instruction_imul_r64]       = COST(3, 100),
+		[cpuinfo_x86_instruction_mulx_r64]       = COST(4, 100),
+		[cpuinfo_x86_instruction_adcx_r64]       = COST(1, 100),
+		[cpuinfo_x86_instruction_crc32_r64]      = COST(3, 100),
+		[cpuinfo_x86_instruction_pshufb_xmm]     = COST(1, 50),
+		[cpuinfo_x86_instruction_vpshufb_ymm]    = COST(1, 50),
+		[cpuinfo_x86_instruction_vpermd_ymm]     = COST(4, 100),
+		[cpuinfo_x86_instruction_vpermps_ymm]    = COST(4, 100),
+		[cpuinfo_x86_instruction_vpermb_zmm]     = COST(6, 100),
+		[cpuinfo_x86_instruction_vfmadd_ps_ymm]  = COST(4, 50),
+		[cpuinfo_x86_instruction_vfmadd_ps_zmm]  = COST(4, 100),
+		[cpuinfo_x86_instruction_vpmaddubsw_ymm] = COST(3, 50),
+		[cpuinfo_x86_instruction_vpmaddwd_ymm]   = COST(3, 50),
+		[cpuinfo_x86_instruction_aesenc_xmm]     = COST(4, 50),
+		[cpuinfo_x86_instruction_pclmulqdq_xmm]  = COST(4, 100),
+		[cpuinfo_x86_instruction_vdivps_ymm]     = COST(11, 500),
+	},
+};
+
+struct cpuinfo_x86_instruction_cost CPUINFO_ABI cpuinfo_get_x86_instruction_cost(
+	enum cpuinfo_uarch uarch, enum cpuinfo_x86_instruction instruction)
+{
+	const struct cpuinfo_x86_instruction_cost unknown = { 0 };
+	if ((uint32_t) instruction >= (uint32_t) cpuinfo_x86_instruction_count) {
+		return unknown;
+	}
+
+	enum cost_table table;
+	switch (uarch) {
+		case cpuinfo_uarch_haswell:
+			table = cost_table_haswell;
+			break;
+		case cpuinfo_uarch_broadwell:
+			table = cost_table_broadwell;
+			break;
+		case cpuinfo_uarch_sky_lake:
+		case cpuinfo_uarch_kaby_lake:
+			table = cost_table_sky_lake;
+			break;
+		case cpuinfo_uarch_sky_lake_server:
+			table = cost_table_sky_lake_server;
+			break;
+		case cpuinfo_uarch_zen:
+			table = cost_table_zen;
+			break;
+		case cpuinfo_uarch_zen3:
+			table = cost_table_zen3;
+			break;
+		case cpuinfo_uarch_zen4:
+			table = cost_table_zen4;
+			break;
+		default:
+			return unknown;
+	}
+	return cost_tables[table][instruction];
+}
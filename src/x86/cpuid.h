@@ -1,4 +1,5 @@
 #pragma once
+#include <stdbool.h>
 #include <stdint.h>
 
 #if defined(__GNUC__)
@@ -10,46 +11,69 @@
 #include <x86/api.h>
 
 
-#if defined(__GNUC__) || defined(_MSC_VER)
+#if CPUINFO_MOCK
+	struct cpuid_regs cpuinfo_mock_cpuidex(uint32_t eax, uint32_t ecx, bool match_ecx);
+	extern uint64_t cpuinfo_mock_xcr0;
+
+	/*
+	 * Makes subsequent CPUID read the dump of the Linux processor, or the common dump if it has none.
+	 * Returns false if the processor has no dump of its own, and the thread must be pinned to it instead.
+	 */
+	bool cpuinfo_mock_select_processor(int linux_id);
+
 	static inline struct cpuid_regs cpuid(uint32_t eax) {
-		struct cpuid_regs regs;
-		#if defined(__GNUC__)
-			__cpuid(eax, regs.eax, regs.ebx, regs.ecx, regs.edx);
-		#else
-			int regs_array[4];
-			__cpuid(regs_array, (int) eax);
-			regs.eax = regs_array[0];
-			regs.ebx = regs_array[1];
-			regs.ecx = regs_array[2];
-			regs.edx = regs_array[3];
-		#endif
-		return regs;
+		return cpuinfo_mock_cpuidex(eax, 0, false);
 	}
 
 	static inline struct cpuid_regs cpuidex(uint32_t eax, uint32_t ecx) {
-		struct cpuid_regs regs;
-		#if defined(__GNUC__)
-			__cpuid_count(eax, ecx, regs.eax, regs.ebx, regs.ecx, regs.edx);
-		#else
-			int regs_array[4];
-			__cpuidex(regs_array, (int) eax, (int) ecx);
-			regs.eax = regs_array[0];
-			regs.ebx = regs_array[1];
-			regs.ecx = regs_array[2];
-			regs.edx = regs_array[3];
-		#endif
-		return regs;
+		return cpuinfo_mock_cpuidex(eax, ecx, true);
 	}
-#endif
 
-/*
- * This instruction may be not supported by Native Client validator,
- * make sure it doesn't appear in the binary
- */
-#ifndef __native_client__
 	static inline uint64_t xgetbv(uint32_t ext_ctrl_reg) {
-		uint32_t lo, hi;
-		asm(".byte 0x0F, 0x01, 0xD0" : "=a" (lo), "=d" (hi) : "c" (ext_ctrl_reg));
-		return ((uint64_t) hi << 32) | (uint64_t) lo;
+		return ext_ctrl_reg == 0 ? cpuinfo_mock_xcr0 : 0;
 	}
+#else
+	#if defined(__GNUC__) || defined(_MSC_VER)
+		static inline struct cpuid_regs cpuid(uint32_t eax) {
+			struct cpuid_regs regs;
+			#if defined(__GNUC__)
+				__cpuid(eax, regs.eax, regs.ebx, regs.ecx, regs.edx);
+			#else
+				int regs_array[4];
+				__cpuid(regs_array, (int) eax);
+				regs.eax = regs_array[0];
+				regs.ebx = regs_array[1];
+				regs.ecx = regs_array[2];
+				regs.edx = regs_array[3];
+			#endif
+			return regs;
+		}
+
+		static inline struct cpuid_regs cpuidex(uint32_t eax, uint32_t ecx) {
+			struct cpuid_regs regs;
+			#if defined(__GNUC__)
+				__cpuid_count(eax, ecx, regs.eax, regs.ebx, regs.ecx, regs.edx);
+			#else
+				int regs_array[4];
+				__cpuidex(regs_array, (int) eax, (int) ecx);
+				regs.eax = regs_array[0];
+				regs.ebx = regs_array[1];
+				regs.ecx = regs_array[2];
+				regs.edx = regs_array[3];
+			#endif
+			return regs;
+		}
+	#endif
+
+	/*
+	 * This instruction may be not supported by Native Client validator,
+	 * make sure it doesn't appear in the binary
+	 */
+	#ifndef __native_client__
+		static inline uint64_t xgetbv(uint32_t ext_ctrl_reg) {
+			uint32_t lo, hi;
+			asm(".byte 0x0F, 0x01, 0xD0" : "=a" (lo), "=d" (hi) : "c" (ext_ctrl_reg));
+			return ((uint64_t) hi << 32) | (uint64_t) lo;
+		}
+	#endif
 #endif
@@ -0,0 +1,110 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <cpuinfo.h>
+#include <x86/cpuid.h>
+#include <x86/api.h>
+#include <log.h>
+
+
+/*
+ * Hypervisors report a 12-character signature in ebx, ecx, and edx of the first leaf of their CPUID range.
+ * The range starts at 0x40000000, and hypervisors which also emulate Hyper-V interfaces (KVM and Xen)
+ * move their own leaves to one of the next ranges in increments of 0x100.
+ */
+#define HYPERVISOR_BASE_FIRST UINT32_C(0x40000000)
+#define HYPERVISOR_BASE_LAST  UINT32_C(0x40010000)
+#define HYPERVISOR_BASE_STEP  UINT32_C(0x00000100)
+
+/* KVM features, eax of leaf base + 1: KVM_FEATURE_STEAL_TIME */
+#define KVM_FEATURE_STEAL_TIME UINT32_C(0x00000020)
+/* KVM hints, edx of leaf base + 1: KVM_HINTS_REALTIME, i.e. virtual processors are never preempted */
+#define KVM_HINTS_REALTIME     UINT32_C(0x00000001)
+
+static const struct {
+	char signature[12];
+	enum cpuinfo_hypervisor_vendor vendor;
+} signatures[] = {
+	{ { 'K', 'V', 'M', 'K', 'V', 'M', 'K', 'V', 'M', 0, 0, 0 }, cpuinfo_hypervisor_vendor_kvm },
+	{ { 'M', 'i', 'c', 'r', 'o', 's', 'o', 'f', 't', ' ', 'H', 'v' }, cpuinfo_hypervisor_vendor_hyperv },
+	{ { 'X', 'e', 'n', 'V', 'M', 'M', 'X', 'e', 'n', 'V', 'M', 'M' }, cpuinfo_hypervisor_vendor_xen },
+	{ { 'V', 'M', 'w', 'a', 'r', 'e', 'V', 'M', 'w', 'a', 'r', 'e' }, cpuinfo_hypervisor_vendor_vmware },
+	{ { 'V', 'B', 'o', 'x', 'V', 'B', 'o', 'x', 'V', 'B', 'o', 'x' }, cpuinfo_hypervisor_vendor_virtualbox },
+	{ { 'T', 'C', 'G', 'T', 'C', 'G', 'T', 'C', 'G', 'T', 'C', 'G' }, cpuinfo_hypervisor_vendor_qemu },
+	{ { 'b', 'h', 'y', 'v', 'e', ' ', 'b', 'h', 'y', 'v', 'e', ' ' }, cpuinfo_hypervisor_vendor_bhyve },
+	{ { 'A', 'C', 'R', 'N', 'A', 'C', 'R', 'N', 'A', 'C', 'R', 'N' }, cpuinfo_hypervisor_vendor_acrn },
+	{ { ' ', 'l', 'r', 'p', 'e', 'p', 'y', 'h', ' ', ' ', 'v', 'r' }, cpuinfo_hypervisor_vendor_parallels },
+};
+
+static enum cpuinfo_hypervisor_vendor decode_signature(struct cpuid_regs regs) {
+	char signature[12];
+	memcpy(signature, &regs.ebx, 4);
+	memcpy(signature + 4, &regs.ecx, 4);
+	memcpy(signature + 8, &regs.edx, 4);
+	for (size_t i = 0; i < sizeof(signatures) / sizeof(signatures[0]); i++) {
+		if (memcmp(signature, signatures[i].signature, sizeof(signature)) == 0) {
+			return signatures[i].vendor;
+		}
+	}
+	return cpuinfo_hypervisor_vendor_unknown;
+}
+
+struct cpuinfo_hypervisor cpuinfo_x86_detect_hypervisor(struct cpuid_regs leaf1) {
+	struct cpuinfo_hypervisor hypervisor = { .topology_trusted = true };
+
+	/*
+	 * Hypervisor present:
+	 * - Intel, AMD: ecx[bit 31] in basic info.
+	 */
+	if (!(leaf1.ecx & UINT32_C(0x80000000))) {
+		return hypervisor;
+	}
+	hypervisor.topology_trusted = false;
+
+	uint32_t base = HYPERVISOR_BASE_FIRST;
+	const struct cpuid_regs first_info = cpuid(base);
+	hypervisor.vendor = decode_signature(first_info);
+	uint32_t max_index = first_info.eax;
+	if (hypervisor.vendor == cpuinfo_hypervisor_vendor_hyperv) {
+		/* KVM and Xen with Hyper-V emulation report their own signature in one of the next ranges */
+		for (uint32_t next_base = base + HYPERVISOR_BASE_STEP;
+			next_base < HYPERVISOR_BASE_LAST;
+			next_base += HYPERVISOR_BASE_STEP)
+		{
+			const struct cpuid_regs next_info = cpuid(next_base);
+			const enum cpuinfo_hypervisor_vendor next_vendor = decode_signature(next_info);
+			if (next_vendor == cpuinfo_hypervisor_vendor_kvm || next_vendor == cpuinfo_hypervisor_vendor_xen) {
+				hypervisor.vendor = next_vendor;
+				base = next_base;
+				max_index = next_info.eax;
+				break;
+			}
+		}
+	}
+
+	switch (hypervisor.vendor) {
+		case cpuinfo_hypervisor_vendor_kvm:
+			/* KVM may leave the maximum index zero, which implies the features leaf */
+			if (max_index == 0 || max_index >= base + 1) {
+				const struct cpuid_regs features = cpuid(base + 1);
+				hypervisor.steal_time = !!(features.eax & KVM_FEATURE_STEAL_TIME);
+				hypervisor.dedicated_processors = !!(features.edx & KVM_HINTS_REALTIME);
+				/* Each virtual processor stays on its host processor, so the topology of the guest is set up to match */
+				hypervisor.topology_trusted = hypervisor.dedicated_processors;
+			}
+			break;
+		case cpuinfo_hypervisor_vendor_xen:
+			/* Xen always reports the run state of virtual processors, including time runnable but not running */
+			hypervisor.steal_time = true;
+			break;
+		default:
+			break;
+	}
+
+	cpuinfo_log_debug("hypervisor vendor %d at CPUID leaf 0x%08"PRIx32": steal time %s, dedicated processors %s",
+		(int) hypervisor.vendor, base,
+		hypervisor.steal_time ? "yes" : "no",
+		hypervisor.dedicated_processors ? "yes" : "no");
+	return hypervisor;
+}
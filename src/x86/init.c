@@ -1,8 +1,13 @@
 #include <stdint.h>
+#include <stddef.h>
 
+#if CPUINFO_MOCK
+	#include <cpuinfo-mock.h>
+#endif
 #include <cpuinfo.h>
 #include <x86/cpuid.h>
 #include <x86/api.h>
+#include <api.h>
 #include <utils.h>
 #include <log.h>
 
@@ -10,6 +15,82 @@
 struct cpuinfo_x86_isa cpuinfo_isa = { 0 };
 uint32_t cpuinfo_x86_clflush_size = 0;
 
+#if CPUINFO_MOCK
+	/* Maximum number of logical processors with a CPUID dump of their own */
+	#define CPUINFO_MOCK_MAX_PROCESSOR_DUMPS 256
+
+	static const struct cpuinfo_mock_cpuid* cpuinfo_mock_cpuid_dump = NULL;
+	static size_t cpuinfo_mock_cpuid_entries = 0;
+	uint64_t cpuinfo_mock_xcr0 = 0;
+
+	struct cpuinfo_mock_processor_dump {
+		int linux_id;
+		const struct cpuinfo_mock_cpuid* dump;
+		size_t entries;
+	};
+
+	static struct cpuinfo_mock_processor_dump cpuinfo_mock_processor_dumps[CPUINFO_MOCK_MAX_PROCESSOR_DUMPS];
+	static uint32_t cpuinfo_mock_processor_dumps_count = 0;
+	/* Index in cpuinfo_mock_processor_dumps of the processor which executes CPUID, or UINT32_MAX */
+	static uint32_t cpuinfo_mock_current_dump = UINT32_MAX;
+
+	void CPUINFO_ABI cpuinfo_set_cpuid(const struct cpuinfo_mock_cpuid* dump, size_t entries) {
+		cpuinfo_mock_cpuid_dump = dump;
+		cpuinfo_mock_cpuid_entries = entries;
+	}
+
+	void CPUINFO_ABI cpuinfo_set_processor_cpuid(int linux_id, const struct cpuinfo_mock_cpuid* dump, size_t entries) {
+		for (uint32_t i = 0; i < cpuinfo_mock_processor_dumps_count; i++) {
+			if (cpuinfo_mock_processor_dumps[i].linux_id == linux_id) {
+				cpuinfo_mock_processor_dumps[i].dump = dump;
+				cpuinfo_mock_processor_dumps[i].entries = entries;
+				return;
+			}
+		}
+		if (cpuinfo_mock_processor_dumps_count < CPUINFO_MOCK_MAX_PROCESSOR_DUMPS) {
+			cpuinfo_mock_processor_dumps[cpuinfo_mock_processor_dumps_count++] =
+				(struct cpuinfo_mock_processor_dump) { linux_id, dump, entries };
+		}
+	}
+
+	bool cpuinfo_mock_select_processor(int linux_id) {
+		cpuinfo_mock_current_dump = UINT32_MAX;
+		for (uint32_t i = 0; i < cpuinfo_mock_processor_dumps_count; i++) {
+			if (cpuinfo_mock_processor_dumps[i].linux_id == linux_id) {
+				cpuinfo_mock_current_dump = i;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void CPUINFO_ABI cpuinfo_set_xcr0(uint64_t xcr0) {
+		cpuinfo_mock_xcr0 = xcr0;
+	}
+
+	/* Leaves and sub-leaves missing from the dump read as zeroes, as reserved leaves do on real hardware */
+	struct cpuid_regs cpuinfo_mock_cpuidex(uint32_t eax, uint32_t ecx, bool match_ecx) {
+		const struct cpuinfo_mock_cpuid* dump = cpuinfo_mock_cpuid_dump;
+		size_t entries = cpuinfo_mock_cpuid_entries;
+		if (cpuinfo_mock_current_dump != UINT32_MAX) {
+			dump = cpuinfo_mock_processor_dumps[cpuinfo_mock_current_dump].dump;
+			entries = cpuinfo_mock_processor_dumps[cpuinfo_mock_current_dump].entries;
+		}
+		for (size_t i = 0; i < entries; i++) {
+			const struct cpuinfo_mock_cpuid* entry = &dump[i];
+			if (entry->input_eax == eax && (!match_ecx || entry->input_ecx == ecx)) {
+				return (struct cpuid_regs) {
+					.eax = entry->eax,
+					.ebx = entry->ebx,
+					.ecx = entry->ecx,
+					.edx = entry->edx,
+				};
+			}
+		}
+		return (struct cpuid_regs) { 0, 0, 0, 0 };
+	}
+#endif
+
 void cpuinfo_x86_init_processor(struct cpuinfo_x86_processor processor[restrict static 1]) {
 	const struct cpuid_regs leaf0 = cpuid(0);
 	const uint32_t max_base_index = leaf0.eax;
@@ -26,8 +107,32 @@ void cpuinfo_x86_init_processor(struct cpuinfo_x86_processor processor[restrict
 	if (max_base_index >= 1) {
 		const struct cpuid_regs leaf1 = cpuid(1);
 		const struct cpuinfo_x86_model_info model_info = cpuinfo_x86_decode_model_info(leaf1.eax);
-		const enum cpuinfo_uarch uarch = processor->uarch =
-			cpuinfo_x86_decode_uarch(vendor, &model_info);
+		enum cpuinfo_uarch uarch = cpuinfo_x86_decode_uarch(vendor, &model_info);
+
+		/*
+		 * Hybrid processor support:
+		 * - Intel: edx[bit 15] in structured feature info. Type and native model ID of the core
+		 *   which executes CPUID are reported in leaf 0x1A.
+		 */
+		const struct cpuid_regs leaf7 = max_base_index >= 7 ?
+			cpuidex(7, 0) : (struct cpuid_regs) { 0, 0, 0, 0 };
+		if (max_base_index >= UINT32_C(0x1A) && (leaf7.edx & UINT32_C(0x00008000))) {
+			const struct cpuid_regs leaf0x1A = cpuidex(UINT32_C(0x1A), 0);
+			switch (leaf0x1A.eax >> 24) {
+				case 0x20: // Intel Atom
+					processor->core_type = cpuinfo_core_type_efficiency;
+					break;
+				case 0x40: // Intel Core
+					processor->core_type = cpuinfo_core_type_performance;
+					break;
+				default:
+					cpuinfo_log_warning("unknown hybrid core type 0x%02"PRIx32, leaf0x1A.eax >> 24);
+					break;
+			}
+			processor->native_model_id = leaf0x1A.eax & UINT32_C(0x00FFFFFF);
+			uarch = cpuinfo_x86_decode_hybrid_uarch(uarch, processor->core_type);
+		}
+		processor->uarch = uarch;
 
 		const uint32_t brand_index = leaf1.ebx & UINT32_C(0x000000FF);
 		cpuinfo_x86_clflush_size = ((leaf1.ebx >> 8) & UINT32_C(0x000000FF)) * 8;
@@ -66,3 +171,32 @@ void cpuinfo_x86_init_processor(struct cpuinfo_x86_processor processor[restrict
 		#endif
 	}
 }
+
+void cpuinfo_x86_detect_platform(struct cpuinfo_tables* tables) {
+	tables->isa = cpuinfo_isa;
+	/* Physical hardware, unless CPUID reports a hypervisor */
+	tables->hypervisor = (struct cpuinfo_hypervisor) { .topology_trusted = true };
+
+	const struct cpuid_regs leaf0 = cpuid(0);
+	const uint32_t max_base_index = leaf0.eax;
+
+	const struct cpuid_regs leaf0x80000000 = cpuid(UINT32_C(0x80000000));
+	const uint32_t max_extended_index =
+		leaf0x80000000.eax >= UINT32_C(0x80000000) ? leaf0x80000000.eax : 0;
+
+	if (max_base_index >= 1) {
+		const struct cpuid_regs leaf1 = cpuid(1);
+		const struct cpuinfo_x86_model_info model_info = cpuinfo_x86_decode_model_info(leaf1.eax);
+
+		tables->hypervisor = cpuinfo_x86_detect_hypervisor(leaf1);
+		tables->qos = cpuinfo_x86_detect_qos(max_base_index, max_extended_index);
+		tables->tsc = cpuinfo_x86_detect_tsc(max_base_index, max_extended_index, leaf1, &model_info);
+		if (tables->isa.amx_tile) {
+			tables->amx = cpuinfo_x86_detect_amx(max_base_index);
+		}
+		cpuinfo_x86_detect_xsave(max_base_index, leaf1, &tables->xsave, tables->xsave_components);
+	}
+
+	/* Calibrate TSC only if its frequency is not reported by CPUID */
+	cpuinfo_x86_init_tsc(tables);
+}
@@ -35,12 +35,20 @@ struct cpuinfo_x86_isa cpuinfo_x86_detect_isa(
 	const struct cpuid_regs structured_feature_info =
 		(max_base_index >= 7) ? cpuidex(7, 0) : (struct cpuid_regs) { 0, 0, 0, 0};
 
+	/*
+	 * Sub-leaf 1 of structured feature info:
+	 * - Intel, AMD: eax in sub-leaf 0 of structured feature info = maximum supported sub-leaf.
+	 */
+	const struct cpuid_regs structured_feature_info1 =
+		(max_base_index >= 7 && structured_feature_info.eax >= 1) ?
+			cpuidex(7, 1) : (struct cpuid_regs) { 0, 0, 0, 0 };
+
 	const uint32_t processor_capacity_info_index = UINT32_C(0x80000008);
 	const struct cpuid_regs processor_capacity_info =
 		(max_extended_index >= processor_capacity_info_index) ?
 			cpuid(processor_capacity_info_index) : (struct cpuid_regs) { 0, 0, 0, 0 };
 
-	bool avx_regs = false, avx512_regs = false, mpx_regs = false;
+	bool avx_regs = false, avx512_regs = false, mpx_regs = false, amx_regs = false;
 	/*
 	 * OSXSAVE: Operating system enabled XSAVE instructions for application use:
 	 * - Intel, AMD: ecx[bit 26] in basic info = XSAVE/XRSTOR instructions supported by a chip.
@@ -88,6 +96,16 @@ struct cpuinfo_x86_isa cpuinfo_x86_detect_isa(
 		if ((xcr0_valid_bits & mpx_regs_mask) == mpx_regs_mask) {
 			mpx_regs = (xfeature_enabled_mask & mpx_regs_mask) == mpx_regs_mask;
 		}
+
+		/*
+		 * AMX registers:
+		 * - Intel: XFEATURE_ENABLED_MASK[bit 17] for tile configuration (TILECFG)
+		 * - Intel: XFEATURE_ENABLED_MASK[bit 18] for tile data (TILEDATA)
+		 */
+		const uint64_t amx_regs_mask = UINT64_C(0x0000000000060000);
+		if ((xcr0_valid_bits & amx_regs_mask) == amx_regs_mask) {
+			amx_regs = (xfeature_enabled_mask & amx_regs_mask) == amx_regs_mask;
+		}
 	}
 
 #if CPUINFO_ARCH_X86
@@ -448,6 +466,57 @@ struct cpuinfo_x86_isa cpuinfo_x86_detect_isa(
 	 */
 	isa.avx512_4fmaps = avx512_regs && !!(structured_feature_info.edx & UINT32_C(0x00000008));
 
+	/*
+	 * AVX512_VBMI2 instructions:
+	 * - Intel, AMD: ecx[bit 6] in structured feature info.
+	 */
+	isa.avx512vbmi2 = avx512_regs && !!(structured_feature_info.ecx & UINT32_C(0x00000040));
+
+	/*
+	 * AVX512_BITALG instructions:
+	 * - Intel, AMD: ecx[bit 12] in structured feature info.
+	 */
+	isa.avx512bitalg = avx512_regs && !!(structured_feature_info.ecx & UINT32_C(0x00001000));
+
+	/*
+	 * AVX512_VNNI instructions:
+	 * - Intel, AMD: ecx[bit 11] in structured feature info.
+	 */
+	isa.avx512vnni = avx512_regs && !!(structured_feature_info.ecx & UINT32_C(0x00000800));
+
+	/*
+	 * AVX512_BF16 instructions:
+	 * - Intel, AMD: eax[bit 5] in sub-leaf 1 of structured feature info.
+	 */
+	isa.avx512bf16 = avx512_regs && !!(structured_feature_info1.eax & UINT32_C(0x00000020));
+
+	/*
+	 * AVX-VNNI instructions (VEX-encoded VNNI):
+	 * - Intel, AMD: eax[bit 4] in sub-leaf 1 of structured feature info.
+	 */
+	isa.avx_vnni = avx_regs && !!(structured_feature_info1.eax & UINT32_C(0x00000010));
+
+#if CPUINFO_ARCH_X86_64
+	/*
+	 * AMX-TILE instructions:
+	 * - Intel: edx[bit 24] in structured feature info.
+	 * AMX instructions are valid only in 64-bit mode.
+	 */
+	isa.amx_tile = amx_regs && !!(structured_feature_info.edx & UINT32_C(0x01000000));
+
+	/*
+	 * AMX-INT8 instructions:
+	 * - Intel: edx[bit 25] in structured feature info.
+	 */
+	isa.amx_int8 = amx_regs && !!(structured_feature_info.edx & UINT32_C(0x02000000));
+
+	/*
+	 * AMX-BF16 instructions:
+	 * - Intel: edx[bit 22] in structured feature info.
+	 */
+	isa.amx_bf16 = amx_regs && !!(structured_feature_info.edx & UINT32_C(0x00400000));
+#endif
+
 	/*
 	 * HLE instructions:
 	 * - Intel: ebx[bit 4] in structured feature info.
@@ -569,6 +638,27 @@ struct cpuinfo_x86_isa cpuinfo_x86_detect_isa(
 	 */
 	isa.pclmulqdq = !!(basic_info.ecx & UINT32_C(0x00000002));
 
+	/*
+	 * GFNI instructions:
+	 * - Intel, AMD: ecx[bit 8] in structured feature info.
+	 * Only the legacy SSE encoding is implied; VEX and EVEX encodings additionally need AVX and AVX512F.
+	 */
+	isa.gfni = !!(structured_feature_info.ecx & UINT32_C(0x00000100));
+
+	/*
+	 * VAES instructions:
+	 * - Intel, AMD: ecx[bit 9] in structured feature info.
+	 * VAES instructions have only VEX and EVEX encodings, and require OS support for ymm registers.
+	 */
+	isa.vaes = avx_regs && !!(structured_feature_info.ecx & UINT32_C(0x00000200));
+
+	/*
+	 * VPCLMULQDQ instruction:
+	 * - Intel, AMD: ecx[bit 10] in structured feature info.
+	 * VPCLMULQDQ instruction has only VEX and EVEX encodings, and requires OS support for ymm registers.
+	 */
+	isa.vpclmulqdq = avx_regs && !!(structured_feature_info.ecx & UINT32_C(0x00000400));
+
 	/*
 	 * RDRAND instruction:
 	 * - Intel: ecx[bit 30] in basic info (reserved bit on AMD CPUs).
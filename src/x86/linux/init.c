@@ -8,6 +8,9 @@
 
 #include <cpuinfo.h>
 #include <x86/api.h>
+#if CPUINFO_MOCK
+	#include <x86/cpuid.h>
+#endif
 #include <linux/api.h>
 #include <api.h>
 #include <log.h>
@@ -46,6 +49,8 @@ static void cpuinfo_x86_count_caches(
 	uint32_t last_l2_id = UINT32_MAX, last_l3_id = UINT32_MAX, last_l4_id = UINT32_MAX;
 	for (uint32_t i = 0; i < processors_count; i++) {
 		const uint32_t apic_id = processors[i].topology.apic_id;
+		/* On hybrid processors L2 caches are private to a core type, even if APIC IDs of the cores are adjacent */
+		const bool core_type_changed = i != 0 && processors[i].core_type != processors[i - 1].core_type;
 		if (processors[i].cache.l1i.size != 0) {
 			const uint32_t l1i_id = apic_id & ~bit_mask(processors[i].cache.l1i.apic_bits);
 			if (l1i_id != last_l1i_id) {
@@ -62,7 +67,7 @@ static void cpuinfo_x86_count_caches(
 		}
 		if (processors[i].cache.l2.size != 0) {
 			const uint32_t l2_id = apic_id & ~bit_mask(processors[i].cache.l2.apic_bits);
-			if (l2_id != last_l2_id) {
+			if (l2_id != last_l2_id || core_type_changed) {
 				last_l2_id = l2_id;
 				l2_count++;
 			}
@@ -91,12 +96,7 @@ static void cpuinfo_x86_count_caches(
 
 void cpuinfo_x86_linux_init(void) {
 	struct cpuinfo_x86_processor* x86_processors = NULL;
-	struct cpuinfo_processor* processors = NULL;
-	struct cpuinfo_cache* l1i = NULL;
-	struct cpuinfo_cache* l1d = NULL;
-	struct cpuinfo_cache* l2 = NULL;
-	struct cpuinfo_cache* l3 = NULL;
-	struct cpuinfo_cache* l4 = NULL;
+	struct cpuinfo_arena arena = { 0 };
 
 	cpu_set_t old_affinity;
 	if (sched_getaffinity(0, sizeof(cpu_set_t), &old_affinity) != 0) {
@@ -105,54 +105,123 @@ void cpuinfo_x86_linux_init(void) {
 	}
 
 	cpu_set_t present_set;
-	cpuinfo_linux_parse_cpuset("/sys/devices/system/cpu/present", &present_set);
+	cpuinfo_linux_read_cpulist_at(cpuinfo_linux_sysfs_dir(), "present", &present_set);
 
 	cpu_set_t possible_set;
-	cpuinfo_linux_parse_cpuset("/sys/devices/system/cpu/possible", &possible_set);
+	cpuinfo_linux_read_cpulist_at(cpuinfo_linux_sysfs_dir(), "possible", &possible_set);
 
 	cpu_set_t processors_set;
 	CPU_AND(&processors_set, &present_set, &possible_set);
-	const uint32_t processors_count = (uint32_t) CPU_COUNT(&processors_set);
-	cpuinfo_log_debug("detected %"PRIu32" logical processors", processors_count);
 
-	x86_processors = calloc(processors_count, sizeof(struct cpuinfo_x86_processor));
+	/* CPUID is executed on every processor, and offline processors can not run threads */
+	cpu_set_t online_set;
+	const bool online_set_valid = cpuinfo_linux_read_cpulist_at(cpuinfo_linux_sysfs_dir(), "online", &online_set);
+	if (online_set_valid) {
+		const uint32_t present_count = (uint32_t) CPU_COUNT(&processors_set);
+		CPU_AND(&processors_set, &processors_set, &online_set);
+		if ((uint32_t) CPU_COUNT(&processors_set) != present_count) {
+			cpuinfo_log_info("ignored %"PRIu32" offline logical processors",
+				present_count - (uint32_t) CPU_COUNT(&processors_set));
+		}
+	}
+
+	/* Threads of the process, including the one which executes CPUID, can run only in the cpuset of its cgroup */
+	cpu_set_t cgroup_set;
+	uint32_t quota_processors = UINT32_MAX;
+	if (cpuinfo_linux_detect_cgroup_limits(&cgroup_set, &quota_processors)) {
+		const uint32_t present_count = (uint32_t) CPU_COUNT(&processors_set);
+		CPU_AND(&processors_set, &processors_set, &cgroup_set);
+		if ((uint32_t) CPU_COUNT(&processors_set) != present_count) {
+			cpuinfo_log_info("ignored %"PRIu32" logical processors outside of the cgroup cpuset",
+				present_count - (uint32_t) CPU_COUNT(&processors_set));
+		}
+	}
+	const uint32_t max_processors_count = (uint32_t) CPU_COUNT(&processors_set);
+	cpuinfo_log_debug("detected %"PRIu32" logical processors", max_processors_count);
+
+	x86_processors = calloc(max_processors_count, sizeof(struct cpuinfo_x86_processor));
 	if (x86_processors == NULL) {
-		cpuinfo_log_error("failed to allocate %zu bytes for descriptions of %d x86 logical processors",
-			processors_count * sizeof(struct cpuinfo_x86_processor), processors_count);
+		cpuinfo_log_error("failed to allocate %zu bytes for descriptions of %"PRIu32" x86 logical processors",
+			max_processors_count * sizeof(struct cpuinfo_x86_processor), max_processors_count);
 		goto cleanup;
 	}
 
-	int processor_bit = 0;
-	for (int i = 0; i < processors_count; i++, processor_bit++) {
-		while (!CPU_ISSET(processor_bit, &processors_set)) {
-			processor_bit++;
+	uint32_t processors_count = 0;
+	for (int processor_bit = 0; processor_bit < CPU_SETSIZE; processor_bit++) {
+		if (!CPU_ISSET(processor_bit, &processors_set)) {
+			continue;
 		}
+		bool pin = true;
+		#if CPUINFO_MOCK
+			pin = !cpuinfo_mock_select_processor(processor_bit);
+		#endif
 		cpu_set_t processor_set;
 		CPU_ZERO(&processor_set);
 		CPU_SET(processor_bit, &processor_set);
-		if (sched_setaffinity(0, sizeof(cpu_set_t), &processor_set) != 0) {
-			cpuinfo_log_error("sched_setaffinity for processor %d (bit %d) failed: %s",
-				i, processor_bit, strerror(errno));
-			goto cleanup;
+		if (pin && sched_setaffinity(0, sizeof(cpu_set_t), &processor_set) != 0) {
+			/* E.g. the cpuset changed after it was read, or is restricted by other means than a cgroup */
+			cpuinfo_log_warning("sched_setaffinity for processor %d failed: %s: processor is ignored",
+				processor_bit, strerror(errno));
+			continue;
 		}
 
-		cpuinfo_x86_init_processor(&x86_processors[i]);
-		x86_processors[i].topology.linux_id = processor_bit;
+		cpuinfo_x86_init_processor(&x86_processors[processors_count]);
+		x86_processors[processors_count].topology.linux_id = processor_bit;
+		processors_count++;
+	}
+	if (processors_count == 0) {
+		cpuinfo_log_error("failed to run CPUID on any of %"PRIu32" logical processors", max_processors_count);
+		goto cleanup;
 	}
 
 	qsort(x86_processors, (size_t) processors_count, sizeof(struct cpuinfo_x86_processor),
 		cmp_x86_processor_by_apic_id);
 
-	processors = calloc((size_t) processors_count, sizeof(struct cpuinfo_processor));
-	if (processors == NULL) {
-		cpuinfo_log_error("failed to allocate %zu bytes for descriptions of %d logical processors",
-			(size_t) processors_count * sizeof(struct cpuinfo_processor), processors_count);
+	uint32_t l1i_count = 0, l1d_count = 0, l2_count = 0, l3_count = 0, l4_count = 0;
+	cpuinfo_x86_count_caches(x86_processors, processors_count,
+		&l1i_count, &l1d_count, &l2_count, &l3_count, &l4_count);
+
+	cpuinfo_log_info("detected %"PRIu32" L1I caches", l1i_count);
+	cpuinfo_log_info("detected %"PRIu32" L1D caches", l1d_count);
+	cpuinfo_log_info("detected %"PRIu32" L2 caches", l2_count);
+	cpuinfo_log_info("detected %"PRIu32" L3 caches", l3_count);
+	cpuinfo_log_info("detected %"PRIu32" L4 caches", l4_count);
+
+	/* Frequency domains are detected after allocation; reserve one per processor at most */
+	const size_t tables_offset = cpuinfo_arena_reserve(&arena, 1, sizeof(struct cpuinfo_tables));
+	const size_t processors_offset =
+		cpuinfo_arena_reserve(&arena, processors_count, sizeof(struct cpuinfo_processor));
+	const size_t l1i_offset = cpuinfo_arena_reserve(&arena, l1i_count, sizeof(struct cpuinfo_cache));
+	const size_t l1d_offset = cpuinfo_arena_reserve(&arena, l1d_count, sizeof(struct cpuinfo_cache));
+	const size_t l2_offset  = cpuinfo_arena_reserve(&arena, l2_count, sizeof(struct cpuinfo_cache));
+	const size_t l3_offset  = cpuinfo_arena_reserve(&arena, l3_count, sizeof(struct cpuinfo_cache));
+	const size_t l4_offset  = cpuinfo_arena_reserve(&arena, l4_count, sizeof(struct cpuinfo_cache));
+	const size_t frequency_domains_offset =
+		cpuinfo_arena_reserve(&arena, processors_count, sizeof(struct cpuinfo_frequency_domain));
+	const size_t online_mask_offset = cpuinfo_arena_reserve(&arena, (processors_count + 31) / 32, sizeof(uint32_t));
+	const size_t available_processors_offset = cpuinfo_arena_reserve(&arena, processors_count, sizeof(uint32_t));
+	const size_t isolated_processors_offset = cpuinfo_arena_reserve(&arena, processors_count, sizeof(uint32_t));
+	if (!cpuinfo_arena_allocate(&arena)) {
 		goto cleanup;
 	}
 
+	struct cpuinfo_tables* tables = cpuinfo_arena_table(&arena, tables_offset);
+	struct cpuinfo_processor* processors = cpuinfo_arena_table(&arena, processors_offset);
+	struct cpuinfo_cache* l1i = cpuinfo_arena_table(&arena, l1i_offset);
+	struct cpuinfo_cache* l1d = cpuinfo_arena_table(&arena, l1d_offset);
+	struct cpuinfo_cache* l2  = cpuinfo_arena_table(&arena, l2_offset);
+	struct cpuinfo_cache* l3  = cpuinfo_arena_table(&arena, l3_offset);
+	struct cpuinfo_cache* l4  = cpuinfo_arena_table(&arena, l4_offset);
+	struct cpuinfo_frequency_domain* frequency_domains = cpuinfo_arena_table(&arena, frequency_domains_offset);
+	uint32_t* online_mask = cpuinfo_arena_table(&arena, online_mask_offset);
+	uint32_t* available_processors = cpuinfo_arena_table(&arena, available_processors_offset);
+	uint32_t* isolated_processors = cpuinfo_arena_table(&arena, isolated_processors_offset);
+
 	for (uint32_t i = 0; i < (uint32_t) processors_count; i++) {
 		processors[i].vendor = x86_processors[i].vendor;
 		processors[i].uarch  = x86_processors[i].uarch;
+		processors[i].core_type = x86_processors[i].core_type;
+		processors[i].native_model_id = x86_processors[i].native_model_id;
 
 		/* Initialize topology information */
 		const uint32_t apic_id = x86_processors[i].topology.apic_id;
@@ -170,65 +239,15 @@ void cpuinfo_x86_linux_init(void) {
 		};
 	}
 
-	uint32_t l1i_count = 0, l1d_count = 0, l2_count = 0, l3_count = 0, l4_count = 0;
-	cpuinfo_x86_count_caches(x86_processors, processors_count,
-		&l1i_count, &l1d_count, &l2_count, &l3_count, &l4_count);
-
-	cpuinfo_log_info("detected %"PRIu32" L1I caches", l1i_count);
-	cpuinfo_log_info("detected %"PRIu32" L1D caches", l1d_count);
-	cpuinfo_log_info("detected %"PRIu32" L2 caches", l2_count);
-	cpuinfo_log_info("detected %"PRIu32" L3 caches", l3_count);
-	cpuinfo_log_info("detected %"PRIu32" L4 caches", l4_count);
-
-	if (l1i_count != 0) {
-		l1i = calloc(l1i_count, sizeof(struct cpuinfo_cache));
-		if (l1i == NULL) {
-			cpuinfo_log_error("failed to allocate %zu bytes for descriptions of %"PRIu32" L1I caches",
-				l1i_count * sizeof(struct cpuinfo_cache), l1i_count);
-			goto cleanup;
-		}
-	}
-	if (l1d_count != 0) {
-		l1d = calloc(l1d_count, sizeof(struct cpuinfo_cache));
-		if (l1d == NULL) {
-			cpuinfo_log_error("failed to allocate %zu bytes for descriptions of %"PRIu32" L1D caches",
-				l1d_count * sizeof(struct cpuinfo_cache), l1d_count);
-			goto cleanup;
-		}
-	}
-	if (l2_count != 0) {
-		l2 = calloc(l2_count, sizeof(struct cpuinfo_cache));
-		if (l2 == NULL) {
-			cpuinfo_log_error("failed to allocate %zu bytes for descriptions of %"PRIu32" L2 caches",
-				l2_count * sizeof(struct cpuinfo_cache), l2_count);
-			goto cleanup;
-		}
-	}
-	if (l3_count != 0) {
-		l3 = calloc(l3_count, sizeof(struct cpuinfo_cache));
-		if (l3 == NULL) {
-			cpuinfo_log_error("failed to allocate %zu bytes for descriptions of %"PRIu32" L3 caches",
-				l3_count * sizeof(struct cpuinfo_cache), l3_count);
-			goto cleanup;
-		}
-	}
-	if (l4_count != 0) {
-		l4 = calloc(l4_count, sizeof(struct cpuinfo_cache));
-		if (l4 == NULL) {
-			cpuinfo_log_error("failed to allocate %zu bytes for descriptions of %"PRIu32" L4 caches",
-				l4_count * sizeof(struct cpuinfo_cache), l4_count);
-			goto cleanup;
-		}
-	}
-
 	uint32_t l1i_index = 0, l1d_index = 0, l2_index = 0, l3_index = 0, l4_index = 0;
 	uint32_t last_l1i_id = UINT32_MAX, last_l1d_id = UINT32_MAX;
 	uint32_t last_l2_id = UINT32_MAX, last_l3_id = UINT32_MAX, last_l4_id = UINT32_MAX;
 	for (uint32_t i = 0; i < processors_count; i++) {
 		const uint32_t apic_id = processors[i].topology.apic_id;
+		/* On hybrid processors L2 caches are private to a core type, e.g. a module L2 of four efficiency cores */
+		const bool core_type_changed = i != 0 && processors[i].core_type != processors[i - 1].core_type;
 		if (x86_processors[i].cache.l1i.size != 0) {
 			const uint32_t l1i_id = apic_id & ~bit_mask(x86_processors[i].cache.l1i.apic_bits);
-			processors[i].cache.l1i = &l1i[l1i_index];
 			if (l1i_id != last_l1i_id) {
 				/* new cache */
 				last_l1i_id = l1i_id;
@@ -246,13 +265,13 @@ void cpuinfo_x86_linux_init(void) {
 				/* another processor sharing the same cache */
 				l1i[l1i_index - 1].thread_count += 1;
 			}
+			processors[i].cache.l1i = &l1i[l1i_index - 1];
 		} else {
 			/* reset cache id */
 			last_l1i_id = UINT32_MAX;
 		}
 		if (x86_processors[i].cache.l1d.size != 0) {
 			const uint32_t l1d_id = apic_id & ~bit_mask(x86_processors[i].cache.l1d.apic_bits);
-			processors[i].cache.l1d = &l1d[l1d_index];
 			if (l1d_id != last_l1d_id) {
 				/* new cache */
 				last_l1d_id = l1d_id;
@@ -270,14 +289,14 @@ void cpuinfo_x86_linux_init(void) {
 				/* another processor sharing the same cache */
 				l1d[l1d_index - 1].thread_count += 1;
 			}
+			processors[i].cache.l1d = &l1d[l1d_index - 1];
 		} else {
 			/* reset cache id */
 			last_l1d_id = UINT32_MAX;
 		}
 		if (x86_processors[i].cache.l2.size != 0) {
 			const uint32_t l2_id = apic_id & ~bit_mask(x86_processors[i].cache.l2.apic_bits);
-			processors[i].cache.l2 = &l2[l2_index];
-			if (l2_id != last_l2_id) {
+			if (l2_id != last_l2_id || core_type_changed) {
 				/* new cache */
 				last_l2_id = l2_id;
 				l2[l2_index++] = (struct cpuinfo_cache) {
@@ -294,13 +313,13 @@ void cpuinfo_x86_linux_init(void) {
 				/* another processor sharing the same cache */
 				l2[l2_index - 1].thread_count += 1;
 			}
+			processors[i].cache.l2 = &l2[l2_index - 1];
 		} else {
 			/* reset cache id */
 			last_l2_id = UINT32_MAX;
 		}
 		if (x86_processors[i].cache.l3.size != 0) {
 			const uint32_t l3_id = apic_id & ~bit_mask(x86_processors[i].cache.l3.apic_bits);
-			processors[i].cache.l3 = &l3[l3_index];
 			if (l3_id != last_l3_id) {
 				/* new cache */
 				last_l3_id = l3_id;
@@ -318,13 +337,13 @@ void cpuinfo_x86_linux_init(void) {
 				/* another processor sharing the same cache */
 				l3[l3_index - 1].thread_count += 1;
 			}
+			processors[i].cache.l3 = &l3[l3_index - 1];
 		} else {
 			/* reset cache id */
 			last_l3_id = UINT32_MAX;
 		}
 		if (x86_processors[i].cache.l4.size != 0) {
 			const uint32_t l4_id = apic_id & ~bit_mask(x86_processors[i].cache.l4.apic_bits);
-			processors[i].cache.l4 = &l4[l4_index];
 			if (l4_id != last_l4_id) {
 				/* new cache */
 				last_l4_id = l4_id;
@@ -342,41 +361,62 @@ void cpuinfo_x86_linux_init(void) {
 				/* another processor sharing the same cache */
 				l4[l4_index - 1].thread_count += 1;
 			}
+			processors[i].cache.l4 = &l4[l4_index - 1];
 		} else {
 			/* reset cache id */
 			last_l4_id = UINT32_MAX;
 		}
 	}
 
+	const uint32_t frequency_domains_count =
+		cpuinfo_linux_detect_frequency_domains(processors_count, processors, frequency_domains);
+
+	cpuinfo_x86_detect_platform(tables);
+
+	/* Kernel configuration of resource allocation takes precedence over processor capabilities */
+	cpuinfo_linux_detect_resctrl(&tables->qos);
+
 	/* Commit changes */
-	cpuinfo_processors = processors;
-	cpuinfo_cache[cpuinfo_cache_level_1i] = l1i;
-	cpuinfo_cache[cpuinfo_cache_level_1d] = l1d;
-	cpuinfo_cache[cpuinfo_cache_level_2]  = l2;
-	cpuinfo_cache[cpuinfo_cache_level_3]  = l3;
-	cpuinfo_cache[cpuinfo_cache_level_4]  = l4;
-
-	cpuinfo_processors_count = processors_count;
-	cpuinfo_cache_count[cpuinfo_cache_level_1i] = l1i_count;
-	cpuinfo_cache_count[cpuinfo_cache_level_1d] = l1d_count;
-	cpuinfo_cache_count[cpuinfo_cache_level_2]  = l2_count;
-	cpuinfo_cache_count[cpuinfo_cache_level_3]  = l3_count;
-	cpuinfo_cache_count[cpuinfo_cache_level_4]  = l4_count;
-
-	processors = NULL;
-	l1i = l1d = l2 = l3 = l4 = NULL;
+	tables->arena = arena;
+	tables->processors = processors;
+	tables->cache[cpuinfo_cache_level_1i] = l1i;
+	tables->cache[cpuinfo_cache_level_1d] = l1d;
+	tables->cache[cpuinfo_cache_level_2]  = l2;
+	tables->cache[cpuinfo_cache_level_3]  = l3;
+	tables->cache[cpuinfo_cache_level_4]  = l4;
+	tables->frequency_domains = frequency_domains_count != 0 ? frequency_domains : NULL;
+
+	tables->processors_count = processors_count;
+	tables->cache_count[cpuinfo_cache_level_1i] = l1i_count;
+	tables->cache_count[cpuinfo_cache_level_1d] = l1d_count;
+	tables->cache_count[cpuinfo_cache_level_2]  = l2_count;
+	tables->cache_count[cpuinfo_cache_level_3]  = l3_count;
+	tables->cache_count[cpuinfo_cache_level_4]  = l4_count;
+	tables->frequency_domains_count = frequency_domains_count;
+
+	tables->online_mask = online_mask;
+	cpuinfo_linux_update_online_processors(tables, online_set_valid ? &online_set : NULL);
+
+	cpuinfo_linux_detect_isolation(processors_count, processors);
+
+	/* Affinity of the thread before it was pinned to each processor */
+	tables->available_processors = available_processors;
+	tables->isolated_processors = isolated_processors;
+	cpuinfo_linux_detect_available_processors(tables, &old_affinity);
+
+	cpuinfo_publish_tables(tables);
+	arena = (struct cpuinfo_arena) { 0 };
 
 cleanup:
+	#if CPUINFO_MOCK
+		cpuinfo_mock_select_processor(-1);
+	#endif
 	if (sched_setaffinity(0, sizeof(cpu_set_t), &old_affinity) != 0) {
 		cpuinfo_log_warning("could not restore initial process affinity: "
 			"sched_getaffinity failed: %s", strerror(errno));
 	}
 
 	free(x86_processors);
-	free(processors);
-	free(l1i);
-	free(l1d);
-	free(l2);
-	free(l3);
-	free(l4);
+	cpuinfo_arena_free(&arena);
+	cpuinfo_linux_sysfs_close();
 }
@@ -18,45 +18,10 @@ static inline uint32_t bit_mask(uint32_t bits) {
 
 void cpuinfo_x86_mach_init(void) {
 	struct cpuinfo_mach_topology mach_topology = cpuinfo_mach_detect_topology();
-	struct cpuinfo_processor* processors = calloc(mach_topology.threads, sizeof(struct cpuinfo_processor));
-	if (processors == NULL) {
-		cpuinfo_log_error("failed to allocate %zu bytes for descriptions of %"PRIu32" logical processors",
-			mach_topology.threads * sizeof(struct cpuinfo_processor), mach_topology.threads);
-		return;
-	}
 
 	struct cpuinfo_x86_processor x86_processor;
 	cpuinfo_x86_init_processor(&x86_processor);
 
-	const uint32_t threads_per_core = mach_topology.threads / mach_topology.cores;
-	const uint32_t threads_per_package = mach_topology.threads / mach_topology.packages;
-	for (uint32_t t = 0; t < mach_topology.threads; t++) {
-		processors[t].vendor = x86_processor.vendor;
-		processors[t].uarch = x86_processor.uarch;
-
-		/* Reconstruct APIC IDs from topology components */
-		const uint32_t thread_bits_mask = bit_mask(x86_processor.topology.thread_bits_length);
-		const uint32_t core_bits_mask   = bit_mask(x86_processor.topology.core_bits_length);
-
-		const uint32_t smt_id = t % threads_per_core;
-		const uint32_t core_id = t / threads_per_core;
-		const uint32_t package_id = t / threads_per_package;
-		const uint32_t package_bits_offset = max(
-			x86_processor.topology.thread_bits_offset + x86_processor.topology.thread_bits_length,
-			x86_processor.topology.core_bits_offset + x86_processor.topology.core_bits_length);
-
-		const uint32_t apic_id =
-			((smt_id & thread_bits_mask) << x86_processor.topology.thread_bits_offset) |
-			((core_id & core_bits_mask) << x86_processor.topology.core_bits_offset) |
-			(package_id << package_bits_offset);
-		processors[t].topology = (struct cpuinfo_topology) {
-			.thread_id  = smt_id,
-			.core_id    = core_id,
-			.package_id = package_id
-		};
-		cpuinfo_log_info("reconstructed APIC ID 0x%08"PRIx32" for thread %"PRIu32, apic_id, t);
-	}
-
 	uint32_t threads_per_l1 = 0, l1_count = 0;
 	if (x86_processor.cache.l1i.size != 0 || x86_processor.cache.l1d.size != 0) {
 		threads_per_l1 = mach_topology.threads_per_cache[1];
@@ -121,19 +86,59 @@ void cpuinfo_x86_mach_init(void) {
 		cpuinfo_log_debug("detected %"PRIu32" L4 caches", l4_count);
 	}
 
-	struct cpuinfo_cache* l1i = NULL;
-	struct cpuinfo_cache* l1d = NULL;
-	struct cpuinfo_cache* l2 = NULL;
-	struct cpuinfo_cache* l3 = NULL;
-	struct cpuinfo_cache* l4 = NULL;
+	struct cpuinfo_arena arena = { 0 };
+	const size_t tables_offset = cpuinfo_arena_reserve(&arena, 1, sizeof(struct cpuinfo_tables));
+	const size_t processors_offset =
+		cpuinfo_arena_reserve(&arena, mach_topology.threads, sizeof(struct cpuinfo_processor));
+	const size_t l1i_offset = cpuinfo_arena_reserve(&arena,
+		x86_processor.cache.l1i.size != 0 ? l1_count : 0, sizeof(struct cpuinfo_cache));
+	const size_t l1d_offset = cpuinfo_arena_reserve(&arena,
+		x86_processor.cache.l1d.size != 0 ? l1_count : 0, sizeof(struct cpuinfo_cache));
+	const size_t l2_offset = cpuinfo_arena_reserve(&arena, l2_count, sizeof(struct cpuinfo_cache));
+	const size_t l3_offset = cpuinfo_arena_reserve(&arena, l3_count, sizeof(struct cpuinfo_cache));
+	const size_t l4_offset = cpuinfo_arena_reserve(&arena, l4_count, sizeof(struct cpuinfo_cache));
+	if (!cpuinfo_arena_allocate(&arena)) {
+		return;
+	}
+
+	struct cpuinfo_tables* tables = cpuinfo_arena_table(&arena, tables_offset);
+	struct cpuinfo_processor* processors = cpuinfo_arena_table(&arena, processors_offset);
+	struct cpuinfo_cache* l1i = cpuinfo_arena_table(&arena, l1i_offset);
+	struct cpuinfo_cache* l1d = cpuinfo_arena_table(&arena, l1d_offset);
+	struct cpuinfo_cache* l2 = cpuinfo_arena_table(&arena, l2_offset);
+	struct cpuinfo_cache* l3 = cpuinfo_arena_table(&arena, l3_offset);
+	struct cpuinfo_cache* l4 = cpuinfo_arena_table(&arena, l4_offset);
+
+	const uint32_t threads_per_core = mach_topology.threads / mach_topology.cores;
+	const uint32_t threads_per_package = mach_topology.threads / mach_topology.packages;
+	for (uint32_t t = 0; t < mach_topology.threads; t++) {
+		processors[t].vendor = x86_processor.vendor;
+		processors[t].uarch = x86_processor.uarch;
+
+		/* Reconstruct APIC IDs from topology components */
+		const uint32_t thread_bits_mask = bit_mask(x86_processor.topology.thread_bits_length);
+		const uint32_t core_bits_mask   = bit_mask(x86_processor.topology.core_bits_length);
+
+		const uint32_t smt_id = t % threads_per_core;
+		const uint32_t core_id = t / threads_per_core;
+		const uint32_t package_id = t / threads_per_package;
+		const uint32_t package_bits_offset = max(
+			x86_processor.topology.thread_bits_offset + x86_processor.topology.thread_bits_length,
+			x86_processor.topology.core_bits_offset + x86_processor.topology.core_bits_length);
+
+		const uint32_t apic_id =
+			((smt_id & thread_bits_mask) << x86_processor.topology.thread_bits_offset) |
+			((core_id & core_bits_mask) << x86_processor.topology.core_bits_offset) |
+			(package_id << package_bits_offset);
+		processors[t].topology = (struct cpuinfo_topology) {
+			.thread_id  = smt_id,
+			.core_id    = core_id,
+			.package_id = package_id
+		};
+		cpuinfo_log_info("reconstructed APIC ID 0x%08"PRIx32" for thread %"PRIu32, apic_id, t);
+	}
 
 	if (x86_processor.cache.l1i.size != 0) {
-		l1i = calloc(l1_count, sizeof(struct cpuinfo_cache));
-		if (l1i == NULL) {
-			cpuinfo_log_error("failed to allocate %zu bytes for descriptions of %"PRIu32" L1I caches",
-				l1_count * sizeof(struct cpuinfo_cache), l1_count);
-			return;
-		}
 		for (uint32_t c = 0; c < l1_count; c++) {
 			l1i[c] = (struct cpuinfo_cache) {
 				.size          = x86_processor.cache.l1i.size,
@@ -152,12 +157,6 @@ void cpuinfo_x86_mach_init(void) {
 	}
 
 	if (x86_processor.cache.l1d.size != 0) {
-		l1d = calloc(l1_count, sizeof(struct cpuinfo_cache));
-		if (l1d == NULL) {
-			cpuinfo_log_error("failed to allocate %zu bytes for descriptions of %"PRIu32" L1D caches",
-				l1_count * sizeof(struct cpuinfo_cache), l1_count);
-			return;
-		}
 		for (uint32_t c = 0; c < l1_count; c++) {
 			l1d[c] = (struct cpuinfo_cache) {
 				.size          = x86_processor.cache.l1d.size,
@@ -176,12 +175,6 @@ void cpuinfo_x86_mach_init(void) {
 	}
 
 	if (l2_count != 0) {
-		l2 = calloc(l2_count, sizeof(struct cpuinfo_cache));
-		if (l1d == NULL) {
-			cpuinfo_log_error("failed to allocate %zu bytes for descriptions of %"PRIu32" L2 caches",
-				l2_count * sizeof(struct cpuinfo_cache), l2_count);
-			return;
-		}
 		for (uint32_t c = 0; c < l2_count; c++) {
 			l2[c] = (struct cpuinfo_cache) {
 				.size          = x86_processor.cache.l2.size,
@@ -200,12 +193,6 @@ void cpuinfo_x86_mach_init(void) {
 	}
 
 	if (l3_count != 0) {
-		l3 = calloc(l3_count, sizeof(struct cpuinfo_cache));
-		if (l3 == NULL) {
-			cpuinfo_log_error("failed to allocate %zu bytes for descriptions of %"PRIu32" L3 caches",
-				l3_count * sizeof(struct cpuinfo_cache), l3_count);
-			return;
-		}
 		for (uint32_t c = 0; c < l3_count; c++) {
 			l3[c] = (struct cpuinfo_cache) {
 				.size          = x86_processor.cache.l3.size,
@@ -224,12 +211,6 @@ void cpuinfo_x86_mach_init(void) {
 	}
 
 	if (l4_count != 0) {
-		l4 = calloc(l4_count, sizeof(struct cpuinfo_cache));
-		if (l4 == NULL) {
-			cpuinfo_log_error("failed to allocate %zu bytes for descriptions of %"PRIu32" L4 caches",
-				l4_count * sizeof(struct cpuinfo_cache), l4_count);
-			return;
-		}
 		for (uint32_t c = 0; c < l4_count; c++) {
 			l4[c] = (struct cpuinfo_cache) {
 				.size          = x86_processor.cache.l4.size,
@@ -247,20 +228,25 @@ void cpuinfo_x86_mach_init(void) {
 		}
 	}
 
+	cpuinfo_x86_detect_platform(tables);
+
 	/* Commit changes */
-	cpuinfo_cache[cpuinfo_cache_level_1i] = l1i;
-	cpuinfo_cache[cpuinfo_cache_level_1d] = l1d;
-	cpuinfo_cache[cpuinfo_cache_level_2]  = l2;
-	cpuinfo_cache[cpuinfo_cache_level_3]  = l3;
-	cpuinfo_cache[cpuinfo_cache_level_4]  = l4;
+	tables->arena = arena;
+	tables->cache[cpuinfo_cache_level_1i] = l1i;
+	tables->cache[cpuinfo_cache_level_1d] = l1d;
+	tables->cache[cpuinfo_cache_level_2]  = l2;
+	tables->cache[cpuinfo_cache_level_3]  = l3;
+	tables->cache[cpuinfo_cache_level_4]  = l4;
+
+	tables->processors = processors;
 
-	cpuinfo_processors = processors;
+	tables->cache_count[cpuinfo_cache_level_1i] = l1i != NULL ? l1_count : 0;
+	tables->cache_count[cpuinfo_cache_level_1d] = l1d != NULL ? l1_count : 0;
+	tables->cache_count[cpuinfo_cache_level_2]  = l2_count;
+	tables->cache_count[cpuinfo_cache_level_3]  = l3_count;
+	tables->cache_count[cpuinfo_cache_level_4]  = l4_count;
 
-	cpuinfo_cache_count[cpuinfo_cache_level_1i] = l1_count;
-	cpuinfo_cache_count[cpuinfo_cache_level_1d] = l1_count;
-	cpuinfo_cache_count[cpuinfo_cache_level_2]  = l2_count;
-	cpuinfo_cache_count[cpuinfo_cache_level_3]  = l3_count;
-	cpuinfo_cache_count[cpuinfo_cache_level_4]  = l4_count;
+	tables->processors_count = mach_topology.threads;
 
-	cpuinfo_processors_count = mach_topology.threads;
+	cpuinfo_publish_tables(tables);
 }
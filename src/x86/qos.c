@@ -0,0 +1,107 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <cpuinfo.h>
+#include <x86/cpuid.h>
+#include <x86/api.h>
+#include <log.h>
+
+
+/* Highest bandwidth setting of Intel MBA, in percent */
+#define MBA_MAX_BANDWIDTH 100
+
+static struct cpuinfo_cache_allocation decode_cache_allocation(struct cpuid_regs regs) {
+	return (struct cpuinfo_cache_allocation) {
+		/* eax[bits 0-4] = capacity bitmask length - 1 */
+		.bitmask_length = (regs.eax & UINT32_C(0x0000001F)) + 1,
+		/* ebx = bitmask of shareable resource units */
+		.shareable_bits = regs.ebx,
+		/* ecx[bit 2] = code and data prioritization */
+		.cdp = !!(regs.ecx & UINT32_C(0x00000004)),
+		/* edx[bits 0-15] = highest class of service number */
+		.classes = (regs.edx & UINT32_C(0x0000FFFF)) + 1,
+	};
+}
+
+struct cpuinfo_qos cpuinfo_x86_detect_qos(uint32_t max_base_index, uint32_t max_extended_index) {
+	struct cpuinfo_qos qos = { 0 };
+
+	if (max_base_index < 7) {
+		return qos;
+	}
+
+	/*
+	 * Resource Director Technology Monitoring:
+	 * - Intel, AMD: ebx[bit 12] in structured feature info.
+	 * Resource Director Technology Allocation:
+	 * - Intel, AMD: ebx[bit 15] in structured feature info.
+	 */
+	const struct cpuid_regs structured_feature_info = cpuidex(7, 0);
+	const bool monitoring = !!(structured_feature_info.ebx & UINT32_C(0x00001000));
+	const bool allocation = !!(structured_feature_info.ebx & UINT32_C(0x00008000));
+
+	if (monitoring && max_base_index >= UINT32_C(0x0000000F)) {
+		/* edx[bit 1] in sub-leaf 0 = L3 cache monitoring */
+		const struct cpuid_regs monitoring_info = cpuidex(UINT32_C(0x0000000F), 0);
+		if (monitoring_info.edx & UINT32_C(0x00000002)) {
+			const struct cpuid_regs l3_monitoring_info = cpuidex(UINT32_C(0x0000000F), 1);
+			qos.l3_monitoring = (struct cpuinfo_cache_monitoring) {
+				/* ecx = highest RMID number of L3 monitoring */
+				.rmids = l3_monitoring_info.ecx + 1,
+				.upscaling_factor = l3_monitoring_info.ebx,
+				.occupancy = !!(l3_monitoring_info.edx & UINT32_C(0x00000001)),
+				.total_bandwidth = !!(l3_monitoring_info.edx & UINT32_C(0x00000002)),
+				.local_bandwidth = !!(l3_monitoring_info.edx & UINT32_C(0x00000004)),
+			};
+		}
+	}
+
+	if (allocation && max_base_index >= UINT32_C(0x00000010)) {
+		/*
+		 * Supported resources in sub-leaf 0:
+		 * - ebx[bit 1] = L3 cache allocation, details in sub-leaf 1.
+		 * - ebx[bit 2] = L2 cache allocation, details in sub-leaf 2.
+		 * - ebx[bit 3] = memory bandwidth allocation, details in sub-leaf 3.
+		 */
+		const struct cpuid_regs allocation_info = cpuidex(UINT32_C(0x00000010), 0);
+		if (allocation_info.ebx & UINT32_C(0x00000002)) {
+			qos.l3 = decode_cache_allocation(cpuidex(UINT32_C(0x00000010), 1));
+		}
+		if (allocation_info.ebx & UINT32_C(0x00000004)) {
+			qos.l2 = decode_cache_allocation(cpuidex(UINT32_C(0x00000010), 2));
+		}
+		if (allocation_info.ebx & UINT32_C(0x00000008)) {
+			const struct cpuid_regs bandwidth_info = cpuidex(UINT32_C(0x00000010), 3);
+			/* eax[bits 0-11] = maximum throttling value - 1 */
+			const uint32_t max_throttling = (bandwidth_info.eax & UINT32_C(0x00000FFF)) + 1;
+			/* ecx[bit 2] = response of the delay values is linear */
+			const bool linear = !!(bandwidth_info.ecx & UINT32_C(0x00000004));
+			qos.memory_bandwidth = (struct cpuinfo_bandwidth_allocation) {
+				.classes = (bandwidth_info.edx & UINT32_C(0x0000FFFF)) + 1,
+				.max_throttling = max_throttling,
+				/* Linux derives the granularity of linear throttling the same way */
+				.granularity = linear && max_throttling < MBA_MAX_BANDWIDTH ? MBA_MAX_BANDWIDTH - max_throttling : 0,
+				.linear = linear,
+			};
+		}
+	}
+
+	/*
+	 * AMD reports memory bandwidth enforcement in a separate extended leaf:
+	 * - ebx[bit 1] in sub-leaf 0 = L3 external bandwidth enforcement, details in sub-leaf 1.
+	 */
+	if (allocation && qos.memory_bandwidth.classes == 0 && max_extended_index >= UINT32_C(0x80000020)) {
+		const struct cpuid_regs extended_allocation_info = cpuidex(UINT32_C(0x80000020), 0);
+		if (extended_allocation_info.ebx & UINT32_C(0x00000002)) {
+			const struct cpuid_regs bandwidth_info = cpuidex(UINT32_C(0x80000020), 1);
+			qos.memory_bandwidth = (struct cpuinfo_bandwidth_allocation) {
+				/* edx = highest class of service number */
+				.classes = bandwidth_info.edx + 1,
+				/* eax = length of bandwidth limit field in bits */
+				.max_throttling = UINT32_C(1) << (bandwidth_info.eax & UINT32_C(0x0000001F)),
+			};
+		}
+	}
+
+	return qos;
+}
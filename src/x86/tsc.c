@@ -0,0 +1,217 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+#include <cpuinfo.h>
+#include <x86/cpuid.h>
+#include <x86/api.h>
+#include <api.h>
+#include <log.h>
+
+
+#define HZ_PER_KHZ UINT64_C(1000)
+#define HZ_PER_MHZ UINT64_C(1000000)
+#define NANOSECONDS_PER_SECOND UINT64_C(1000000000)
+
+/*
+ * Duration of the calibration interval.
+ * Long enough to make the latency of reading the system clock negligible (below 0.01%),
+ * short enough to be unnoticeable at process start.
+ */
+#define CALIBRATION_NANOSECONDS UINT64_C(10000000)
+/* Number of attempts to read the system clock with the least possible latency */
+#define CALIBRATION_READ_ATTEMPTS 5
+
+/*
+ * Some processors report the ratio of TSC to core crystal clock in CPUID leaf 0x15, but not the crystal frequency.
+ * For those without CPUID leaf 0x16 the frequency is known from Intel documentation.
+ */
+static uint64_t crystal_frequency_for_model(const struct cpuinfo_x86_model_info model_info[restrict static 1]) {
+	if (model_info->family == 0x06) {
+		switch (model_info->model) {
+			case 0x5C: /* Goldmont (Apollo Lake) */
+				return UINT64_C(19200000);
+			case 0x5F: /* Goldmont (Denverton) */
+				return UINT64_C(25000000);
+		}
+	}
+	return 0;
+}
+
+struct cpuinfo_tsc cpuinfo_x86_detect_tsc(
+	uint32_t max_base_index, uint32_t max_extended_index, struct cpuid_regs leaf1,
+	const struct cpuinfo_x86_model_info model_info[restrict static 1])
+{
+	struct cpuinfo_tsc tsc = { 0 };
+
+	/*
+	 * Invariant TSC:
+	 * - Intel, AMD: edx[bit 8] in advanced power management info.
+	 */
+	if (max_extended_index >= UINT32_C(0x80000007)) {
+		tsc.invariant = !!(cpuid(UINT32_C(0x80000007)).edx & UINT32_C(0x00000100));
+	}
+
+	if (max_base_index >= UINT32_C(0x00000016)) {
+		/* eax[bits 0-15] = base frequency, ebx[bits 0-15] = maximum frequency, ecx[bits 0-15] = bus frequency, in MHz */
+		const struct cpuid_regs frequency_info = cpuid(UINT32_C(0x00000016));
+		tsc.base_frequency = (uint64_t) (frequency_info.eax & UINT32_C(0x0000FFFF)) * HZ_PER_MHZ;
+		tsc.max_frequency  = (uint64_t) (frequency_info.ebx & UINT32_C(0x0000FFFF)) * HZ_PER_MHZ;
+		tsc.bus_frequency  = (uint64_t) (frequency_info.ecx & UINT32_C(0x0000FFFF)) * HZ_PER_MHZ;
+	}
+
+	if (max_base_index >= UINT32_C(0x00000015)) {
+		/* eax = denominator and ebx = numerator of the TSC/crystal ratio, ecx = crystal frequency in Hz */
+		const struct cpuid_regs tsc_info = cpuid(UINT32_C(0x00000015));
+		if (tsc_info.eax != 0 && tsc_info.ebx != 0) {
+			uint64_t crystal_frequency = tsc_info.ecx;
+			if (crystal_frequency == 0) {
+				crystal_frequency = crystal_frequency_for_model(model_info);
+			}
+			if (crystal_frequency == 0) {
+				/* Processors which do not report crystal frequency (e.g. Skylake) run the TSC at base frequency */
+				crystal_frequency = tsc.base_frequency * tsc_info.eax / tsc_info.ebx;
+			}
+			tsc.crystal_frequency = crystal_frequency;
+			tsc.frequency = crystal_frequency * tsc_info.ebx / tsc_info.eax;
+		}
+	}
+
+	/*
+	 * Hypervisor present:
+	 * - Intel, AMD: ecx[bit 31] in basic info.
+	 * Some hypervisors (VMware, KVM with the corresponding option) report TSC frequency in kHz in eax of leaf 0x40000010.
+	 */
+	if (tsc.frequency == 0 && (leaf1.ecx & UINT32_C(0x80000000))) {
+		const struct cpuid_regs hypervisor_info = cpuid(UINT32_C(0x40000000));
+		if (hypervisor_info.eax >= UINT32_C(0x40000010) && hypervisor_info.eax < UINT32_C(0x40000100)) {
+			tsc.frequency = (uint64_t) cpuid(UINT32_C(0x40000010)).eax * HZ_PER_KHZ;
+		}
+	}
+
+	return tsc;
+}
+
+#ifndef __native_client__
+	static inline uint64_t rdtsc(void) {
+		uint32_t lo, hi;
+		__asm__ __volatile__("rdtsc" : "=a" (lo), "=d" (hi));
+		return ((uint64_t) hi << 32) | (uint64_t) lo;
+	}
+
+	static uint64_t read_system_clock(void) {
+		struct timespec time;
+		#if defined(__linux__)
+			/* Not subject to NTP frequency adjustments */
+			clock_gettime(CLOCK_MONOTONIC_RAW, &time);
+		#else
+			clock_gettime(CLOCK_MONOTONIC, &time);
+		#endif
+		return (uint64_t) time.tv_sec * NANOSECONDS_PER_SECOND + (uint64_t) time.tv_nsec;
+	}
+
+	/* Reads the system clock and the TSC value at the middle of the system clock read */
+	static uint64_t read_clocks(uint64_t ticks[restrict static 1]) {
+		uint64_t best_latency = UINT64_MAX;
+		uint64_t nanoseconds = 0;
+		for (uint32_t i = 0; i < CALIBRATION_READ_ATTEMPTS; i++) {
+			const uint64_t ticks_before = rdtsc();
+			const uint64_t system_clock = read_system_clock();
+			const uint64_t ticks_after = rdtsc();
+			if (ticks_after - ticks_before < best_latency) {
+				best_latency = ticks_after - ticks_before;
+				*ticks = ticks_before + best_latency / 2;
+				nanoseconds = system_clock;
+			}
+		}
+		return nanoseconds;
+	}
+
+	static uint64_t calibrate_frequency(void) {
+		uint64_t start_ticks, end_ticks;
+		const uint64_t start_nanoseconds = read_clocks(&start_ticks);
+		while (read_system_clock() - start_nanoseconds < CALIBRATION_NANOSECONDS);
+		const uint64_t end_nanoseconds = read_clocks(&end_ticks);
+
+		const uint64_t elapsed_nanoseconds = end_nanoseconds - start_nanoseconds;
+		if (elapsed_nanoseconds == 0 || end_ticks <= start_ticks) {
+			return 0;
+		}
+		return (end_ticks - start_ticks) * NANOSECONDS_PER_SECOND / elapsed_nanoseconds;
+	}
+#endif
+
+void cpuinfo_x86_init_tsc(struct cpuinfo_tables* tables) {
+	if (tables->tsc.frequency == 0) {
+		/*
+		 * TSC:
+		 * - Intel, AMD: edx[bit 4] in basic info.
+		 */
+		const bool tsc = !!(cpuid(1).edx & UINT32_C(0x00000010));
+		#ifndef __native_client__
+			if (tsc) {
+				tables->tsc.frequency = calibrate_frequency();
+				tables->tsc.calibrated = tables->tsc.frequency != 0;
+				cpuinfo_log_debug("TSC frequency is not reported by CPUID: calibrated as %"PRIu64" Hz",
+					tables->tsc.frequency);
+			}
+		#endif
+	}
+
+	/*
+	 * TSC ticks are converted to nanoseconds as (ticks * multiplier) >> shift, with 128-bit intermediate product.
+	 * The multiplier is normalized to use all 64 bits, so the conversion error stays below a nanosecond per day.
+	 */
+	if (tables->tsc.frequency != 0) {
+		const uint64_t frequency = tables->tsc.frequency;
+		uint64_t multiplier = (NANOSECONDS_PER_SECOND << 32) / frequency;
+		uint64_t remainder = (NANOSECONDS_PER_SECOND << 32) % frequency;
+		uint32_t shift = 32;
+		/* Long division: add fractional bits while the multiplier has leading zeroes */
+		while (shift < 64 && !(multiplier & UINT64_C(0x8000000000000000))) {
+			remainder *= 2;
+			multiplier = multiplier * 2 + (remainder >= frequency);
+			if (remainder >= frequency) {
+				remainder -= frequency;
+			}
+			shift += 1;
+		}
+		/* Round to nearest to avoid systematic underestimation of time */
+		if (remainder * 2 >= frequency && multiplier != UINT64_MAX) {
+			multiplier += 1;
+		}
+		tables->tsc_multiplier = multiplier;
+		tables->tsc_shift = shift;
+	}
+}
+
+struct cpuinfo_tsc CPUINFO_ABI cpuinfo_get_tsc(void) {
+	return cpuinfo_get_tables()->tsc;
+}
+
+uint64_t CPUINFO_ABI cpuinfo_tsc_ticks_to_nanoseconds(uint64_t ticks) {
+	const struct cpuinfo_tables* tables = cpuinfo_get_tables();
+
+	/* 128-bit product from 32x32-bit partial products, portable to 32-bit x86 */
+	const uint64_t ticks_hi = ticks >> 32, ticks_lo = ticks & UINT64_C(0xFFFFFFFF);
+	const uint64_t multiplier_hi = tables->tsc_multiplier >> 32;
+	const uint64_t multiplier_lo = tables->tsc_multiplier & UINT64_C(0xFFFFFFFF);
+
+	const uint64_t product_lo_lo = ticks_lo * multiplier_lo;
+	const uint64_t product_hi_lo = ticks_hi * multiplier_lo;
+	const uint64_t product_lo_hi = ticks_lo * multiplier_hi;
+	const uint64_t product_hi_hi = ticks_hi * multiplier_hi;
+	const uint64_t middle = (product_lo_lo >> 32) +
+		(product_hi_lo & UINT64_C(0xFFFFFFFF)) + (product_lo_hi & UINT64_C(0xFFFFFFFF));
+	const uint64_t product_hi = product_hi_hi + (product_hi_lo >> 32) + (product_lo_hi >> 32) + (middle >> 32);
+	const uint64_t product_lo = (middle << 32) | (product_lo_lo & UINT64_C(0xFFFFFFFF));
+
+	const uint32_t shift = tables->tsc_shift;
+	if (shift == 0) {
+		return 0;
+	} else if (shift == 64) {
+		return product_hi;
+	} else {
+		return (product_hi << (64 - shift)) | (product_lo >> shift);
+	}
+}
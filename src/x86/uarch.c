@@ -75,12 +75,26 @@ enum cpuinfo_uarch cpuinfo_x86_decode_uarch(
 						case 0x56: // Broadwell-DE
 							return cpuinfo_uarch_broadwell;
 						case 0x4E: // Skylake-U/Y
-						case 0x55: // Skylake Server (SKX)
 						case 0x5E: // Skylake-H/S
 							return cpuinfo_uarch_sky_lake;
+						case 0x55: // Skylake Server (SKX), Cascade Lake, Cooper Lake
+							return cpuinfo_uarch_sky_lake_server;
 						case 0x8E: // Kaby Lake U/Y
 						case 0x9E: // Kaby Lake H/S
 							return cpuinfo_uarch_kaby_lake;
+						case 0x97: // Alder Lake-S
+						case 0x9A: // Alder Lake-P
+							return cpuinfo_uarch_golden_cove;
+						case 0x8F: // Sapphire Rapids
+						case 0xCF: // Emerald Rapids (Raptor Cove server cores, same execution units)
+							return cpuinfo_uarch_golden_cove_server;
+						case 0xB7: // Raptor Lake-S
+						case 0xBA: // Raptor Lake-P
+						case 0xBF: // Raptor Lake-S
+							return cpuinfo_uarch_raptor_cove;
+						case 0xAA: // Meteor Lake-H/U
+						case 0xAC: // Meteor Lake-S
+							return cpuinfo_uarch_redwood_cove;
 
 						/* Low-power cores */
 						case 0x1C: // Diamondville, Silverthorne, Pineview
@@ -98,6 +112,8 @@ enum cpuinfo_uarch cpuinfo_x86_decode_uarch(
 						case 0x4C: // Braswell
 						case 0x5D: // Denverton
 							return cpuinfo_uarch_airmont;
+						case 0xBE: // Alder Lake-N
+							return cpuinfo_uarch_gracemont;
 
 						/* Knights-series cores */
 						case 0x57:
@@ -184,8 +200,21 @@ enum cpuinfo_uarch cpuinfo_x86_decode_uarch(
 					return cpuinfo_uarch_jaguar;
 					break;
 				case 0x17:
-					// TODO: revise when CPUs are out
 					return cpuinfo_uarch_zen;
+				case 0x19:
+					switch (model_info->model >> 4) {
+						case 0x0: // EPYC 7003 (Milan)
+						case 0x2: // Ryzen 5000 (Vermeer)
+						case 0x4: // Ryzen 6000 (Rembrandt)
+						case 0x5: // Ryzen 5000 APU (Cezanne)
+							return cpuinfo_uarch_zen3;
+						case 0x1: // EPYC 9004 (Genoa)
+						case 0x6: // Ryzen 7000 (Raphael)
+						case 0x7: // Ryzen 7040 (Phoenix)
+						case 0xA: // EPYC 97x4 (Bergamo)
+							return cpuinfo_uarch_zen4;
+					}
+					break;
 			}
 			break;
 		default:
@@ -193,3 +222,25 @@ enum cpuinfo_uarch cpuinfo_x86_decode_uarch(
 	}
 	return cpuinfo_uarch_unknown;
 }
+
+enum cpuinfo_uarch cpuinfo_x86_decode_hybrid_uarch(
+	enum cpuinfo_uarch uarch,
+	enum cpuinfo_core_type core_type)
+{
+	/*
+	 * Model number in CPUID leaf 1 identifies the hybrid processor, and the microarchitecture of its performance cores.
+	 * Efficiency cores are paired with the performance cores of the same processor generation.
+	 */
+	if (core_type == cpuinfo_core_type_efficiency) {
+		switch (uarch) {
+			case cpuinfo_uarch_golden_cove:
+			case cpuinfo_uarch_raptor_cove:
+				return cpuinfo_uarch_gracemont;
+			case cpuinfo_uarch_redwood_cove:
+				return cpuinfo_uarch_crestmont;
+			default:
+				break;
+		}
+	}
+	return uarch;
+}
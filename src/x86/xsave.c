@@ -0,0 +1,121 @@
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <cpuinfo.h>
+#include <x86/cpuid.h>
+#include <x86/api.h>
+#include <api.h>
+#include <log.h>
+
+
+/* Legacy region (x87 and SSE state) and XSAVE header precede the extended state components */
+#define XSAVE_LEGACY_REGION_SIZE 512
+#define XSAVE_HEADER_SIZE 64
+#define XSAVE_COMPONENT_ALIGNMENT 64
+
+void cpuinfo_x86_detect_xsave(
+	uint32_t max_base_index, struct cpuid_regs leaf1,
+	struct cpuinfo_xsave xsave_ptr[restrict static 1],
+	struct cpuinfo_xsave_component components[restrict static CPUINFO_XSAVE_MAX_COMPONENTS])
+{
+	/*
+	 * OSXSAVE: Operating system enabled XSAVE instructions for application use:
+	 * - Intel, AMD: ecx[bit 26] in basic info = XSAVE/XRSTOR instructions supported by a chip.
+	 * - Intel, AMD: ecx[bit 27] in basic info = XSAVE/XRSTOR instructions enabled by OS.
+	 */
+	const uint32_t osxsave_mask = UINT32_C(0x0C000000);
+	if ((leaf1.ecx & osxsave_mask) != osxsave_mask || max_base_index < UINT32_C(0xD)) {
+		return;
+	}
+
+#ifndef __native_client__
+	struct cpuinfo_xsave xsave = { 0 };
+	xsave.enabled_components = xgetbv(0);
+
+	/*
+	 * Main XSAVE leaf:
+	 * - Intel, AMD: edx:eax in sub-leaf 0 = user state components supported in XCR0.
+	 * - Intel, AMD: ebx in sub-leaf 0 = size of XSAVE area for components currently enabled in XCR0.
+	 * - Intel, AMD: ecx in sub-leaf 0 = size of XSAVE area for all supported user state components.
+	 */
+	const struct cpuid_regs main_info = cpuidex(UINT32_C(0xD), 0);
+	xsave.supported_components = ((uint64_t) main_info.edx << 32) | (uint64_t) main_info.eax;
+	xsave.enabled_size = main_info.ebx;
+	xsave.max_size = main_info.ecx;
+
+	/*
+	 * XSAVE extensions:
+	 * - Intel, AMD: eax[bit 0] in sub-leaf 1 = XSAVEOPT instruction.
+	 * - Intel, AMD: eax[bit 1] in sub-leaf 1 = XSAVEC instruction and compacted format.
+	 * - Intel, AMD: eax[bit 2] in sub-leaf 1 = XGETBV with ECX = 1.
+	 * - Intel, AMD: eax[bit 3] in sub-leaf 1 = XSAVES/XRSTORS instructions and IA32_XSS MSR.
+	 * - Intel: eax[bit 4] in sub-leaf 1 = extended feature disable (XFD).
+	 * - Intel, AMD: edx:ecx in sub-leaf 1 = supervisor state components supported in IA32_XSS.
+	 */
+	const struct cpuid_regs extension_info = cpuidex(UINT32_C(0xD), 1);
+	xsave.xsaveopt = !!(extension_info.eax & UINT32_C(0x00000001));
+	xsave.xsavec   = !!(extension_info.eax & UINT32_C(0x00000002));
+	xsave.xgetbv1  = !!(extension_info.eax & UINT32_C(0x00000004));
+	xsave.xsaves   = !!(extension_info.eax & UINT32_C(0x00000008));
+	xsave.xfd      = !!(extension_info.eax & UINT32_C(0x00000010));
+	xsave.supervisor_components = ((uint64_t) extension_info.edx << 32) | (uint64_t) extension_info.ecx;
+
+	/* x87 and SSE state are parts of the legacy region, at the same location in both formats */
+	components[0] = (struct cpuinfo_xsave_component) { .size = 160 };
+	components[1] = (struct cpuinfo_xsave_component) { .size = 256, .offset = 160, .compacted_offset = 160 };
+
+	/*
+	 * Extended state components:
+	 * - Intel, AMD: eax in sub-leaf i = size of state component i.
+	 * - Intel, AMD: ebx in sub-leaf i = offset of user state component i in the standard format.
+	 * - Intel, AMD: ecx[bit 0] in sub-leaf i = state component i is a supervisor state component.
+	 * - Intel, AMD: ecx[bit 1] in sub-leaf i = state component i is 64-byte aligned in the compacted format.
+	 * - Intel: ecx[bit 2] in sub-leaf i = state component i supports XFD.
+	 *
+	 * In the compacted format written by XSAVEC, components enabled in XCR0 follow the header in order
+	 * of their index without gaps, except for the alignment of components which require it.
+	 */
+	const uint64_t all_components = xsave.supported_components | xsave.supervisor_components;
+	uint32_t compacted_offset = XSAVE_LEGACY_REGION_SIZE + XSAVE_HEADER_SIZE;
+	for (uint32_t i = 2; i < CPUINFO_XSAVE_MAX_COMPONENTS; i++) {
+		if (!(all_components & (UINT64_C(1) << i))) {
+			continue;
+		}
+
+		const struct cpuid_regs component_info = cpuidex(UINT32_C(0xD), i);
+		struct cpuinfo_xsave_component component = {
+			.size = component_info.eax,
+			.offset = component_info.ebx,
+			.supervisor = !!(component_info.ecx & UINT32_C(0x00000001)),
+			.aligned = !!(component_info.ecx & UINT32_C(0x00000002)),
+			.xfd = !!(component_info.ecx & UINT32_C(0x00000004)),
+		};
+		if (!component.supervisor && (xsave.enabled_components & (UINT64_C(1) << i))) {
+			if (component.aligned) {
+				compacted_offset = (compacted_offset + XSAVE_COMPONENT_ALIGNMENT - 1) & ~(uint32_t) (XSAVE_COMPONENT_ALIGNMENT - 1);
+			}
+			component.compacted_offset = compacted_offset;
+			compacted_offset += component.size;
+		}
+		components[i] = component;
+	}
+	if (xsave.xsavec) {
+		xsave.compacted_size = compacted_offset;
+	}
+
+	cpuinfo_log_debug("XSAVE area: %"PRIu32" bytes for enabled components, %"PRIu32" bytes max, %"PRIu32" bytes compacted",
+		xsave.enabled_size, xsave.max_size, xsave.compacted_size);
+	*xsave_ptr = xsave;
+#endif
+}
+
+struct cpuinfo_xsave CPUINFO_ABI cpuinfo_get_xsave(void) {
+	return cpuinfo_get_tables()->xsave;
+}
+
+struct cpuinfo_xsave_component CPUINFO_ABI cpuinfo_get_xsave_component(uint32_t index) {
+	if (index >= CPUINFO_XSAVE_MAX_COMPONENTS) {
+		return (struct cpuinfo_xsave_component) { 0 };
+	}
+	return cpuinfo_get_tables()->xsave_components[index];
+}
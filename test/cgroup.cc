@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+#include <sched.h>
+
+#include <cpuinfo.h>
+#include <cpuinfo-mock.h>
+
+
+/* Internal entry point, which reads the cgroup of the calling process */
+extern "C" bool cpuinfo_linux_detect_cgroup_limits(cpu_set_t* cpuset, uint32_t* quota_processors);
+
+/*
+ * Each fake cgroup root is found relative to the source root, and the test must run from it.
+ * The "cgroup" file replaces /proc/self/cgroup, and the "fs" directory replaces /sys/fs/cgroup.
+ */
+static bool detect(const char* root, cpu_set_t* cpuset, uint32_t* quota_processors) {
+	const std::string path = std::string("test/cgroup/") + root;
+	cpuinfo_set_proc_self_cgroup_path((path + "/cgroup").c_str());
+	cpuinfo_set_cgroup_path((path + "/fs").c_str());
+	return cpuinfo_linux_detect_cgroup_limits(cpuset, quota_processors);
+}
+
+static std::string cpulist(const cpu_set_t* cpuset) {
+	std::string list;
+	for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+		if (CPU_ISSET(cpu, cpuset)) {
+			list += (list.empty() ? "" : ",") + std::to_string(cpu);
+		}
+	}
+	return list;
+}
+
+TEST(CGROUP_V2, nested_cgroup) {
+	cpu_set_t cpuset;
+	uint32_t quota_processors = 0;
+	ASSERT_TRUE(detect("v2", &cpuset, &quota_processors));
+	ASSERT_EQ("4,5,6,7,10", cpulist(&cpuset));
+	/* The quota of an ancestor limits the cgroup */
+	ASSERT_EQ(4, quota_processors);
+}
+
+TEST(CGROUP_V2, namespace_root) {
+	cpu_set_t cpuset;
+	uint32_t quota_processors = 0;
+	ASSERT_TRUE(detect("v2-namespace", &cpuset, &quota_processors));
+	ASSERT_EQ("0,1", cpulist(&cpuset));
+	/* 1.5 processors are rounded up */
+	ASSERT_EQ(2, quota_processors);
+}
+
+TEST(CGROUP_V2, host_path) {
+	cpu_set_t cpuset;
+	uint32_t quota_processors = 0;
+	ASSERT_TRUE(detect("v2-host-path", &cpuset, &quota_processors));
+	/* The cgroup of a container without cgroup namespace is mounted as the root */
+	ASSERT_EQ("2", cpulist(&cpuset));
+	ASSERT_EQ(1, quota_processors);
+}
+
+TEST(CGROUP_V2, no_limits) {
+	cpu_set_t cpuset;
+	uint32_t quota_processors = 0;
+	ASSERT_TRUE(detect("v2-no-limits", &cpuset, &quota_processors));
+	/* Without the cpuset controller in the cgroup, the cpuset of the closest ancestor applies */
+	ASSERT_EQ("0,1,2,3", cpulist(&cpuset));
+	ASSERT_EQ(UINT32_MAX, quota_processors);
+}
+
+TEST(CGROUP_V1, docker) {
+	cpu_set_t cpuset;
+	uint32_t quota_processors = 0;
+	ASSERT_TRUE(detect("v1", &cpuset, &quota_processors));
+	ASSERT_EQ("2,3,4,5", cpulist(&cpuset));
+	ASSERT_EQ(3, quota_processors);
+}
+
+TEST(CGROUP, missing) {
+	cpu_set_t cpuset;
+	uint32_t quota_processors = 0;
+	ASSERT_FALSE(detect("missing", &cpuset, &quota_processors));
+	ASSERT_EQ(CPU_SETSIZE, CPU_COUNT(&cpuset));
+	ASSERT_EQ(UINT32_MAX, quota_processors);
+}
+
+int main(int argc, char* argv[]) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
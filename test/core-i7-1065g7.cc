@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <cpuinfo.h>
+#include <cpuinfo-mock.h>
+
+#include "cpuid/core-i7-1065g7.h"
+
+
+TEST(PROCESSORS, non_null) {
+	ASSERT_TRUE(cpuinfo_processors);
+}
+
+TEST(PROCESSORS, vendor_intel) {
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		ASSERT_EQ(cpuinfo_vendor_intel, cpuinfo_processors[i].vendor);
+	}
+}
+
+TEST(ISA, avx2) {
+	ASSERT_TRUE(cpuinfo_isa.avx2);
+}
+
+TEST(ISA, avx512f) {
+	ASSERT_TRUE(cpuinfo_isa.avx512f);
+}
+
+TEST(ISA, avx512vl) {
+	ASSERT_TRUE(cpuinfo_isa.avx512vl);
+}
+
+TEST(ISA, avx512vbmi) {
+	ASSERT_TRUE(cpuinfo_isa.avx512vbmi);
+}
+
+TEST(ISA, avx512vbmi2) {
+	ASSERT_TRUE(cpuinfo_isa.avx512vbmi2);
+}
+
+TEST(ISA, avx512bitalg) {
+	ASSERT_TRUE(cpuinfo_isa.avx512bitalg);
+}
+
+TEST(ISA, avx512vnni) {
+	ASSERT_TRUE(cpuinfo_isa.avx512vnni);
+}
+
+TEST(ISA, avx512bf16) {
+	ASSERT_FALSE(cpuinfo_isa.avx512bf16);
+}
+
+TEST(ISA, avx_vnni) {
+	ASSERT_FALSE(cpuinfo_isa.avx_vnni);
+}
+
+TEST(ISA, gfni) {
+	ASSERT_TRUE(cpuinfo_isa.gfni);
+}
+
+TEST(ISA, vaes) {
+	ASSERT_TRUE(cpuinfo_isa.vaes);
+}
+
+TEST(ISA, vpclmulqdq) {
+	ASSERT_TRUE(cpuinfo_isa.vpclmulqdq);
+}
+
+TEST(ISA, no_amx) {
+	ASSERT_FALSE(cpuinfo_isa.amx_tile);
+	ASSERT_FALSE(cpuinfo_isa.amx_int8);
+	ASSERT_FALSE(cpuinfo_isa.amx_bf16);
+}
+
+TEST(AMX, not_supported) {
+	ASSERT_EQ(0, cpuinfo_get_amx().max_palette);
+	ASSERT_EQ(0, cpuinfo_get_amx().tiles);
+	ASSERT_FALSE(cpuinfo_request_amx_permission());
+}
+
+TEST(ISA_LEVEL, x86_64_v4) {
+	ASSERT_EQ(4, cpuinfo_get_x86_64_level());
+	ASSERT_STREQ("x86-64-v4", cpuinfo_get_isa_level_name());
+}
+
+int main(int argc, char* argv[]) {
+	cpuinfo_set_cpuid(core_i7_1065g7_cpuid, sizeof(core_i7_1065g7_cpuid) / sizeof(cpuinfo_mock_cpuid));
+	cpuinfo_set_xcr0(CORE_I7_1065G7_XCR0);
+	cpuinfo_initialize();
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <cpuinfo.h>
+#include <cpuinfo-mock.h>
+
+#include "cpuid/core-i9-12900k.h"
+#include "fake-sysfs.h"
+
+
+/*
+ * Linux processors 0-15 are the SMT threads of the performance cores, with APIC IDs 0x00-0x0F,
+ * and Linux processors 16-23 are the efficiency cores, with APIC IDs 0x40, 0x42, ..., 0x4E.
+ * A fake sysfs cpu directory lists all 24 processors, and each processor has a CPUID dump of its own.
+ */
+#define PERFORMANCE_PROCESSORS 16
+#define EFFICIENCY_PROCESSORS 8
+
+static std::vector<cpuinfo_mock_cpuid> dumps[PERFORMANCE_PROCESSORS + EFFICIENCY_PROCESSORS];
+
+TEST(PROCESSORS, count) {
+	ASSERT_EQ(PERFORMANCE_PROCESSORS + EFFICIENCY_PROCESSORS, cpuinfo_processors_count);
+}
+
+TEST(PROCESSORS, vendor_intel) {
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		ASSERT_EQ(cpuinfo_vendor_intel, cpuinfo_processors[i].vendor);
+	}
+}
+
+TEST(PROCESSORS, uarch) {
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		if (i < PERFORMANCE_PROCESSORS) {
+			ASSERT_EQ(cpuinfo_uarch_golden_cove, cpuinfo_processors[i].uarch);
+		} else {
+			ASSERT_EQ(cpuinfo_uarch_gracemont, cpuinfo_processors[i].uarch);
+		}
+	}
+}
+
+TEST(PROCESSORS, core_type) {
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		if (i < PERFORMANCE_PROCESSORS) {
+			ASSERT_EQ(cpuinfo_core_type_performance, cpuinfo_processors[i].core_type);
+		} else {
+			ASSERT_EQ(cpuinfo_core_type_efficiency, cpuinfo_processors[i].core_type);
+		}
+	}
+}
+
+TEST(PROCESSORS, native_model_id) {
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		ASSERT_EQ(1, cpuinfo_processors[i].native_model_id);
+	}
+}
+
+TEST(CORE_TYPE, performance_processors) {
+	uint32_t processors[PERFORMANCE_PROCESSORS + EFFICIENCY_PROCESSORS];
+	ASSERT_EQ(PERFORMANCE_PROCESSORS,
+		cpuinfo_get_core_type_processors(cpuinfo_core_type_performance, PERFORMANCE_PROCESSORS, processors));
+	for (uint32_t k = 0; k < PERFORMANCE_PROCESSORS; k++) {
+		ASSERT_EQ(k, processors[k]);
+	}
+}
+
+TEST(CORE_TYPE, efficiency_processors) {
+	uint32_t processors[EFFICIENCY_PROCESSORS];
+	ASSERT_EQ(EFFICIENCY_PROCESSORS,
+		cpuinfo_get_core_type_processors(cpuinfo_core_type_efficiency, EFFICIENCY_PROCESSORS, processors));
+	for (uint32_t k = 0; k < EFFICIENCY_PROCESSORS; k++) {
+		ASSERT_EQ(PERFORMANCE_PROCESSORS + k, processors[k]);
+	}
+}
+
+TEST(CORE_TYPE, partial_list) {
+	uint32_t processors[2] = { UINT32_MAX, UINT32_MAX };
+	ASSERT_EQ(EFFICIENCY_PROCESSORS, cpuinfo_get_core_type_processors(cpuinfo_core_type_efficiency, 1, processors));
+	ASSERT_EQ(PERFORMANCE_PROCESSORS, processors[0]);
+	ASSERT_EQ(UINT32_MAX, processors[1]);
+}
+
+TEST(L1D, size) {
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		ASSERT_EQ(i < PERFORMANCE_PROCESSORS ? 48 * 1024 : 32 * 1024, cpuinfo_processors[i].cache.l1d->size);
+	}
+}
+
+TEST(L1I, size) {
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		ASSERT_EQ(i < PERFORMANCE_PROCESSORS ? 32 * 1024 : 64 * 1024, cpuinfo_processors[i].cache.l1i->size);
+	}
+}
+
+TEST(L2, count) {
+	/* One per performance core, and one per module of four efficiency cores */
+	ASSERT_EQ(PERFORMANCE_PROCESSORS / 2 + EFFICIENCY_PROCESSORS / 4, cpuinfo_get_l2_cache().count);
+}
+
+TEST(L2, performance_core) {
+	for (uint32_t i = 0; i < PERFORMANCE_PROCESSORS; i++) {
+		const cpuinfo_cache* l2 = cpuinfo_processors[i].cache.l2;
+		ASSERT_EQ(1280 * 1024, l2->size);
+		ASSERT_EQ(10, l2->associativity);
+		ASSERT_EQ(2, l2->thread_count);
+		ASSERT_EQ(i & ~UINT32_C(1), l2->thread_start);
+	}
+}
+
+TEST(L2, efficiency_module) {
+	for (uint32_t i = PERFORMANCE_PROCESSORS; i < cpuinfo_processors_count; i++) {
+		const cpuinfo_cache* l2 = cpuinfo_processors[i].cache.l2;
+		ASSERT_EQ(2 * 1024 * 1024, l2->size);
+		ASSERT_EQ(16, l2->associativity);
+		ASSERT_EQ(2048, l2->sets);
+		/* L2 of a module is not shared with the preceding performance core */
+		ASSERT_EQ(4, l2->thread_count);
+		ASSERT_EQ(PERFORMANCE_PROCESSORS + (i - PERFORMANCE_PROCESSORS) / 4 * 4, l2->thread_start);
+	}
+}
+
+TEST(L3, shared) {
+	ASSERT_EQ(1, cpuinfo_get_l3_cache().count);
+	ASSERT_EQ(cpuinfo_processors_count, cpuinfo_get_l3_cache().instances[0].thread_count);
+}
+
+TEST(ISA, avx2) {
+	ASSERT_TRUE(cpuinfo_isa.avx2);
+}
+
+TEST(ISA, avx_vnni) {
+	ASSERT_TRUE(cpuinfo_isa.avx_vnni);
+}
+
+TEST(ISA, no_avx512f) {
+	ASSERT_FALSE(cpuinfo_isa.avx512f);
+}
+
+TEST(ISA_LEVEL, x86_64_v3) {
+	ASSERT_EQ(3, cpuinfo_get_x86_64_level());
+	ASSERT_STREQ("x86-64-v3", cpuinfo_get_isa_level_name());
+}
+
+TEST(UARCH_INFO, golden_cove) {
+	const cpuinfo_uarch_info info = cpuinfo_get_uarch_info(cpuinfo_processors[0].uarch);
+	ASSERT_EQ(256, info.vector_width);
+	ASSERT_EQ(2, info.fma_per_cycle);
+	ASSERT_FALSE(info.split_wide_vectors);
+}
+
+TEST(UARCH_INFO, gracemont) {
+	const cpuinfo_uarch_info info = cpuinfo_get_uarch_info(cpuinfo_processors[PERFORMANCE_PROCESSORS].uarch);
+	ASSERT_EQ(128, info.vector_width);
+	ASSERT_TRUE(info.split_wide_vectors);
+}
+
+TEST(UARCH_INFO, hybrid_successors) {
+	/* Raptor Lake and Meteor Lake cores keep the vector and load/store units of Alder Lake cores */
+	ASSERT_EQ(256, cpuinfo_get_uarch_info(cpuinfo_uarch_raptor_cove).vector_width);
+	ASSERT_EQ(256, cpuinfo_get_uarch_info(cpuinfo_uarch_redwood_cove).vector_width);
+	ASSERT_EQ(128, cpuinfo_get_uarch_info(cpuinfo_uarch_crestmont).vector_width);
+	ASSERT_TRUE(cpuinfo_get_uarch_info(cpuinfo_uarch_crestmont).split_wide_vectors);
+}
+
+int main(int argc, char* argv[]) {
+	if (!create_sysfs("core-i9-12900k-test")) {
+		return EXIT_FAILURE;
+	}
+	for (const char* name : { "present", "possible", "online" }) {
+		write_file(name, "0-23\n");
+	}
+
+	for (int i = 0; i < PERFORMANCE_PROCESSORS; i++) {
+		set_processor_dump(dumps[i], i, core_i9_12900k_performance_cpuid,
+			sizeof(core_i9_12900k_performance_cpuid) / sizeof(cpuinfo_mock_cpuid), (uint32_t) i);
+	}
+	for (int i = 0; i < EFFICIENCY_PROCESSORS; i++) {
+		const int linux_id = PERFORMANCE_PROCESSORS + i;
+		set_processor_dump(dumps[linux_id], linux_id, core_i9_12900k_efficiency_cpuid,
+			sizeof(core_i9_12900k_efficiency_cpuid) / sizeof(cpuinfo_mock_cpuid), UINT32_C(0x40) + 2 * (uint32_t) i);
+	}
+	cpuinfo_set_sysfs_cpu_path(sysfs_path.c_str());
+	/* The cgroup of the test does not limit processors of the fake sysfs */
+	cpuinfo_set_proc_self_cgroup_path((sysfs_path + "/cgroup").c_str());
+	cpuinfo_set_cpuid(core_i9_12900k_performance_cpuid,
+		sizeof(core_i9_12900k_performance_cpuid) / sizeof(cpuinfo_mock_cpuid));
+	cpuinfo_set_xcr0(CORE_I9_12900K_XCR0);
+	cpuinfo_initialize();
+	::testing::InitGoogleTest(&argc, argv);
+	const int result = RUN_ALL_TESTS();
+
+	remove_sysfs();
+	return result;
+}
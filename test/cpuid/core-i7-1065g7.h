@@ -0,0 +1,39 @@
+/*
+ * CPUID values of Intel Core i7-1065G7 (Ice Lake client, 4 cores, 8 threads),
+ * reconstructed from the leaf layouts in the Intel SDM and published dumps of this processor.
+ * Structured feature info reports AVX512 VNNI, VBMI2, BITALG, GFNI, VAES, and VPCLMULQDQ,
+ * but neither sub-leaf 1 (AVX-VNNI, AVX512 BF16) nor AMX.
+ * Not a recorded dump of a physical processor: only the leaves which the library reads are included,
+ * and the register values were never verified on hardware.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <cpuinfo-mock.h>
+
+
+static const struct cpuinfo_mock_cpuid core_i7_1065g7_cpuid[] = {
+	{ 0x00000000, 0x00000000, 0x0000001B, 0x756E6547, 0x6C65746E, 0x49656E69 },
+	{ 0x00000001, 0x00000000, 0x000706E5, 0x00100800, 0x7FFAFBBF, 0xBFEBFBFF },
+	{ 0x00000002, 0x00000000, 0x00FEFF01, 0x000000F0, 0x00000000, 0x00000000 },
+	{ 0x00000004, 0x00000000, 0x1C004121, 0x02C0003F, 0x0000003F, 0x00000000 },
+	{ 0x00000004, 0x00000001, 0x1C004122, 0x01C0003F, 0x0000003F, 0x00000000 },
+	{ 0x00000004, 0x00000002, 0x1C004143, 0x01C0003F, 0x000003FF, 0x00000000 },
+	{ 0x00000004, 0x00000003, 0x1C03C163, 0x03C0003F, 0x00001FFF, 0x00000006 },
+	{ 0x00000004, 0x00000004, 0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+	{ 0x00000007, 0x00000000, 0x00000000, 0xF2BF27EF, 0x40405F4E, 0xBC000410 },
+	{ 0x0000000B, 0x00000000, 0x00000001, 0x00000002, 0x00000100, 0x00000000 },
+	{ 0x0000000B, 0x00000001, 0x00000004, 0x00000008, 0x00000201, 0x00000000 },
+	{ 0x0000000B, 0x00000002, 0x00000000, 0x00000000, 0x00000002, 0x00000000 },
+	{ 0x0000000D, 0x00000000, 0x000002E7, 0x00000A88, 0x00000A88, 0x00000000 },
+	{ 0x0000000D, 0x00000001, 0x0000000F, 0x00000A08, 0x00000100, 0x00000000 },
+	{ 0x80000000, 0x00000000, 0x80000008, 0x00000000, 0x00000000, 0x00000000 },
+	{ 0x80000001, 0x00000000, 0x00000000, 0x00000000, 0x00000121, 0x2C100800 },
+	{ 0x80000006, 0x00000000, 0x00000000, 0x00000000, 0x02006040, 0x00000000 },
+	{ 0x80000007, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000100 },
+	{ 0x80000008, 0x00000000, 0x00003027, 0x00000000, 0x00000000, 0x00000000 },
+};
+
+/* XCR0: x87, SSE, AVX, AVX-512, PKRU state enabled by the OS */
+#define CORE_I7_1065G7_XCR0 UINT64_C(0x00000000000002E7)
@@ -0,0 +1,65 @@
+/*
+ * CPUID values of Intel Core i9-12900K (Alder Lake-S, 8 performance and 8 efficiency cores, 24 threads),
+ * as reported on one of the performance (Golden Cove) cores and on one of the efficiency (Gracemont) cores.
+ * Reconstructed from the leaf layouts in the Intel SDM and published dumps of this processor.
+ * Each Golden Cove core has a private 1.25 MB L2 cache, and four Gracemont cores of a module share a 2 MB L2 cache.
+ * APIC IDs are those of the first core of each type, leaves 0x00000001 and 0x0000000B report the APIC ID
+ * of the processor which executes CPUID.
+ * Not a recorded dump of a physical processor: only the leaves which the library reads are included,
+ * and the register values were never verified on hardware.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <cpuinfo-mock.h>
+
+
+static const struct cpuinfo_mock_cpuid core_i9_12900k_performance_cpuid[] = {
+	{ 0x00000000, 0x00000000, 0x00000020, 0x756E6547, 0x6C65746E, 0x49656E69 },
+	{ 0x00000001, 0x00000000, 0x00090672, 0x00800800, 0x7FFAFBFF, 0xBFEBFBFF },
+	{ 0x00000004, 0x00000000, 0xFC004121, 0x02C0003F, 0x0000003F, 0x00000000 },
+	{ 0x00000004, 0x00000001, 0xFC004122, 0x01C0003F, 0x0000003F, 0x00000000 },
+	{ 0x00000004, 0x00000002, 0xFC004143, 0x0240003F, 0x000007FF, 0x00000000 },
+	{ 0x00000004, 0x00000003, 0xFC1FC163, 0x02C0003F, 0x00009FFF, 0x00000004 },
+	{ 0x00000004, 0x00000004, 0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+	{ 0x00000007, 0x00000000, 0x00000001, 0x239CA7EB, 0x98C007AC, 0xFC18C410 },
+	{ 0x00000007, 0x00000001, 0x00400810, 0x00000000, 0x00000000, 0x00000000 },
+	{ 0x0000000B, 0x00000000, 0x00000001, 0x00000002, 0x00000100, 0x00000000 },
+	{ 0x0000000B, 0x00000001, 0x00000007, 0x00000018, 0x00000201, 0x00000000 },
+	{ 0x0000000B, 0x00000002, 0x00000000, 0x00000000, 0x00000002, 0x00000000 },
+	{ 0x0000000D, 0x00000000, 0x00000207, 0x00000A88, 0x00000A88, 0x00000000 },
+	{ 0x0000000D, 0x00000001, 0x0000000F, 0x00000670, 0x00019900, 0x00000000 },
+	{ 0x0000001A, 0x00000000, 0x40000001, 0x00000000, 0x00000000, 0x00000000 },
+	{ 0x80000000, 0x00000000, 0x80000008, 0x00000000, 0x00000000, 0x00000000 },
+	{ 0x80000001, 0x00000000, 0x00000000, 0x00000000, 0x00000121, 0x2C100800 },
+	{ 0x80000006, 0x00000000, 0x00000000, 0x00000000, 0x05007040, 0x00000000 },
+	{ 0x80000007, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000100 },
+	{ 0x80000008, 0x00000000, 0x00003027, 0x00000000, 0x00000000, 0x00000000 },
+};
+
+static const struct cpuinfo_mock_cpuid core_i9_12900k_efficiency_cpuid[] = {
+	{ 0x00000000, 0x00000000, 0x00000020, 0x756E6547, 0x6C65746E, 0x49656E69 },
+	{ 0x00000001, 0x00000000, 0x00090672, 0x40800800, 0x7FFAFBFF, 0xBFEBFBFF },
+	{ 0x00000004, 0x00000000, 0xFC000121, 0x01C0003F, 0x0000003F, 0x00000000 },
+	{ 0x00000004, 0x00000001, 0xFC000122, 0x01C0003F, 0x0000007F, 0x00000000 },
+	{ 0x00000004, 0x00000002, 0xFC01C143, 0x03C0003F, 0x000007FF, 0x00000000 },
+	{ 0x00000004, 0x00000003, 0xFC1FC163, 0x02C0003F, 0x00009FFF, 0x00000004 },
+	{ 0x00000004, 0x00000004, 0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+	{ 0x00000007, 0x00000000, 0x00000001, 0x239CA7EB, 0x98C007AC, 0xFC18C410 },
+	{ 0x00000007, 0x00000001, 0x00400810, 0x00000000, 0x00000000, 0x00000000 },
+	{ 0x0000000B, 0x00000000, 0x00000001, 0x00000001, 0x00000100, 0x00000040 },
+	{ 0x0000000B, 0x00000001, 0x00000007, 0x00000018, 0x00000201, 0x00000040 },
+	{ 0x0000000B, 0x00000002, 0x00000000, 0x00000000, 0x00000002, 0x00000040 },
+	{ 0x0000000D, 0x00000000, 0x00000207, 0x00000A88, 0x00000A88, 0x00000000 },
+	{ 0x0000000D, 0x00000001, 0x0000000F, 0x00000670, 0x00019900, 0x00000000 },
+	{ 0x0000001A, 0x00000000, 0x20000001, 0x00000000, 0x00000000, 0x00000000 },
+	{ 0x80000000, 0x00000000, 0x80000008, 0x00000000, 0x00000000, 0x00000000 },
+	{ 0x80000001, 0x00000000, 0x00000000, 0x00000000, 0x00000121, 0x2C100800 },
+	{ 0x80000006, 0x00000000, 0x00000000, 0x00000000, 0x08007040, 0x00000000 },
+	{ 0x80000007, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000100 },
+	{ 0x80000008, 0x00000000, 0x00003027, 0x00000000, 0x00000000, 0x00000000 },
+};
+
+/* XCR0: x87, SSE, AVX, PKRU state enabled by the OS */
+#define CORE_I9_12900K_XCR0 UINT64_C(0x0000000000000207)
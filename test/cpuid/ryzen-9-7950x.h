@@ -0,0 +1,38 @@
+/*
+ * CPUID values of AMD Ryzen 9 7950X (Zen 4, 16 cores, 32 threads),
+ * reconstructed from the leaf layouts in the AMD APM and published dumps of this processor.
+ * Zen 4 implements AVX512 including VNNI and BF16, but not the VEX-encoded AVX-VNNI.
+ * Cache properties (leaf 0x8000001D) report 1 MB inclusive L2 per core and 32 MB L3 per CCD.
+ * Not a recorded dump of a physical processor: only the leaves which the library reads are included,
+ * and the register values were never verified on hardware.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <cpuinfo-mock.h>
+
+
+static const struct cpuinfo_mock_cpuid ryzen_9_7950x_cpuid[] = {
+	{ 0x00000000, 0x00000000, 0x00000010, 0x68747541, 0x444D4163, 0x69746E65 },
+	{ 0x00000001, 0x00000000, 0x00A60F12, 0x00200800, 0x7EF8320B, 0x178BFBFF },
+	{ 0x00000007, 0x00000000, 0x00000001, 0xF1BF97A9, 0x00405FCE, 0x10000010 },
+	{ 0x00000007, 0x00000001, 0x00000020, 0x00000000, 0x00000000, 0x00000000 },
+	{ 0x0000000B, 0x00000000, 0x00000001, 0x00000002, 0x00000100, 0x00000000 },
+	{ 0x0000000B, 0x00000001, 0x00000005, 0x00000020, 0x00000201, 0x00000000 },
+	{ 0x0000000B, 0x00000002, 0x00000000, 0x00000000, 0x00000002, 0x00000000 },
+	{ 0x0000000D, 0x00000000, 0x000002E7, 0x00000980, 0x00000988, 0x00000000 },
+	{ 0x0000000D, 0x00000001, 0x0000000F, 0x00000348, 0x00001800, 0x00000000 },
+	{ 0x80000000, 0x00000000, 0x80000028, 0x68747541, 0x444D4163, 0x69746E65 },
+	{ 0x80000001, 0x00000000, 0x00A60F12, 0x00000000, 0x75C237FF, 0x2FD3FBFF },
+	{ 0x80000007, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00006799 },
+	{ 0x80000008, 0x00000000, 0x00003030, 0x791EF257, 0x0000501F, 0x00010000 },
+	{ 0x8000001D, 0x00000000, 0x00004121, 0x01C0003F, 0x0000003F, 0x00000000 },
+	{ 0x8000001D, 0x00000001, 0x00004122, 0x01C0003F, 0x0000003F, 0x00000000 },
+	{ 0x8000001D, 0x00000002, 0x00004143, 0x01C0003F, 0x000007FF, 0x00000002 },
+	{ 0x8000001D, 0x00000003, 0x0003C163, 0x03C0003F, 0x00007FFF, 0x00000001 },
+	{ 0x8000001D, 0x00000004, 0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+};
+
+/* XCR0: x87, SSE, AVX, AVX-512, PKRU state enabled by the OS */
+#define RYZEN_9_7950X_XCR0 UINT64_C(0x00000000000002E7)
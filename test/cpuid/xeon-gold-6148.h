@@ -0,0 +1,59 @@
+/*
+ * CPUID values of Intel Xeon Gold 6148 (Skylake-SP, 20 cores, 40 threads),
+ * reconstructed from the leaf layouts in the Intel SDM and published dumps of this processor.
+ * Resource Director Technology leaves (0x0F, 0x10) report L3 CAT with CDP, MBA, CMT and MBM.
+ * Not a recorded dump of a physical processor: only the leaves which the library reads are included,
+ * and the register values were never verified on hardware.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <cpuinfo-mock.h>
+
+
+static const struct cpuinfo_mock_cpuid xeon_gold_6148_cpuid[] = {
+	{ 0x00000000, 0x00000000, 0x00000016, 0x756E6547, 0x6C65746E, 0x49656E69 },
+	{ 0x00000001, 0x00000000, 0x00050654, 0x00400800, 0x7FFEFBFF, 0xBFEBFBFF },
+	{ 0x00000002, 0x00000000, 0x00FEFF01, 0x000000F0, 0x00000000, 0x00000000 },
+	{ 0x00000004, 0x00000000, 0x7C004121, 0x01C0003F, 0x0000003F, 0x00000000 },
+	{ 0x00000004, 0x00000001, 0x7C004122, 0x01C0003F, 0x0000003F, 0x00000000 },
+	{ 0x00000004, 0x00000002, 0x7C004143, 0x03C0003F, 0x000003FF, 0x00000000 },
+	{ 0x00000004, 0x00000003, 0x7C0FC163, 0x0280003F, 0x00009FFF, 0x00000004 },
+	{ 0x00000004, 0x00000004, 0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+	{ 0x00000005, 0x00000000, 0x00000040, 0x00000040, 0x00000003, 0x00002020 },
+	{ 0x00000006, 0x00000000, 0x00000077, 0x00000002, 0x00000009, 0x00000000 },
+	{ 0x00000007, 0x00000000, 0x00000000, 0xD39FFFFB, 0x00000018, 0x9C000000 },
+	{ 0x0000000A, 0x00000000, 0x07300404, 0x00000000, 0x00000000, 0x00000603 },
+	{ 0x0000000B, 0x00000000, 0x00000001, 0x00000002, 0x00000100, 0x00000000 },
+	{ 0x0000000B, 0x00000001, 0x00000006, 0x00000028, 0x00000201, 0x00000000 },
+	{ 0x0000000B, 0x00000002, 0x00000000, 0x00000000, 0x00000002, 0x00000000 },
+	{ 0x0000000D, 0x00000000, 0x000002FF, 0x00000A88, 0x00000A88, 0x00000000 },
+	{ 0x0000000D, 0x00000001, 0x0000000F, 0x00000A08, 0x00000100, 0x00000000 },
+	{ 0x0000000D, 0x00000002, 0x00000100, 0x00000240, 0x00000000, 0x00000000 },
+	{ 0x0000000D, 0x00000003, 0x00000040, 0x000003C0, 0x00000000, 0x00000000 },
+	{ 0x0000000D, 0x00000004, 0x00000040, 0x00000400, 0x00000000, 0x00000000 },
+	{ 0x0000000D, 0x00000005, 0x00000040, 0x00000440, 0x00000000, 0x00000000 },
+	{ 0x0000000D, 0x00000006, 0x00000200, 0x00000480, 0x00000000, 0x00000000 },
+	{ 0x0000000D, 0x00000007, 0x00000400, 0x00000680, 0x00000000, 0x00000000 },
+	{ 0x0000000D, 0x00000008, 0x00000080, 0x00000000, 0x00000001, 0x00000000 },
+	{ 0x0000000D, 0x00000009, 0x00000008, 0x00000A80, 0x00000000, 0x00000000 },
+	{ 0x0000000F, 0x00000000, 0x00000000, 0x000000BF, 0x00000000, 0x00000002 },
+	{ 0x0000000F, 0x00000001, 0x00000000, 0x0000E000, 0x000000BF, 0x00000007 },
+	{ 0x00000010, 0x00000000, 0x00000000, 0x0000000A, 0x00000000, 0x00000000 },
+	{ 0x00000010, 0x00000001, 0x0000000A, 0x00000600, 0x00000004, 0x0000000F },
+	{ 0x00000010, 0x00000003, 0x00000059, 0x00000000, 0x00000004, 0x00000007 },
+	{ 0x00000015, 0x00000000, 0x00000002, 0x000000C0, 0x00000000, 0x00000000 },
+	{ 0x00000016, 0x00000000, 0x00000960, 0x00000E74, 0x00000064, 0x00000000 },
+	{ 0x80000000, 0x00000000, 0x80000008, 0x00000000, 0x00000000, 0x00000000 },
+	{ 0x80000001, 0x00000000, 0x00000000, 0x00000000, 0x00000121, 0x2C100800 },
+	{ 0x80000002, 0x00000000, 0x65746E49, 0x2952286C, 0x6F655820, 0x2952286E },
+	{ 0x80000003, 0x00000000, 0x6C6F4720, 0x31362064, 0x43203834, 0x40205550 },
+	{ 0x80000004, 0x00000000, 0x342E3220, 0x7A484730, 0x00000000, 0x00000000 },
+	{ 0x80000006, 0x00000000, 0x00000000, 0x00000000, 0x04008040, 0x00000000 },
+	{ 0x80000007, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000100 },
+	{ 0x80000008, 0x00000000, 0x0000302E, 0x00000000, 0x00000000, 0x00000000 },
+};
+
+/* XCR0: x87, SSE, AVX, MPX, AVX-512, PKRU state enabled by the OS */
+#define XEON_GOLD_6148_XCR0 UINT64_C(0x00000000000002FF)
@@ -0,0 +1,54 @@
+/*
+ * CPUID values of Intel Xeon Platinum 8480+ (Sapphire Rapids, 56 cores, 112 threads),
+ * reconstructed from the leaf layouts in the Intel SDM and published dumps of this processor.
+ * Sub-leaf 1 of structured feature info reports AVX-VNNI and AVX512 BF16.
+ * Tile information leaves (0x1D, 0x1E) describe AMX palette 1 with 8 tiles of 16 rows x 64 bytes.
+ * Not a recorded dump of a physical processor: only the leaves which the library reads are included,
+ * and the register values were never verified on hardware.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include <cpuinfo-mock.h>
+
+
+static const struct cpuinfo_mock_cpuid xeon_platinum_8480_cpuid[] = {
+	{ 0x00000000, 0x00000000, 0x00000020, 0x756E6547, 0x6C65746E, 0x49656E69 },
+	{ 0x00000001, 0x00000000, 0x000806F8, 0x00800800, 0x7FFEFBFF, 0xBFEBFBFF },
+	{ 0x00000002, 0x00000000, 0x00FEFF01, 0x000000F0, 0x00000000, 0x00000000 },
+	{ 0x00000004, 0x00000000, 0xFC004121, 0x02C0003F, 0x0000003F, 0x00000000 },
+	{ 0x00000004, 0x00000001, 0xFC004122, 0x01C0003F, 0x0000003F, 0x00000000 },
+	{ 0x00000004, 0x00000002, 0xFC004143, 0x03C0003F, 0x000007FF, 0x00000000 },
+	{ 0x00000004, 0x00000003, 0xFC1FC163, 0x0380003F, 0x0001BFFF, 0x00000004 },
+	{ 0x00000004, 0x00000004, 0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+	{ 0x00000007, 0x00000000, 0x00000002, 0xF3BFFBFF, 0x1BC1FFFE, 0xFFDD4416 },
+	{ 0x00000007, 0x00000001, 0x00001C30, 0x00000001, 0x00000000, 0x00000000 },
+	{ 0x00000007, 0x00000002, 0x00000000, 0x00000000, 0x00000000, 0x00000017 },
+	{ 0x0000000B, 0x00000000, 0x00000001, 0x00000002, 0x00000100, 0x00000000 },
+	{ 0x0000000B, 0x00000001, 0x00000007, 0x00000070, 0x00000201, 0x00000000 },
+	{ 0x0000000B, 0x00000002, 0x00000000, 0x00000000, 0x00000002, 0x00000000 },
+	{ 0x0000000D, 0x00000000, 0x000602E7, 0x00002B00, 0x00002B00, 0x00000000 },
+	{ 0x0000000D, 0x00000001, 0x0000001F, 0x00002A00, 0x00001900, 0x00000000 },
+	{ 0x0000000D, 0x00000002, 0x00000100, 0x00000240, 0x00000000, 0x00000000 },
+	{ 0x0000000D, 0x00000005, 0x00000040, 0x00000440, 0x00000000, 0x00000000 },
+	{ 0x0000000D, 0x00000006, 0x00000200, 0x00000480, 0x00000000, 0x00000000 },
+	{ 0x0000000D, 0x00000007, 0x00000400, 0x00000680, 0x00000000, 0x00000000 },
+	{ 0x0000000D, 0x00000008, 0x00000080, 0x00000000, 0x00000001, 0x00000000 },
+	{ 0x0000000D, 0x00000009, 0x00000008, 0x00000A80, 0x00000000, 0x00000000 },
+	{ 0x0000000D, 0x0000000B, 0x00000010, 0x00000000, 0x00000001, 0x00000000 },
+	{ 0x0000000D, 0x0000000C, 0x00000018, 0x00000000, 0x00000001, 0x00000000 },
+	{ 0x0000000D, 0x00000011, 0x00000040, 0x00000AC0, 0x00000002, 0x00000000 },
+	{ 0x0000000D, 0x00000012, 0x00002000, 0x00000B00, 0x00000006, 0x00000000 },
+	{ 0x0000001D, 0x00000000, 0x00000001, 0x00000000, 0x00000000, 0x00000000 },
+	{ 0x0000001D, 0x00000001, 0x04002000, 0x00080040, 0x00000010, 0x00000000 },
+	{ 0x0000001E, 0x00000000, 0x00000000, 0x00004010, 0x00000000, 0x00000000 },
+	{ 0x80000000, 0x00000000, 0x80000008, 0x00000000, 0x00000000, 0x00000000 },
+	{ 0x80000001, 0x00000000, 0x00000000, 0x00000000, 0x00000121, 0x2C100800 },
+	{ 0x80000006, 0x00000000, 0x00000000, 0x00000000, 0x08007040, 0x00000000 },
+	{ 0x80000007, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000100 },
+	{ 0x80000008, 0x00000000, 0x00003934, 0x00000000, 0x00000000, 0x00000000 },
+};
+
+/* XCR0: x87, SSE, AVX, AVX-512, PKRU, and AMX tile state enabled by the OS */
+#define XEON_PLATINUM_8480_XCR0 UINT64_C(0x00000000000602E7)
@@ -0,0 +1,222 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include <sched.h>
+
+
+/* Internal parsers of sysfs cpu lists ("0-3,8") and cpu masks ("00000000,0000010f") */
+extern "C" bool cpuinfo_linux_parse_cpulist(const char* text_start, const char* text_end, cpu_set_t* cpuset);
+extern "C" bool cpuinfo_linux_parse_cpumask(const char* text_start, const char* text_end, cpu_set_t* cpuset);
+
+/* Random sets and mutants per test */
+static const uint32_t iterations = 4096;
+
+/* Chars which change the structure of cpu lists and masks */
+static const char special_chars[] = { ',', '-', ' ', '\n', '0', '9', 'a', 'f', 'F', 'g', '@', '`', '/', ':' };
+
+/* xorshift32 generator, fixed seed keeps failures reproducible */
+class Random {
+public:
+	explicit Random(uint32_t seed) : state(seed) {}
+
+	uint32_t next(uint32_t bound) {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state % bound;
+	}
+
+private:
+	uint32_t state;
+};
+
+/* Sets of runs of consecutive processors, as on real systems, below the given limit */
+static void random_set(Random& random, uint32_t limit, cpu_set_t* cpuset) {
+	CPU_ZERO(cpuset);
+	const uint32_t runs = random.next(16);
+	for (uint32_t run = 0; run < runs; run++) {
+		const uint32_t first = random.next(limit);
+		const uint32_t length = 1 + random.next(std::min<uint32_t>(64, limit - first));
+		for (uint32_t cpu = first; cpu < first + length; cpu++) {
+			CPU_SET(cpu, cpuset);
+		}
+	}
+}
+
+/* Formats a set the way the kernel prints cpu lists */
+static std::string format_cpulist(const cpu_set_t* cpuset) {
+	std::string text;
+	for (uint32_t cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+		if (!CPU_ISSET(cpu, cpuset)) {
+			continue;
+		}
+		uint32_t last = cpu;
+		while (last + 1 < CPU_SETSIZE && CPU_ISSET(last + 1, cpuset)) {
+			last++;
+		}
+		if (!text.empty()) {
+			text += ',';
+		}
+		text += std::to_string(cpu);
+		if (last != cpu) {
+			text += '-' + std::to_string(last);
+		}
+		cpu = last;
+	}
+	return text + '\n';
+}
+
+/* Formats a set the way the kernel prints cpu masks of the given number of processors */
+static std::string format_cpumask(const cpu_set_t* cpuset, uint32_t processors, bool uppercase) {
+	std::string text;
+	const uint32_t groups = (processors + 31) / 32;
+	for (uint32_t group = groups; group-- != 0; ) {
+		uint32_t bits = 0;
+		for (uint32_t bit = 0; bit < 32; bit++) {
+			if (CPU_ISSET(group * 32 + bit, cpuset)) {
+				bits |= UINT32_C(1) << bit;
+			}
+		}
+
+		char digits[16];
+		if (group == groups - 1) {
+			/* The most significant group has only as many digits as needed for the processors */
+			const int width = int((processors - group * 32 + 3) / 4);
+			snprintf(digits, sizeof(digits), uppercase ? "%0*" PRIX32 : "%0*" PRIx32, width, bits);
+		} else {
+			snprintf(digits, sizeof(digits), uppercase ? ",%08" PRIX32 : ",%08" PRIx32, bits);
+		}
+		text += digits;
+	}
+	return text + '\n';
+}
+
+static std::string mutate(const std::string& original, Random& random) {
+	std::string mutant = original;
+	const uint32_t edits = 1 + random.next(4);
+	for (uint32_t edit = 0; edit < edits && !mutant.empty(); edit++) {
+		const size_t position = random.next(uint32_t(mutant.size()));
+		switch (random.next(4)) {
+			case 0:
+				/* Replace a char with a random byte */
+				mutant[position] = char(random.next(256));
+				break;
+			case 1:
+				/* Replace a char with a structural char */
+				mutant[position] = special_chars[random.next(sizeof(special_chars))];
+				break;
+			case 2:
+				/* Insert a run of digits, which may overflow numbers and groups */
+				mutant.insert(position, 1 + random.next(12), char('0' + random.next(10)));
+				break;
+			case 3:
+				/* Erase a range */
+				mutant.erase(position, 1 + random.next(16));
+				break;
+		}
+	}
+	return mutant;
+}
+
+static bool parse_cpulist(const std::string& text, cpu_set_t* cpuset) {
+	CPU_ZERO(cpuset);
+	return cpuinfo_linux_parse_cpulist(text.data(), text.data() + text.size(), cpuset);
+}
+
+static bool parse_cpumask(const std::string& text, cpu_set_t* cpuset) {
+	CPU_ZERO(cpuset);
+	return cpuinfo_linux_parse_cpumask(text.data(), text.data() + text.size(), cpuset);
+}
+
+TEST(CPUMASK, examples) {
+	cpu_set_t cpuset;
+	ASSERT_TRUE(parse_cpumask("f\n", &cpuset));
+	EXPECT_EQ(4, CPU_COUNT(&cpuset));
+	EXPECT_TRUE(CPU_ISSET(3, &cpuset));
+
+	ASSERT_TRUE(parse_cpumask("00000000,00000000,0000ff00\n", &cpuset));
+	EXPECT_EQ(8, CPU_COUNT(&cpuset));
+	EXPECT_TRUE(CPU_ISSET(8, &cpuset));
+	EXPECT_TRUE(CPU_ISSET(15, &cpuset));
+
+	ASSERT_TRUE(parse_cpumask("8,00000000,AbCdEf01", &cpuset));
+	EXPECT_EQ(19, CPU_COUNT(&cpuset));
+	EXPECT_TRUE(CPU_ISSET(0, &cpuset));
+	EXPECT_TRUE(CPU_ISSET(31, &cpuset));
+	EXPECT_TRUE(CPU_ISSET(67, &cpuset));
+
+	EXPECT_FALSE(parse_cpumask("", &cpuset));
+	EXPECT_FALSE(parse_cpumask(" \n", &cpuset));
+	EXPECT_FALSE(parse_cpumask("0x0f", &cpuset));
+	EXPECT_FALSE(parse_cpumask("f,0f", &cpuset));
+	EXPECT_FALSE(parse_cpumask("f,,0000000f", &cpuset));
+	EXPECT_FALSE(parse_cpumask(",0000000f", &cpuset));
+	EXPECT_FALSE(parse_cpumask("000000000f", &cpuset));
+	EXPECT_FALSE(parse_cpumask("0000000g", &cpuset));
+	EXPECT_FALSE(parse_cpumask("0000000@", &cpuset));
+	EXPECT_FALSE(parse_cpumask("0000000`", &cpuset));
+	EXPECT_FALSE(parse_cpumask("0000000:", &cpuset));
+}
+
+TEST(CPUSET, cpulist_and_cpumask_agree) {
+	Random random(UINT32_C(0x9E3779B9));
+	for (uint32_t i = 0; i < iterations; i++) {
+		const uint32_t processors = 1 + random.next(CPU_SETSIZE);
+		cpu_set_t expected;
+		random_set(random, processors, &expected);
+
+		const std::string cpulist = format_cpulist(&expected);
+		cpu_set_t from_cpulist;
+		if (CPU_COUNT(&expected) != 0) {
+			ASSERT_TRUE(parse_cpulist(cpulist, &from_cpulist)) << cpulist;
+			EXPECT_TRUE(CPU_EQUAL(&expected, &from_cpulist)) << cpulist;
+		}
+
+		const std::string cpumask = format_cpumask(&expected, processors, random.next(2) != 0);
+		cpu_set_t from_cpumask;
+		ASSERT_TRUE(parse_cpumask(cpumask, &from_cpumask)) << cpumask;
+		EXPECT_TRUE(CPU_EQUAL(&expected, &from_cpumask)) << cpumask;
+	}
+}
+
+TEST(CPUSET, mutated_cpulists) {
+	Random random(UINT32_C(0x85EBCA6B));
+	for (uint32_t i = 0; i < iterations; i++) {
+		const uint32_t processors = 1 + random.next(CPU_SETSIZE);
+		cpu_set_t original;
+		random_set(random, processors, &original);
+
+		/* Mutants may fail to parse, but must not crash or overflow the set */
+		cpu_set_t cpuset;
+		parse_cpulist(mutate(format_cpulist(&original), random), &cpuset);
+	}
+}
+
+TEST(CPUSET, mutated_cpumasks) {
+	Random random(UINT32_C(0xC2B2AE35));
+	for (uint32_t i = 0; i < iterations; i++) {
+		const uint32_t processors = 1 + random.next(CPU_SETSIZE);
+		cpu_set_t original;
+		random_set(random, processors, &original);
+
+		/* Mutants may fail to parse, but must not crash, and accepted ones must be well-formed */
+		const std::string mutant = mutate(format_cpumask(&original, processors, false), random);
+		cpu_set_t cpuset;
+		if (parse_cpumask(mutant, &cpuset)) {
+			for (char c : mutant) {
+				EXPECT_TRUE(isxdigit(c) || c == ',' || isspace(c)) << mutant;
+			}
+		}
+	}
+}
+
+int main(int argc, char* argv[]) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <cpuinfo-mock.h>
+
+
+/*
+ * Fake sysfs cpu directory in a temporary directory, for tests which pass it to cpuinfo_set_sysfs_cpu_path.
+ * Only the present, possible, and online processor lists are written.
+ */
+static std::string sysfs_path;
+
+/* Creates the temporary directory; returns false on failure */
+static inline bool create_sysfs(const char* test_name) {
+	std::string path_template = std::string("/tmp/") + test_name + "-XXXXXX";
+	if (mkdtemp(&path_template[0]) == nullptr) {
+		perror("mkdtemp");
+		return false;
+	}
+	sysfs_path = path_template;
+	return true;
+}
+
+static inline void write_file(const char* name, const char* contents) {
+	const std::string path = sysfs_path + "/" + name;
+	FILE* file = fopen(path.c_str(), "w");
+	ASSERT_NE(nullptr, file) << path;
+	fputs(contents, file);
+	fclose(file);
+}
+
+static inline void remove_sysfs(void) {
+	for (const char* name : { "present", "possible", "online" }) {
+		unlink((sysfs_path + "/" + name).c_str());
+	}
+	rmdir(sysfs_path.c_str());
+}
+
+/*
+ * Sets the CPUID dump of one Linux processor, with the APIC ID replaced in leaves 0x00000001 and 0x0000000B.
+ * The dump is copied to storage, which must stay alive while the library is initialized.
+ */
+static inline void set_processor_dump(std::vector<cpuinfo_mock_cpuid>& storage, int linux_id,
+	const cpuinfo_mock_cpuid* dump, size_t entries, uint32_t apic_id)
+{
+	storage.assign(dump, dump + entries);
+	for (cpuinfo_mock_cpuid& entry : storage) {
+		if (entry.input_eax == 0x00000001) {
+			entry.ebx = (entry.ebx & UINT32_C(0x00FFFFFF)) | (apic_id << 24);
+		} else if (entry.input_eax == 0x0000000B) {
+			entry.edx = apic_id;
+		}
+	}
+	cpuinfo_set_processor_cpuid(linux_id, storage.data(), storage.size());
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <cpuinfo.h>
+#include <cpuinfo-mock.h>
+
+
+TEST(PROCESSORS, count) {
+	ASSERT_EQ(8, cpuinfo_processors_count);
+}
+
+TEST(PROCESSORS, non_null) {
+	ASSERT_TRUE(cpuinfo_processors);
+}
+
+TEST(PROCESSORS, vendor_qualcomm) {
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		ASSERT_EQ(cpuinfo_vendor_qualcomm, cpuinfo_processors[i].vendor);
+	}
+}
+
+TEST(PROCESSORS, uarch_kryo) {
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		ASSERT_EQ(cpuinfo_uarch_kryo, cpuinfo_processors[i].uarch);
+	}
+}
+
+TEST(PROCESSORS, midr) {
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		switch (i) {
+			case 0:
+			case 1:
+			case 2:
+			case 3:
+				ASSERT_EQ(UINT32_C(0x51AF8014), cpuinfo_processors[i].midr);
+				break;
+			case 4:
+			case 5:
+			case 6:
+			case 7:
+				ASSERT_EQ(UINT32_C(0x51AF8001), cpuinfo_processors[i].midr);
+				break;
+		}
+	}
+}
+
+TEST(PROCESSORS, revidr) {
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		ASSERT_EQ(0, cpuinfo_processors[i].revidr);
+	}
+}
+
+TEST(ISA, aes) {
+	ASSERT_TRUE(cpuinfo_isa.aes);
+}
+
+TEST(ISA, sha1) {
+	ASSERT_TRUE(cpuinfo_isa.sha1);
+}
+
+TEST(ISA, sha2) {
+	ASSERT_TRUE(cpuinfo_isa.sha2);
+}
+
+TEST(ISA, pmull) {
+	ASSERT_TRUE(cpuinfo_isa.pmull);
+}
+
+TEST(ISA, crc32) {
+	ASSERT_TRUE(cpuinfo_isa.crc32);
+}
+
+int main(int argc, char* argv[]) {
+	cpuinfo_set_proc_cpuinfo_path("test/cpuinfo/galaxy-s8-us.log");
+	cpuinfo_set_sysfs_cpu_path("test/sysfs/galaxy-s8-us");
+	cpuinfo_initialize();
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
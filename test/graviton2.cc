@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include <cpuinfo.h>
+#include <cpuinfo-mock.h>
+
+
+TEST(PROCESSORS, count) {
+	ASSERT_EQ(64, cpuinfo_processors_count);
+}
+
+TEST(PROCESSORS, non_null) {
+	ASSERT_TRUE(cpuinfo_processors);
+}
+
+TEST(PROCESSORS, vendor_arm) {
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		ASSERT_EQ(cpuinfo_vendor_arm, cpuinfo_processors[i].vendor);
+	}
+}
+
+TEST(ISA, atomics) {
+	ASSERT_TRUE(cpuinfo_isa.atomics);
+}
+
+TEST(ISA, rdm) {
+	ASSERT_TRUE(cpuinfo_isa.rdm);
+}
+
+TEST(ISA, fp16arith) {
+	ASSERT_TRUE(cpuinfo_isa.fp16arith);
+}
+
+TEST(ISA, fhm) {
+	ASSERT_FALSE(cpuinfo_isa.fhm);
+}
+
+TEST(ISA, dot) {
+	ASSERT_TRUE(cpuinfo_isa.dot);
+}
+
+TEST(ISA, jscvt) {
+	ASSERT_FALSE(cpuinfo_isa.jscvt);
+}
+
+TEST(ISA, fcma) {
+	ASSERT_FALSE(cpuinfo_isa.fcma);
+}
+
+TEST(ISA, lrcpc) {
+	ASSERT_TRUE(cpuinfo_isa.lrcpc);
+}
+
+TEST(ISA, lrcpc2) {
+	ASSERT_FALSE(cpuinfo_isa.lrcpc2);
+}
+
+TEST(ISA, dcpop) {
+	ASSERT_TRUE(cpuinfo_isa.dcpop);
+}
+
+TEST(ISA, dcpodp) {
+	ASSERT_FALSE(cpuinfo_isa.dcpodp);
+}
+
+TEST(ISA, flagm) {
+	ASSERT_FALSE(cpuinfo_isa.flagm);
+}
+
+TEST(ISA, flagm2) {
+	ASSERT_FALSE(cpuinfo_isa.flagm2);
+}
+
+TEST(ISA, frint) {
+	ASSERT_FALSE(cpuinfo_isa.frint);
+}
+
+TEST(ISA, sb) {
+	ASSERT_FALSE(cpuinfo_isa.sb);
+}
+
+TEST(ISA, i8mm) {
+	ASSERT_FALSE(cpuinfo_isa.i8mm);
+}
+
+TEST(ISA, bf16) {
+	ASSERT_FALSE(cpuinfo_isa.bf16);
+}
+
+TEST(ISA, sve) {
+	ASSERT_FALSE(cpuinfo_isa.sve);
+}
+
+TEST(ISA, sve2) {
+	ASSERT_FALSE(cpuinfo_isa.sve2);
+}
+
+TEST(ISA, aes) {
+	ASSERT_TRUE(cpuinfo_isa.aes);
+}
+
+TEST(ISA, sha1) {
+	ASSERT_TRUE(cpuinfo_isa.sha1);
+}
+
+TEST(ISA, sha2) {
+	ASSERT_TRUE(cpuinfo_isa.sha2);
+}
+
+TEST(ISA, sha3) {
+	ASSERT_FALSE(cpuinfo_isa.sha3);
+}
+
+TEST(ISA, sha512) {
+	ASSERT_FALSE(cpuinfo_isa.sha512);
+}
+
+TEST(ISA, sm3) {
+	ASSERT_FALSE(cpuinfo_isa.sm3);
+}
+
+TEST(ISA, sm4) {
+	ASSERT_FALSE(cpuinfo_isa.sm4);
+}
+
+TEST(ISA, pmull) {
+	ASSERT_TRUE(cpuinfo_isa.pmull);
+}
+
+TEST(ISA, crc32) {
+	ASSERT_TRUE(cpuinfo_isa.crc32);
+}
+
+TEST(SVE, no_vector_length) {
+	ASSERT_EQ(0, cpuinfo_get_sve().vector_length);
+	ASSERT_EQ(0, cpuinfo_get_sve_vector_length());
+	ASSERT_EQ(0, cpuinfo_set_sve_vector_length(16, false));
+	ASSERT_EQ(0, cpuinfo_probe_sve_max_vector_length());
+}
+
+TEST(ISA_LEVEL, armv8_2) {
+	ASSERT_EQ(2, cpuinfo_get_armv8_level());
+	ASSERT_STREQ("armv8.2-a", cpuinfo_get_isa_level_name());
+}
+
+int main(int argc, char* argv[]) {
+	cpuinfo_set_proc_cpuinfo_path("test/cpuinfo/graviton2.log");
+	/* AT_HWCAP as reported by the kernel: takes precedence over the Features line of /proc/cpuinfo */
+	cpuinfo_set_hwcap(UINT32_C(0x10119FFF));
+	cpuinfo_set_hwcap2(0);
+	cpuinfo_initialize();
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <cpuinfo.h>
+#include <cpuinfo-mock.h>
+
+#include "cpuid/xeon-gold-6148.h"
+
+
+/* Signatures in ebx, ecx, and edx of the first hypervisor leaf: "KVMKVMKVM\0\0\0" and "Microsoft Hv" */
+#define KVM_SIGNATURE    0x4B4D564B, 0x564B4D56, 0x0000004D
+#define HYPERV_SIGNATURE 0x7263694D, 0x666F736F, 0x76482074
+
+static std::vector<cpuinfo_mock_cpuid> dump;
+
+/* Initializes the library on Xeon Gold 6148, with the hypervisor bit and leaves added if not empty */
+static void initialize(const std::vector<cpuinfo_mock_cpuid>& hypervisor_leaves) {
+	dump.assign(xeon_gold_6148_cpuid, xeon_gold_6148_cpuid + sizeof(xeon_gold_6148_cpuid) / sizeof(cpuinfo_mock_cpuid));
+	if (!hypervisor_leaves.empty()) {
+		for (cpuinfo_mock_cpuid& entry : dump) {
+			if (entry.input_eax == 1) {
+				entry.ecx |= UINT32_C(0x80000000);
+			}
+		}
+		dump.insert(dump.end(), hypervisor_leaves.begin(), hypervisor_leaves.end());
+	}
+	cpuinfo_set_cpuid(dump.data(), dump.size());
+	cpuinfo_set_xcr0(XEON_GOLD_6148_XCR0);
+	cpuinfo_reinitialize();
+}
+
+static uint32_t l1_block(uint32_t smt_threads) {
+	cpuinfo_working_set working_set = { };
+	working_set.element_size = 4;
+	working_set.streams = 1;
+	working_set.reuse = cpuinfo_reuse_temporal;
+	working_set.smt_threads = smt_threads;
+	return cpuinfo_get_blocking(&working_set, 0).l1;
+}
+
+TEST(HYPERVISOR, physical) {
+	initialize({ });
+	const cpuinfo_hypervisor hypervisor = cpuinfo_get_hypervisor();
+	ASSERT_EQ(cpuinfo_hypervisor_vendor_none, hypervisor.vendor);
+	ASSERT_FALSE(hypervisor.steal_time);
+	ASSERT_FALSE(hypervisor.dedicated_processors);
+	ASSERT_TRUE(hypervisor.topology_trusted);
+}
+
+TEST(HYPERVISOR, kvm) {
+	initialize({
+		{ 0x40000000, 0x00000000, 0x40000001, KVM_SIGNATURE },
+		{ 0x40000001, 0x00000000, 0x01007AFB, 0x00000000, 0x00000000, 0x00000000 },
+	});
+	const cpuinfo_hypervisor hypervisor = cpuinfo_get_hypervisor();
+	ASSERT_EQ(cpuinfo_hypervisor_vendor_kvm, hypervisor.vendor);
+	ASSERT_TRUE(hypervisor.steal_time);
+	ASSERT_FALSE(hypervisor.dedicated_processors);
+	ASSERT_FALSE(hypervisor.topology_trusted);
+	/* SMT siblings of a virtual processor are not assumed to be idle */
+	ASSERT_EQ(l1_block(0), l1_block(1));
+}
+
+TEST(HYPERVISOR, kvm_with_hyperv_emulation) {
+	initialize({
+		{ 0x40000000, 0x00000000, 0x4000000B, HYPERV_SIGNATURE },
+		{ 0x40000100, 0x00000000, 0x40000101, KVM_SIGNATURE },
+		{ 0x40000101, 0x00000000, 0x01007AFB, 0x00000000, 0x00000000, 0x00000001 },
+	});
+	const cpuinfo_hypervisor hypervisor = cpuinfo_get_hypervisor();
+	ASSERT_EQ(cpuinfo_hypervisor_vendor_kvm, hypervisor.vendor);
+	ASSERT_TRUE(hypervisor.steal_time);
+	ASSERT_TRUE(hypervisor.dedicated_processors);
+	ASSERT_TRUE(hypervisor.topology_trusted);
+}
+
+TEST(HYPERVISOR, hyperv) {
+	initialize({
+		{ 0x40000000, 0x00000000, 0x4000000B, HYPERV_SIGNATURE },
+	});
+	const cpuinfo_hypervisor hypervisor = cpuinfo_get_hypervisor();
+	ASSERT_EQ(cpuinfo_hypervisor_vendor_hyperv, hypervisor.vendor);
+	ASSERT_FALSE(hypervisor.steal_time);
+	ASSERT_FALSE(hypervisor.topology_trusted);
+}
+
+TEST(HYPERVISOR, unknown) {
+	initialize({
+		{ 0x40000000, 0x00000000, 0x40000001, 0x00000000, 0x00000000, 0x00000000 },
+	});
+	const cpuinfo_hypervisor hypervisor = cpuinfo_get_hypervisor();
+	ASSERT_EQ(cpuinfo_hypervisor_vendor_unknown, hypervisor.vendor);
+	ASSERT_FALSE(hypervisor.topology_trusted);
+}
+
+int main(int argc, char* argv[]) {
+	cpuinfo_set_cpuid(xeon_gold_6148_cpuid, sizeof(xeon_gold_6148_cpuid) / sizeof(cpuinfo_mock_cpuid));
+	cpuinfo_set_xcr0(XEON_GOLD_6148_XCR0);
+	cpuinfo_initialize();
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -1,5 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <vector>
+
+#if defined(__linux__)
+	#include <sched.h>
+#endif
+
 #include <cpuinfo.h>
 
 
@@ -473,6 +479,351 @@ TEST(L4, valid_processors) {
 	}
 }
 
+TEST(BLOCKING, invalid_working_set) {
+	const cpuinfo_working_set working_set = { 0, 1, cpuinfo_reuse_temporal, 0 };
+	const cpuinfo_blocking blocking = cpuinfo_get_blocking(&working_set, 0);
+	ASSERT_EQ(0, blocking.l1);
+	ASSERT_EQ(0, blocking.l2);
+	ASSERT_EQ(0, blocking.l3);
+}
+
+TEST(BLOCKING, invalid_processor) {
+	const cpuinfo_working_set working_set = { 4, 1, cpuinfo_reuse_temporal, 0 };
+	const cpuinfo_blocking blocking = cpuinfo_get_blocking(&working_set, cpuinfo_processors_count);
+	ASSERT_EQ(0, blocking.l1);
+	ASSERT_EQ(0, blocking.l2);
+	ASSERT_EQ(0, blocking.l3);
+}
+
+TEST(BLOCKING, non_zero_l1) {
+	const cpuinfo_working_set working_set = { 8, 3, cpuinfo_reuse_temporal, 0 };
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		const cpuinfo_blocking blocking = cpuinfo_get_blocking(&working_set, i);
+		if (cpuinfo_processors[i].cache.l1d != NULL) {
+			ASSERT_NE(0, blocking.l1);
+		}
+	}
+}
+
+TEST(BLOCKING, increasing_with_level) {
+	const cpuinfo_working_set working_set = { 8, 3, cpuinfo_reuse_temporal, 0 };
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		const cpuinfo_blocking blocking = cpuinfo_get_blocking(&working_set, i);
+		if (blocking.l2 != 0) {
+			ASSERT_LE(blocking.l1, blocking.l2);
+		}
+		if (blocking.l3 != 0) {
+			ASSERT_LE(blocking.l2, blocking.l3);
+		}
+	}
+}
+
+TEST(BLOCKING, single_smt_thread) {
+	const cpuinfo_working_set all_threads = { 4, 2, cpuinfo_reuse_temporal, 0 };
+	const cpuinfo_working_set single_thread = { 4, 2, cpuinfo_reuse_temporal, 1 };
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		const cpuinfo_blocking all_threads_blocking = cpuinfo_get_blocking(&all_threads, i);
+		const cpuinfo_blocking single_thread_blocking = cpuinfo_get_blocking(&single_thread, i);
+		ASSERT_LE(all_threads_blocking.l1, single_thread_blocking.l1);
+		ASSERT_LE(all_threads_blocking.l2, single_thread_blocking.l2);
+		ASSERT_LE(all_threads_blocking.l3, single_thread_blocking.l3);
+	}
+}
+
+TEST(FREQUENCY, min_not_above_max) {
+	cpuinfo_frequency_domains domains = cpuinfo_get_frequency_domains();
+	for (uint32_t k = 0; k < domains.count; k++) {
+		ASSERT_LE(domains.instances[k].min_frequency, domains.instances[k].max_frequency);
+	}
+}
+
+TEST(FREQUENCY, processors_in_domains) {
+	cpuinfo_frequency_domains domains = cpuinfo_get_frequency_domains();
+	uint32_t processors_in_domains = 0;
+	for (uint32_t k = 0; k < domains.count; k++) {
+		ASSERT_NE(0, domains.instances[k].processor_count);
+		processors_in_domains += domains.instances[k].processor_count;
+	}
+	uint32_t processors_with_domain = 0;
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		if (cpuinfo_processors[i].frequency_domain != NULL) {
+			processors_with_domain += 1;
+		}
+	}
+	ASSERT_EQ(processors_in_domains, processors_with_domain);
+}
+
+#if defined(__linux__)
+TEST(FREQUENCY_MONITOR, restart) {
+	const cpuinfo_frequency_source source = cpuinfo_frequency_monitor_start(0);
+	cpuinfo_frequency_monitor_stop();
+	ASSERT_EQ(source, cpuinfo_frequency_monitor_start(0));
+	cpuinfo_frequency_monitor_stop();
+}
+
+TEST(FREQUENCY_MONITOR, invalid_processor) {
+	cpuinfo_frequency_sample sample;
+	ASSERT_FALSE(cpuinfo_get_frequency_sample(cpuinfo_processors_count, &sample));
+}
+#endif
+
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+TEST(TSC, one_second) {
+	const cpuinfo_tsc tsc = cpuinfo_get_tsc();
+	if (tsc.frequency != 0) {
+		ASSERT_NEAR(1000000000.0, (double) cpuinfo_tsc_ticks_to_nanoseconds(tsc.frequency), 1.0);
+	}
+}
+
+TEST(TSC, crystal_below_tsc) {
+	const cpuinfo_tsc tsc = cpuinfo_get_tsc();
+	ASSERT_LE(tsc.crystal_frequency, tsc.frequency);
+}
+#endif
+
+#if CPUINFO_ARCH_X86_64
+TEST(AMX, consistent_with_isa) {
+	const cpuinfo_amx amx = cpuinfo_get_amx();
+	if (cpuinfo_isa.amx_tile) {
+		ASSERT_NE(0, amx.max_palette);
+		ASSERT_NE(0, amx.tiles);
+		ASSERT_EQ(amx.total_tile_bytes, amx.tiles * amx.bytes_per_tile);
+		ASSERT_LE(amx.bytes_per_tile, amx.max_rows * amx.bytes_per_row);
+	} else {
+		ASSERT_EQ(0, amx.max_palette);
+		ASSERT_FALSE(cpuinfo_request_amx_permission());
+	}
+}
+#endif
+
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+TEST(XSAVE, sizes) {
+	const cpuinfo_xsave xsave = cpuinfo_get_xsave();
+	if (xsave.enabled_components != 0) {
+		ASSERT_LE(xsave.enabled_size, xsave.max_size);
+		if (xsave.xsavec) {
+			ASSERT_LE(xsave.compacted_size, xsave.enabled_size);
+		}
+	}
+}
+
+TEST(XSAVE, components_fit) {
+	const cpuinfo_xsave xsave = cpuinfo_get_xsave();
+	for (uint32_t i = 0; i < CPUINFO_XSAVE_MAX_COMPONENTS; i++) {
+		if (xsave.enabled_components & (UINT64_C(1) << i)) {
+			const cpuinfo_xsave_component component = cpuinfo_get_xsave_component(i);
+			ASSERT_NE(0, component.size);
+			ASSERT_LE(component.offset + component.size, xsave.enabled_size);
+			if (xsave.xsavec) {
+				ASSERT_LE(component.compacted_offset + component.size, xsave.compacted_size);
+			}
+		}
+	}
+}
+#endif
+
+#if CPUINFO_ARCH_X86_64
+TEST(ISA_LEVEL, x86_64) {
+	const uint32_t level = cpuinfo_get_x86_64_level();
+	ASSERT_GE(level, 1);
+	ASSERT_LE(level, 4);
+	ASSERT_TRUE(cpuinfo_get_isa_level_name());
+	if (level >= 3) {
+		ASSERT_TRUE(cpuinfo_isa.avx2);
+	}
+}
+#endif
+
+#if CPUINFO_ARCH_ARM64
+TEST(ISA_LEVEL, armv8) {
+	ASSERT_LE(cpuinfo_get_armv8_level(), 6);
+	ASSERT_TRUE(cpuinfo_get_isa_level_name());
+}
+#endif
+
+TEST(UARCH_INFO, unknown) {
+	const cpuinfo_uarch_info info = cpuinfo_get_uarch_info(cpuinfo_uarch_unknown);
+	ASSERT_EQ(0, info.vector_width);
+	ASSERT_EQ(0, info.fma_per_cycle);
+	ASSERT_EQ(0, info.l1d_load_bytes_per_cycle);
+}
+
+TEST(UARCH_INFO, consistent) {
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		const cpuinfo_uarch_info info = cpuinfo_get_uarch_info(cpuinfo_processors[i].uarch);
+		if (info.vector_width != 0) {
+			ASSERT_EQ(0, info.vector_width % 64);
+			ASSERT_GE(info.l1d_load_bytes_per_cycle, info.l1d_store_bytes_per_cycle);
+		}
+	}
+}
+
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+TEST(INSTRUCTION_COST, unknown_uarch) {
+	const cpuinfo_x86_instruction_cost cost =
+		cpuinfo_get_x86_instruction_cost(cpuinfo_uarch_unknown, cpuinfo_x86_instruction_popcnt_r64);
+	ASSERT_EQ(0, cost.latency);
+	ASSERT_EQ(0, cost.reciprocal_throughput);
+}
+
+TEST(INSTRUCTION_COST, invalid_instruction) {
+	const cpuinfo_x86_instruction_cost cost =
+		cpuinfo_get_x86_instruction_cost(cpuinfo_uarch_haswell, cpuinfo_x86_instruction_count);
+	ASSERT_EQ(0, cost.latency);
+	ASSERT_EQ(0, cost.reciprocal_throughput);
+}
+
+TEST(INSTRUCTION_COST, zen_pdep_microcoded) {
+	const cpuinfo_x86_instruction_cost cost =
+		cpuinfo_get_x86_instruction_cost(cpuinfo_uarch_zen, cpuinfo_x86_instruction_pdep_r64);
+	ASSERT_TRUE(cost.microcoded);
+	ASSERT_GT(cost.reciprocal_throughput,
+		cpuinfo_get_x86_instruction_cost(cpuinfo_uarch_haswell, cpuinfo_x86_instruction_pdep_r64).reciprocal_throughput);
+}
+
+TEST(INSTRUCTION_COST, complete_tables) {
+	const cpuinfo_uarch uarchs[] = {
+		cpuinfo_uarch_haswell, cpuinfo_uarch_broadwell, cpuinfo_uarch_sky_lake, cpuinfo_uarch_sky_lake_server,
+		cpuinfo_uarch_zen, cpuinfo_uarch_zen3, cpuinfo_uarch_zen4,
+	};
+	for (cpuinfo_uarch uarch : uarchs) {
+		for (uint32_t i = 0; i < cpuinfo_x86_instruction_count; i++) {
+			const cpuinfo_x86_instruction_cost cost =
+				cpuinfo_get_x86_instruction_cost(uarch, (cpuinfo_x86_instruction) i);
+			if (cost.latency != 0) {
+				ASSERT_NE(0, cost.reciprocal_throughput);
+			}
+		}
+	}
+}
+#endif
+
+TEST(PROCESSORS, consistent_with_globals) {
+	const struct cpuinfo_processors processors = cpuinfo_get_processors();
+	ASSERT_EQ(cpuinfo_processors_count, processors.count);
+	ASSERT_EQ(cpuinfo_processors, processors.instances);
+}
+
+TEST(AVAILABLE_PROCESSORS, non_empty_subset) {
+	const uint32_t count = cpuinfo_get_available_processors(0, nullptr);
+	ASSERT_NE(0, count);
+	ASSERT_LE(count, cpuinfo_processors_count);
+
+	std::vector<uint32_t> processors(count);
+	ASSERT_EQ(count, cpuinfo_get_available_processors(count, processors.data()));
+	for (uint32_t i = 0; i < count; i++) {
+		ASSERT_LT(processors[i], cpuinfo_processors_count);
+		if (i != 0) {
+			ASSERT_GT(processors[i], processors[i - 1]);
+		}
+	}
+}
+
+#if defined(__linux__)
+TEST(AVAILABLE_PROCESSORS, allowed_by_affinity) {
+	cpu_set_t affinity;
+	ASSERT_EQ(0, sched_getaffinity(0, sizeof(affinity), &affinity));
+
+	std::vector<uint32_t> processors(cpuinfo_processors_count);
+	const uint32_t count = cpuinfo_get_available_processors(cpuinfo_processors_count, processors.data());
+	for (uint32_t i = 0; i < count; i++) {
+		ASSERT_TRUE(CPU_ISSET(cpuinfo_processors[processors[i]].topology.linux_id, &affinity));
+	}
+}
+#endif
+
+TEST(EFFECTIVE_PARALLELISM, within_available_processors) {
+	const uint32_t parallelism = cpuinfo_get_effective_parallelism();
+	ASSERT_GE(parallelism, 1);
+	ASSERT_LE(parallelism, cpuinfo_get_available_processors(0, nullptr));
+}
+
+TEST(ROLE_PROCESSORS, latency) {
+	const uint32_t count = cpuinfo_get_role_processors(cpuinfo_thread_role_latency, 0, nullptr);
+	ASSERT_NE(0, count);
+
+	std::vector<uint32_t> processors(count);
+	ASSERT_EQ(count, cpuinfo_get_role_processors(cpuinfo_thread_role_latency, count, processors.data()));
+	for (uint32_t i = 0; i < count; i++) {
+		ASSERT_LT(processors[i], cpuinfo_processors_count);
+	}
+}
+
+TEST(ROLE_PROCESSORS, housekeeping_not_isolated) {
+	std::vector<uint32_t> available(cpuinfo_processors_count);
+	const uint32_t available_count = cpuinfo_get_available_processors(cpuinfo_processors_count, available.data());
+	bool any_not_isolated = false;
+	for (uint32_t i = 0; i < available_count; i++) {
+		any_not_isolated |= cpuinfo_processors[available[i]].isolation == 0;
+	}
+
+	std::vector<uint32_t> processors(cpuinfo_processors_count);
+	const uint32_t count = cpuinfo_get_role_processors(
+		cpuinfo_thread_role_housekeeping, cpuinfo_processors_count, processors.data());
+	ASSERT_NE(0, count);
+	ASSERT_LE(count, available_count);
+	for (uint32_t i = 0; i < count; i++) {
+		if (any_not_isolated) {
+			ASSERT_EQ(0, cpuinfo_processors[processors[i]].isolation);
+		}
+	}
+}
+
+TEST(REINITIALIZE, same_processors) {
+	const struct cpuinfo_processors old_processors = cpuinfo_get_processors();
+	cpuinfo_reinitialize();
+	cpuinfo_reinitialize();
+	const struct cpuinfo_processors new_processors = cpuinfo_get_processors();
+	ASSERT_EQ(old_processors.count, new_processors.count);
+	ASSERT_NE(old_processors.instances, new_processors.instances);
+	ASSERT_EQ(cpuinfo_processors, new_processors.instances);
+
+	/* Tables of previous initializations stay valid until de-initialization */
+	for (uint32_t i = 0; i < new_processors.count; i++) {
+		ASSERT_EQ(old_processors.instances[i].topology.linux_id, new_processors.instances[i].topology.linux_id);
+		ASSERT_EQ(old_processors.instances[i].uarch, new_processors.instances[i].uarch);
+	}
+}
+
+TEST(REINITIALIZE, caches_of_new_tables) {
+	cpuinfo_reinitialize();
+	const struct cpuinfo_processors processors = cpuinfo_get_processors();
+	const cpuinfo_caches l1d = cpuinfo_get_l1d_cache();
+	for (uint32_t i = 0; i < processors.count; i++) {
+		if (processors.instances[i].cache.l1d != nullptr) {
+			ASSERT_GE(processors.instances[i].cache.l1d, l1d.instances);
+			ASSERT_LT(processors.instances[i].cache.l1d, l1d.instances + l1d.count);
+		}
+	}
+}
+
+TEST(DEINITIALIZE, releases_tables) {
+	const uint32_t processors_count = cpuinfo_get_processors().count;
+	cpuinfo_deinitialize();
+	ASSERT_EQ(0, cpuinfo_get_processors().count);
+	ASSERT_EQ(nullptr, cpuinfo_get_processors().instances);
+	ASSERT_EQ(0, cpuinfo_get_l1d_cache().count);
+	ASSERT_EQ(nullptr, cpuinfo_processors);
+	ASSERT_EQ(0, cpuinfo_processors_count);
+
+	/* Initialization after de-initialization detects the system again */
+	cpuinfo_initialize();
+	ASSERT_EQ(processors_count, cpuinfo_get_processors().count);
+	ASSERT_EQ(processors_count, cpuinfo_processors_count);
+}
+
+#if defined(__linux__)
+TEST(DEINITIALIZE, stops_frequency_monitor) {
+	cpuinfo_frequency_monitor_start(0);
+	cpuinfo_deinitialize();
+	ASSERT_FALSE(cpuinfo_frequency_monitor_sample());
+
+	cpuinfo_initialize();
+	cpuinfo_frequency_sample sample;
+	ASSERT_FALSE(cpuinfo_get_frequency_sample(0, &sample));
+}
+#endif
+
 int main(int argc, char* argv[]) {
 	cpuinfo_initialize();
 	::testing::InitGoogleTest(&argc, argv);
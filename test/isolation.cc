@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+
+#include <cpuinfo.h>
+#include <cpuinfo-mock.h>
+
+
+/* Internal entry point, which sets isolation flags of processors by their Linux IDs */
+extern "C" void cpuinfo_linux_detect_isolation(uint32_t processors_count, struct cpuinfo_processor* processors);
+
+static const uint32_t processors_count = 8;
+
+/*
+ * Each fake system is found relative to the source root, and the test must run from it.
+ * The "cmdline" file replaces /proc/cmdline, and the "sysfs" directory replaces /sys/devices/system/cpu.
+ */
+static void detect(const char* system, struct cpuinfo_processor processors[]) {
+	const std::string path = std::string("test/isolation/") + system;
+	cpuinfo_set_proc_cmdline_path((path + "/cmdline").c_str());
+	cpuinfo_set_sysfs_cpu_path((path + "/sysfs").c_str());
+	for (uint32_t i = 0; i < processors_count; i++) {
+		processors[i] = cpuinfo_processor();
+		processors[i].topology.linux_id = int(i);
+	}
+	cpuinfo_linux_detect_isolation(processors_count, processors);
+}
+
+TEST(ISOLATION, isolcpus) {
+	struct cpuinfo_processor processors[processors_count];
+	detect("isolcpus", processors);
+	for (uint32_t i = 0; i < processors_count; i++) {
+		uint32_t expected_isolation = 0;
+		if (i >= 2 && i <= 5) {
+			expected_isolation |= CPUINFO_ISOLATION_DOMAIN | CPUINFO_ISOLATION_NOHZ_FULL;
+		}
+		if (i >= 2) {
+			/* rcu_nocb_poll is a different parameter */
+			expected_isolation |= CPUINFO_ISOLATION_RCU_NOCBS;
+		}
+		ASSERT_EQ(expected_isolation, processors[i].isolation) << "processor " << i;
+	}
+}
+
+TEST(ISOLATION, none) {
+	struct cpuinfo_processor processors[processors_count];
+	detect("none", processors);
+	for (uint32_t i = 0; i < processors_count; i++) {
+		ASSERT_EQ(0, processors[i].isolation) << "processor " << i;
+	}
+}
+
+TEST(ISOLATION, rcu_nocbs_all) {
+	struct cpuinfo_processor processors[processors_count];
+	detect("rcu-nocbs-all", processors);
+	/* The last occurrence of the parameter takes effect, and without a value it applies to all processors */
+	for (uint32_t i = 0; i < processors_count; i++) {
+		ASSERT_EQ(CPUINFO_ISOLATION_RCU_NOCBS, processors[i].isolation) << "processor " << i;
+	}
+}
+
+TEST(ISOLATION, missing) {
+	struct cpuinfo_processor processors[processors_count];
+	detect("missing", processors);
+	for (uint32_t i = 0; i < processors_count; i++) {
+		ASSERT_EQ(0, processors[i].isolation) << "processor " << i;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <unistd.h>
+
 #include <cpuinfo.h>
 #include <cpuinfo-mock.h>
 
@@ -332,8 +334,124 @@ TEST(L4, none) {
 	ASSERT_FALSE(l4.instances);
 }
 
+TEST(BLOCKING, temporal) {
+	const cpuinfo_working_set working_set = { 4, 2, cpuinfo_reuse_temporal, 0 };
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		const cpuinfo_blocking blocking = cpuinfo_get_blocking(&working_set, i);
+		ASSERT_EQ(2048, blocking.l1);
+		ASSERT_EQ(61440, blocking.l2);
+		ASSERT_EQ(0, blocking.l3);
+	}
+}
+
+TEST(FREQUENCY, domains) {
+	cpuinfo_frequency_domains domains = cpuinfo_get_frequency_domains();
+	ASSERT_EQ(1, domains.count);
+	ASSERT_EQ(4, domains.instances[0].processor_count);
+}
+
+TEST(FREQUENCY, shared_domain) {
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		ASSERT_EQ(cpuinfo_get_frequency_domains().instances, cpuinfo_processors[i].frequency_domain);
+	}
+}
+
+TEST(FREQUENCY, min_frequency) {
+	ASSERT_EQ(UINT64_C(102000000), cpuinfo_get_frequency_domains().instances[0].min_frequency);
+}
+
+TEST(FREQUENCY, max_frequency) {
+	ASSERT_EQ(UINT64_C(1912500000), cpuinfo_get_frequency_domains().instances[0].max_frequency);
+}
+
+TEST(FREQUENCY, base_frequency) {
+	ASSERT_EQ(0, cpuinfo_get_frequency_domains().instances[0].base_frequency);
+}
+
+TEST(FREQUENCY_MONITOR, cpufreq_source) {
+	ASSERT_EQ(cpuinfo_frequency_source_cpufreq, cpuinfo_frequency_monitor_start(0));
+	cpuinfo_frequency_monitor_stop();
+}
+
+TEST(FREQUENCY_MONITOR, manual_sampling) {
+	ASSERT_EQ(cpuinfo_frequency_source_cpufreq, cpuinfo_frequency_monitor_start(0));
+	ASSERT_TRUE(cpuinfo_frequency_monitor_sample());
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		cpuinfo_frequency_sample sample;
+		ASSERT_TRUE(cpuinfo_get_frequency_sample(i, &sample));
+		ASSERT_EQ(UINT64_C(1734000000), sample.frequency);
+		ASSERT_NE(0, sample.timestamp);
+	}
+	cpuinfo_frequency_monitor_stop();
+}
+
+TEST(FREQUENCY_MONITOR, history) {
+	ASSERT_EQ(cpuinfo_frequency_source_cpufreq, cpuinfo_frequency_monitor_start(0));
+	for (uint32_t k = 0; k < 2 * CPUINFO_FREQUENCY_MONITOR_HISTORY; k++) {
+		ASSERT_TRUE(cpuinfo_frequency_monitor_sample());
+	}
+	cpuinfo_frequency_monitor_stop();
+
+	cpuinfo_frequency_sample samples[2 * CPUINFO_FREQUENCY_MONITOR_HISTORY];
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		const uint32_t count = cpuinfo_get_frequency_history(i, samples, 2 * CPUINFO_FREQUENCY_MONITOR_HISTORY);
+		ASSERT_EQ(CPUINFO_FREQUENCY_MONITOR_HISTORY, count);
+		for (uint32_t k = 1; k < count; k++) {
+			ASSERT_GE(samples[k - 1].timestamp, samples[k].timestamp);
+		}
+	}
+}
+
+TEST(FREQUENCY_MONITOR, background_sampling) {
+	ASSERT_EQ(cpuinfo_frequency_source_cpufreq, cpuinfo_frequency_monitor_start(1000));
+	/* Manual sampling is not allowed while the background thread writes samples */
+	ASSERT_FALSE(cpuinfo_frequency_monitor_sample());
+
+	cpuinfo_frequency_sample before, after;
+	ASSERT_TRUE(cpuinfo_get_frequency_sample(0, &before));
+	for (uint32_t attempt = 0; attempt < 1000; attempt++) {
+		usleep(1000);
+		ASSERT_TRUE(cpuinfo_get_frequency_sample(0, &after));
+		if (after.timestamp != before.timestamp) {
+			break;
+		}
+	}
+	cpuinfo_frequency_monitor_stop();
+	ASSERT_GT(after.timestamp, before.timestamp);
+	ASSERT_EQ(UINT64_C(1734000000), after.frequency);
+}
+
+TEST(FREQUENCY_MONITOR, reinitialize) {
+	ASSERT_EQ(cpuinfo_frequency_source_cpufreq, cpuinfo_frequency_monitor_start(0));
+	ASSERT_TRUE(cpuinfo_frequency_monitor_sample());
+	cpuinfo_frequency_monitor_stop();
+
+	/* Samples are indexed by processors of the tables which were published when the monitor started */
+	cpuinfo_reinitialize();
+	cpuinfo_frequency_sample sample;
+	ASSERT_FALSE(cpuinfo_get_frequency_sample(0, &sample));
+
+	/* Only the sample taken by the restart is reported */
+	ASSERT_EQ(cpuinfo_frequency_source_cpufreq, cpuinfo_frequency_monitor_start(0));
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		cpuinfo_frequency_sample samples[CPUINFO_FREQUENCY_MONITOR_HISTORY];
+		ASSERT_EQ(1, cpuinfo_get_frequency_history(i, samples, CPUINFO_FREQUENCY_MONITOR_HISTORY));
+	}
+	cpuinfo_frequency_monitor_stop();
+}
+
+TEST(UARCH_INFO, cortex_a57) {
+	const cpuinfo_uarch_info info = cpuinfo_get_uarch_info(cpuinfo_processors[0].uarch);
+	ASSERT_EQ(128, info.vector_width);
+	ASSERT_EQ(1, info.fma_per_cycle);
+	ASSERT_EQ(16, info.l1d_load_bytes_per_cycle);
+	ASSERT_FALSE(info.split_wide_vectors);
+	ASSERT_FALSE(info.wide_vector_throttling);
+}
+
 int main(int argc, char* argv[]) {
 	cpuinfo_set_proc_cpuinfo_path("test/cpuinfo/jetson-tx1.log");
+	cpuinfo_set_sysfs_cpu_path("test/sysfs/jetson-tx1");
 	cpuinfo_initialize();
 	::testing::InitGoogleTest(&argc, argv);
 	return RUN_ALL_TESTS();
@@ -308,8 +308,38 @@ TEST(L4, none) {
 	ASSERT_FALSE(l4.instances);
 }
 
+TEST(FREQUENCY, domains) {
+	/* Krait cores scale frequency independently */
+	cpuinfo_frequency_domains domains = cpuinfo_get_frequency_domains();
+	ASSERT_EQ(4, domains.count);
+	for (uint32_t k = 0; k < domains.count; k++) {
+		ASSERT_EQ(1, domains.instances[k].processor_count);
+	}
+}
+
+TEST(FREQUENCY, private_domain) {
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		ASSERT_EQ(&cpuinfo_get_frequency_domains().instances[i], cpuinfo_processors[i].frequency_domain);
+	}
+}
+
+TEST(FREQUENCY, min_frequency) {
+	cpuinfo_frequency_domains domains = cpuinfo_get_frequency_domains();
+	for (uint32_t k = 0; k < domains.count; k++) {
+		ASSERT_EQ(UINT64_C(300000000), domains.instances[k].min_frequency);
+	}
+}
+
+TEST(FREQUENCY, max_frequency) {
+	cpuinfo_frequency_domains domains = cpuinfo_get_frequency_domains();
+	for (uint32_t k = 0; k < domains.count; k++) {
+		ASSERT_EQ(UINT64_C(2265600000), domains.instances[k].max_frequency);
+	}
+}
+
 int main(int argc, char* argv[]) {
 	cpuinfo_set_proc_cpuinfo_path("test/cpuinfo/nexus5.log");
+	cpuinfo_set_sysfs_cpu_path("test/sysfs/nexus5");
 	cpuinfo_initialize();
 	::testing::InitGoogleTest(&argc, argv);
 	return RUN_ALL_TESTS();
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+
+#include <sched.h>
+#include <unistd.h>
+
+#include <cpuinfo.h>
+#include <cpuinfo-mock.h>
+
+#include "cpuid/xeon-gold-6148.h"
+#include "fake-sysfs.h"
+
+
+/*
+ * Fake sysfs cpu directory: two Linux CPUs are present, and only the first one is online at initialization.
+ * The first CPU is the one the test can run on, the second one is hot-added later.
+ */
+static int first_cpu = 0;
+
+static void write_cpus(const char* name, bool first, bool second) {
+	std::string cpus;
+	if (first) {
+		cpus = std::to_string(first_cpu);
+	}
+	if (second) {
+		cpus += (first ? "," : "") + std::to_string(first_cpu + 1);
+	}
+	write_file(name, (cpus + "\n").c_str());
+}
+
+static int first_allowed_cpu(void) {
+	cpu_set_t affinity;
+	if (sched_getaffinity(0, sizeof(affinity), &affinity) == 0) {
+		for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+			if (CPU_ISSET(cpu, &affinity)) {
+				return cpu;
+			}
+		}
+	}
+	return 0;
+}
+
+TEST(ONLINE, offline_processors_skipped) {
+	ASSERT_EQ(1, cpuinfo_get_processors().count);
+	ASSERT_TRUE(cpuinfo_is_processor_online(0));
+	ASSERT_FALSE(cpuinfo_is_processor_online(1));
+}
+
+TEST(ONLINE, unchanged) {
+	const uint32_t generation = cpuinfo_get_generation();
+	ASSERT_FALSE(cpuinfo_update_online_processors());
+	ASSERT_EQ(generation, cpuinfo_get_generation());
+	ASSERT_TRUE(cpuinfo_is_processor_online(0));
+}
+
+TEST(ONLINE, processor_offline) {
+	const uint32_t generation = cpuinfo_get_generation();
+	write_cpus("online", false, true);
+	ASSERT_TRUE(cpuinfo_update_online_processors());
+	ASSERT_NE(generation, cpuinfo_get_generation());
+	ASSERT_FALSE(cpuinfo_is_processor_online(0));
+
+	write_cpus("online", true, false);
+	ASSERT_TRUE(cpuinfo_update_online_processors());
+	ASSERT_TRUE(cpuinfo_is_processor_online(0));
+}
+
+TEST(ONLINE, untracked_processor_online) {
+	const uint32_t generation = cpuinfo_get_generation();
+	write_cpus("online", true, true);
+	ASSERT_TRUE(cpuinfo_update_online_processors());
+	ASSERT_NE(generation, cpuinfo_get_generation());
+	/* Hot-added processors are detected only by re-initialization */
+	ASSERT_EQ(1, cpuinfo_get_processors().count);
+	ASSERT_FALSE(cpuinfo_update_online_processors());
+
+	write_cpus("online", true, false);
+	ASSERT_TRUE(cpuinfo_update_online_processors());
+}
+
+TEST(ONLINE, watcher) {
+	ASSERT_TRUE(cpuinfo_online_watcher_start(1000));
+	ASSERT_FALSE(cpuinfo_online_watcher_start(1000));
+
+	const uint32_t generation = cpuinfo_get_generation();
+	write_cpus("online", false, true);
+	for (uint32_t i = 0; i < 1000 && cpuinfo_get_generation() == generation; i++) {
+		usleep(1000);
+	}
+	cpuinfo_online_watcher_stop();
+	ASSERT_NE(generation, cpuinfo_get_generation());
+	ASSERT_FALSE(cpuinfo_is_processor_online(0));
+
+	write_cpus("online", true, false);
+	ASSERT_TRUE(cpuinfo_update_online_processors());
+}
+
+TEST(ONLINE, watcher_stops_before_period) {
+	ASSERT_TRUE(cpuinfo_online_watcher_start(60000000));
+	const time_t start = time(nullptr);
+	cpuinfo_online_watcher_stop();
+	ASSERT_LT(time(nullptr) - start, 10);
+}
+
+TEST(ONLINE, reinitialize) {
+	const uint32_t generation = cpuinfo_get_generation();
+	cpuinfo_reinitialize();
+	ASSERT_NE(generation, cpuinfo_get_generation());
+	ASSERT_TRUE(cpuinfo_is_processor_online(0));
+}
+
+int main(int argc, char* argv[]) {
+	if (!create_sysfs("online-test")) {
+		return EXIT_FAILURE;
+	}
+
+	first_cpu = first_allowed_cpu();
+	write_cpus("present", true, true);
+	write_cpus("possible", true, true);
+	write_cpus("online", true, false);
+
+	cpuinfo_set_sysfs_cpu_path(sysfs_path.c_str());
+	cpuinfo_set_cpuid(xeon_gold_6148_cpuid, sizeof(xeon_gold_6148_cpuid) / sizeof(cpuinfo_mock_cpuid));
+	cpuinfo_set_xcr0(XEON_GOLD_6148_XCR0);
+	cpuinfo_initialize();
+	::testing::InitGoogleTest(&argc, argv);
+	const int result = RUN_ALL_TESTS();
+
+	remove_sysfs();
+	return result;
+}
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <cpuinfo.h>
+#include <cpuinfo-mock.h>
+
+
+/* Internal parser entry point. The parsed records are opaque to the test. */
+extern "C" struct proc_cpuinfo* cpuinfo_arm_linux_parse_proc_cpuinfo(uint32_t* processors_count);
+
+/* Logs are found relative to the source root, and the test must run from it */
+static const char* const logs[] = {
+	"test/cpuinfo/arndaleboard.log",
+	"test/cpuinfo/beagleboard-xm.log",
+	"test/cpuinfo/galaxy-nexus.log",
+	"test/cpuinfo/galaxy-s8-us.log",
+	"test/cpuinfo/graviton2.log",
+	"test/cpuinfo/graviton3.log",
+	"test/cpuinfo/jetson-tx1.log",
+	"test/cpuinfo/msm8996.log",
+	"test/cpuinfo/nexus-s.log",
+	"test/cpuinfo/nexus4.log",
+	"test/cpuinfo/nexus5.log",
+	"test/cpuinfo/nexus9.log",
+	"test/cpuinfo/odroid-u2.log",
+	"test/cpuinfo/pandaboard-es.log",
+	"test/cpuinfo/raspberrypi.log",
+	"test/cpuinfo/raspberrypi2.log",
+	"test/cpuinfo/raspberrypi3.log",
+	"test/cpuinfo/scaleway.log",
+};
+
+/* Mutants per log */
+static const uint32_t mutations = 256;
+
+/* Chars which change the structure of /proc/cpuinfo */
+static const char special_chars[] = { ' ', '\t', '\n', ':', '\0', '0', '9', 'x', 'f' };
+
+/* xorshift32 generator, fixed seed keeps failures reproducible */
+class Random {
+public:
+	explicit Random(uint32_t seed) : state(seed) {}
+
+	uint32_t next(uint32_t bound) {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state % bound;
+	}
+
+private:
+	uint32_t state;
+};
+
+static std::string read_log(const char* path) {
+	std::string contents;
+	FILE* file = fopen(path, "rb");
+	if (file != nullptr) {
+		char buffer[4096];
+		size_t bytes_read;
+		while ((bytes_read = fread(buffer, 1, sizeof(buffer), file)) != 0) {
+			contents.append(buffer, bytes_read);
+		}
+		fclose(file);
+	}
+	return contents;
+}
+
+static std::string mutate(const std::string& original, Random& random) {
+	std::string mutant = original;
+	const uint32_t edits = 1 + random.next(8);
+	for (uint32_t edit = 0; edit < edits && !mutant.empty(); edit++) {
+		const size_t position = random.next(uint32_t(mutant.size()));
+		switch (random.next(5)) {
+			case 0:
+				/* Replace a char with a random byte */
+				mutant[position] = char(random.next(256));
+				break;
+			case 1:
+				/* Replace a char with a structural char */
+				mutant[position] = special_chars[random.next(sizeof(special_chars))];
+				break;
+			case 2:
+				/* Insert a run of spaces, e.g. between feature names */
+				mutant.insert(position, 1 + random.next(32), ' ');
+				break;
+			case 3:
+				/* Erase a range, which may join lines or names */
+				mutant.erase(position, 1 + random.next(64));
+				break;
+			case 4:
+				/* Truncate */
+				mutant.resize(position);
+				break;
+		}
+	}
+	return mutant;
+}
+
+class ProcCpuInfoFuzz : public ::testing::Test {
+protected:
+	void SetUp() override {
+		char path_template[] = "/tmp/proc-cpuinfo-fuzz-XXXXXX";
+		const int file = mkstemp(path_template);
+		ASSERT_NE(-1, file);
+		close(file);
+		path = path_template;
+		cpuinfo_set_proc_cpuinfo_path(path.c_str());
+	}
+
+	void TearDown() override {
+		if (!path.empty()) {
+			unlink(path.c_str());
+		}
+	}
+
+	void write(const std::string& contents) {
+		FILE* file = fopen(path.c_str(), "wb");
+		ASSERT_NE(nullptr, file);
+		ASSERT_EQ(contents.size(), fwrite(contents.data(), 1, contents.size(), file));
+		fclose(file);
+	}
+
+	std::string path;
+};
+
+TEST_F(ProcCpuInfoFuzz, original_logs) {
+	for (const char* log : logs) {
+		const std::string contents = read_log(log);
+		ASSERT_FALSE(contents.empty()) << log;
+		write(contents);
+
+		uint32_t processors_count = 0;
+		struct proc_cpuinfo* processors = cpuinfo_arm_linux_parse_proc_cpuinfo(&processors_count);
+		ASSERT_NE(nullptr, processors) << log;
+		ASSERT_NE(0, processors_count) << log;
+		free(processors);
+	}
+}
+
+TEST_F(ProcCpuInfoFuzz, mutated_logs) {
+	Random random(UINT32_C(0x9E3779B9));
+	for (const char* log : logs) {
+		const std::string contents = read_log(log);
+		ASSERT_FALSE(contents.empty()) << log;
+		for (uint32_t i = 0; i < mutations; i++) {
+			write(mutate(contents, random));
+
+			/* Mutants may fail to parse, but must not crash or leak */
+			uint32_t processors_count = 0;
+			struct proc_cpuinfo* processors = cpuinfo_arm_linux_parse_proc_cpuinfo(&processors_count);
+			if (processors != nullptr) {
+				ASSERT_NE(0, processors_count) << log << " mutant " << i;
+			}
+			free(processors);
+		}
+	}
+}
+
+TEST_F(ProcCpuInfoFuzz, long_names) {
+	/* Names at the end of the file, and names longer than any known one */
+	write("processor\t: 0\nFeatures\t: fp asimd " + std::string(100, 'a') + " evtstrm");
+	uint32_t processors_count = 0;
+	struct proc_cpuinfo* processors = cpuinfo_arm_linux_parse_proc_cpuinfo(&processors_count);
+	free(processors);
+
+	write(std::string(100, 'K') + "\t: 0\nprocessor\t: 0\nFeatures\t: f");
+	processors = cpuinfo_arm_linux_parse_proc_cpuinfo(&processors_count);
+	free(processors);
+}
+
+int main(int argc, char* argv[]) {
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -308,6 +308,14 @@ TEST(L4, none) {
 	ASSERT_FALSE(l4.instances);
 }
 
+TEST(UARCH_INFO, cortex_a53) {
+	const cpuinfo_uarch_info info = cpuinfo_get_uarch_info(cpuinfo_processors[0].uarch);
+	ASSERT_EQ(64, info.vector_width);
+	ASSERT_EQ(1, info.fma_per_cycle);
+	ASSERT_EQ(8, info.l1d_load_bytes_per_cycle);
+	ASSERT_TRUE(info.split_wide_vectors);
+}
+
 int main(int argc, char* argv[]) {
 	cpuinfo_set_proc_cpuinfo_path("test/cpuinfo/raspberrypi3.log");
 	cpuinfo_initialize();
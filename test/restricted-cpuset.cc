@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <cpuinfo.h>
+#include <cpuinfo-mock.h>
+
+#include "cpuid/xeon-gold-6148.h"
+#include "fake-sysfs.h"
+
+
+/*
+ * A fake sysfs cpu directory lists four online processors, each with a CPUID dump of its own,
+ * and the fake cgroup of the process (test/cgroup/v2-host-path) allows only Linux CPU 2.
+ * The test must run from the source root.
+ */
+#define SYSFS_PROCESSORS 4
+#define ALLOWED_PROCESSOR 2
+
+static std::vector<cpuinfo_mock_cpuid> dumps[SYSFS_PROCESSORS];
+
+TEST(PROCESSORS, only_allowed) {
+	const struct cpuinfo_processors processors = cpuinfo_get_processors();
+	ASSERT_EQ(1, processors.count);
+	ASSERT_EQ(ALLOWED_PROCESSOR, processors.instances[0].topology.linux_id);
+	ASSERT_EQ(ALLOWED_PROCESSOR, processors.instances[0].topology.apic_id);
+}
+
+TEST(PROCESSORS, caches) {
+	const struct cpuinfo_processors processors = cpuinfo_get_processors();
+	ASSERT_NE(nullptr, processors.instances[0].cache.l1d);
+	ASSERT_NE(nullptr, processors.instances[0].cache.l2);
+	ASSERT_EQ(1, cpuinfo_get_l1d_cache().count);
+}
+
+TEST(PROCESSORS, reinitialize) {
+	cpuinfo_reinitialize();
+	ASSERT_EQ(1, cpuinfo_get_processors().count);
+	ASSERT_EQ(ALLOWED_PROCESSOR, cpuinfo_get_processors().instances[0].topology.linux_id);
+}
+
+int main(int argc, char* argv[]) {
+	if (!create_sysfs("restricted-cpuset-test")) {
+		return EXIT_FAILURE;
+	}
+	for (const char* name : { "present", "possible", "online" }) {
+		write_file(name, "0-3\n");
+	}
+
+	for (int i = 0; i < SYSFS_PROCESSORS; i++) {
+		set_processor_dump(dumps[i], i, xeon_gold_6148_cpuid,
+			sizeof(xeon_gold_6148_cpuid) / sizeof(cpuinfo_mock_cpuid), (uint32_t) i);
+	}
+	cpuinfo_set_sysfs_cpu_path(sysfs_path.c_str());
+	cpuinfo_set_proc_self_cgroup_path("test/cgroup/v2-host-path/cgroup");
+	cpuinfo_set_cgroup_path("test/cgroup/v2-host-path/fs");
+	cpuinfo_set_cpuid(xeon_gold_6148_cpuid, sizeof(xeon_gold_6148_cpuid) / sizeof(cpuinfo_mock_cpuid));
+	cpuinfo_set_xcr0(XEON_GOLD_6148_XCR0);
+	cpuinfo_initialize();
+	::testing::InitGoogleTest(&argc, argv);
+	const int result = RUN_ALL_TESTS();
+
+	remove_sysfs();
+	return result;
+}
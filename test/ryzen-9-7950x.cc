@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <cpuinfo.h>
+#include <cpuinfo-mock.h>
+
+#include "cpuid/ryzen-9-7950x.h"
+
+
+TEST(PROCESSORS, non_null) {
+	ASSERT_TRUE(cpuinfo_processors);
+}
+
+TEST(PROCESSORS, vendor_amd) {
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		ASSERT_EQ(cpuinfo_vendor_amd, cpuinfo_processors[i].vendor);
+	}
+}
+
+TEST(PROCESSORS, uarch_zen4) {
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		ASSERT_EQ(cpuinfo_uarch_zen4, cpuinfo_processors[i].uarch);
+	}
+}
+
+TEST(L2, inclusive) {
+	cpuinfo_caches l2 = cpuinfo_get_l2_cache();
+	ASSERT_NE(0, l2.count);
+	for (uint32_t k = 0; k < l2.count; k++) {
+		ASSERT_EQ(1048576, l2.instances[k].size);
+		ASSERT_TRUE(l2.instances[k].flags & CPUINFO_CACHE_INCLUSIVE);
+		ASSERT_FALSE(l2.instances[k].flags & CPUINFO_CACHE_EXCLUSIVE);
+	}
+}
+
+TEST(L3, exclusive) {
+	cpuinfo_caches l3 = cpuinfo_get_l3_cache();
+	ASSERT_NE(0, l3.count);
+	for (uint32_t k = 0; k < l3.count; k++) {
+		ASSERT_EQ(33554432, l3.instances[k].size);
+		/* Victim cache of L2 */
+		ASSERT_TRUE(l3.instances[k].flags & CPUINFO_CACHE_EXCLUSIVE);
+	}
+}
+
+TEST(ISA, avx2) {
+	ASSERT_TRUE(cpuinfo_isa.avx2);
+}
+
+TEST(ISA, avx512f) {
+	ASSERT_TRUE(cpuinfo_isa.avx512f);
+}
+
+TEST(ISA, avx512vl) {
+	ASSERT_TRUE(cpuinfo_isa.avx512vl);
+}
+
+TEST(ISA, avx512vbmi) {
+	ASSERT_TRUE(cpuinfo_isa.avx512vbmi);
+}
+
+TEST(ISA, avx512vbmi2) {
+	ASSERT_TRUE(cpuinfo_isa.avx512vbmi2);
+}
+
+TEST(ISA, avx512bitalg) {
+	ASSERT_TRUE(cpuinfo_isa.avx512bitalg);
+}
+
+TEST(ISA, avx512vnni) {
+	ASSERT_TRUE(cpuinfo_isa.avx512vnni);
+}
+
+TEST(ISA, avx512bf16) {
+	ASSERT_TRUE(cpuinfo_isa.avx512bf16);
+}
+
+TEST(ISA, avx_vnni) {
+	ASSERT_FALSE(cpuinfo_isa.avx_vnni);
+}
+
+TEST(ISA, gfni) {
+	ASSERT_TRUE(cpuinfo_isa.gfni);
+}
+
+TEST(ISA, vaes) {
+	ASSERT_TRUE(cpuinfo_isa.vaes);
+}
+
+TEST(ISA, vpclmulqdq) {
+	ASSERT_TRUE(cpuinfo_isa.vpclmulqdq);
+}
+
+TEST(ISA, no_amx) {
+	ASSERT_FALSE(cpuinfo_isa.amx_tile);
+	ASSERT_FALSE(cpuinfo_isa.amx_int8);
+	ASSERT_FALSE(cpuinfo_isa.amx_bf16);
+}
+
+TEST(AMX, not_supported) {
+	ASSERT_EQ(0, cpuinfo_get_amx().max_palette);
+	ASSERT_EQ(0, cpuinfo_get_amx().tiles);
+	ASSERT_FALSE(cpuinfo_request_amx_permission());
+}
+
+TEST(ISA_LEVEL, x86_64_v4) {
+	ASSERT_EQ(4, cpuinfo_get_x86_64_level());
+	ASSERT_STREQ("x86-64-v4", cpuinfo_get_isa_level_name());
+}
+
+TEST(INSTRUCTION_COST, pdep_not_microcoded) {
+	const cpuinfo_x86_instruction_cost cost =
+		cpuinfo_get_x86_instruction_cost(cpuinfo_processors[0].uarch, cpuinfo_x86_instruction_pdep_r64);
+	ASSERT_EQ(3, cost.latency);
+	ASSERT_EQ(100, cost.reciprocal_throughput);
+	ASSERT_FALSE(cost.microcoded);
+}
+
+TEST(INSTRUCTION_COST, vpermb_zmm) {
+	const cpuinfo_x86_instruction_cost cost =
+		cpuinfo_get_x86_instruction_cost(cpuinfo_processors[0].uarch, cpuinfo_x86_instruction_vpermb_zmm);
+	ASSERT_NE(0, cost.latency);
+	ASSERT_NE(0, cost.reciprocal_throughput);
+}
+
+int main(int argc, char* argv[]) {
+	cpuinfo_set_cpuid(ryzen_9_7950x_cpuid, sizeof(ryzen_9_7950x_cpuid) / sizeof(cpuinfo_mock_cpuid));
+	cpuinfo_set_xcr0(RYZEN_9_7950X_XCR0);
+	cpuinfo_initialize();
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -138,6 +138,11 @@ TEST(ISA, jscvt) {
 TEST(ISA, fcma) {
 	ASSERT_FALSE(cpuinfo_isa.fcma);
 }
+
+TEST(ISA_LEVEL, armv8_0) {
+	ASSERT_EQ(0, cpuinfo_get_armv8_level());
+	ASSERT_STREQ("armv8-a", cpuinfo_get_isa_level_name());
+}
 #endif /* CPUINFO_ARCH_ARM64 */
 
 TEST(L1I, count) {
@@ -332,6 +337,26 @@ TEST(L4, none) {
 	ASSERT_FALSE(l4.instances);
 }
 
+TEST(BLOCKING, temporal) {
+	const cpuinfo_working_set working_set = { 4, 2, cpuinfo_reuse_temporal, 0 };
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		const cpuinfo_blocking blocking = cpuinfo_get_blocking(&working_set, i);
+		ASSERT_EQ(3072, blocking.l1);
+		ASSERT_EQ(917504, blocking.l2);
+		ASSERT_EQ(0, blocking.l3);
+	}
+}
+
+TEST(BLOCKING, streaming) {
+	const cpuinfo_working_set working_set = { 4, 2, cpuinfo_reuse_streaming, 0 };
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		const cpuinfo_blocking blocking = cpuinfo_get_blocking(&working_set, i);
+		ASSERT_EQ(1536, blocking.l1);
+		ASSERT_EQ(458752, blocking.l2);
+		ASSERT_EQ(0, blocking.l3);
+	}
+}
+
 int main(int argc, char* argv[]) {
 	cpuinfo_set_proc_cpuinfo_path("test/cpuinfo/scaleway.log");
 	cpuinfo_initialize();
@@ -0,0 +1,256 @@
+#include <gtest/gtest.h>
+
+#include <cpuinfo.h>
+#include <cpuinfo-mock.h>
+
+#include "cpuid/xeon-gold-6148.h"
+
+
+TEST(PROCESSORS, non_null) {
+	ASSERT_TRUE(cpuinfo_processors);
+}
+
+TEST(PROCESSORS, vendor_intel) {
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		ASSERT_EQ(cpuinfo_vendor_intel, cpuinfo_processors[i].vendor);
+	}
+}
+
+TEST(PROCESSORS, uarch_sky_lake_server) {
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		ASSERT_EQ(cpuinfo_uarch_sky_lake_server, cpuinfo_processors[i].uarch);
+	}
+}
+
+TEST(L3, size) {
+	cpuinfo_caches l3 = cpuinfo_get_l3_cache();
+	for (uint32_t k = 0; k < l3.count; k++) {
+		ASSERT_EQ(28835840, l3.instances[k].size);
+	}
+}
+
+TEST(L3, non_inclusive) {
+	cpuinfo_caches l3 = cpuinfo_get_l3_cache();
+	for (uint32_t k = 0; k < l3.count; k++) {
+		/* Skylake-SP L3 is neither inclusive nor exclusive of L2 */
+		ASSERT_FALSE(l3.instances[k].flags & CPUINFO_CACHE_INCLUSIVE);
+		ASSERT_FALSE(l3.instances[k].flags & CPUINFO_CACHE_EXCLUSIVE);
+	}
+}
+
+TEST(L3, associativity) {
+	cpuinfo_caches l3 = cpuinfo_get_l3_cache();
+	for (uint32_t k = 0; k < l3.count; k++) {
+		ASSERT_EQ(11, l3.instances[k].associativity);
+	}
+}
+
+TEST(L3_ALLOCATION, classes) {
+	/* 16 classes of service in hardware, halved by the kernel when Code and Data Prioritization is enabled */
+	ASSERT_EQ(8, cpuinfo_get_qos().l3.classes);
+}
+
+TEST(L3_ALLOCATION, bitmask_length) {
+	ASSERT_EQ(11, cpuinfo_get_qos().l3.bitmask_length);
+}
+
+TEST(L3_ALLOCATION, shareable_bits) {
+	ASSERT_EQ(UINT32_C(0x600), cpuinfo_get_qos().l3.shareable_bits);
+}
+
+TEST(L3_ALLOCATION, ways_per_bit) {
+	ASSERT_EQ(1, cpuinfo_get_qos().l3.ways_per_bit);
+}
+
+TEST(L3_ALLOCATION, bytes_per_bit) {
+	ASSERT_EQ(2621440, cpuinfo_get_qos().l3.bytes_per_bit);
+}
+
+TEST(L3_ALLOCATION, cdp) {
+	ASSERT_TRUE(cpuinfo_get_qos().l3.cdp);
+}
+
+TEST(L2_ALLOCATION, none) {
+	ASSERT_EQ(0, cpuinfo_get_qos().l2.classes);
+	ASSERT_EQ(0, cpuinfo_get_qos().l2.bitmask_length);
+}
+
+TEST(MEMORY_BANDWIDTH_ALLOCATION, classes) {
+	ASSERT_EQ(8, cpuinfo_get_qos().memory_bandwidth.classes);
+}
+
+TEST(MEMORY_BANDWIDTH_ALLOCATION, max_throttling) {
+	ASSERT_EQ(90, cpuinfo_get_qos().memory_bandwidth.max_throttling);
+}
+
+TEST(MEMORY_BANDWIDTH_ALLOCATION, granularity) {
+	ASSERT_EQ(10, cpuinfo_get_qos().memory_bandwidth.granularity);
+}
+
+TEST(MEMORY_BANDWIDTH_ALLOCATION, linear) {
+	ASSERT_TRUE(cpuinfo_get_qos().memory_bandwidth.linear);
+}
+
+TEST(L3_MONITORING, rmids) {
+	ASSERT_EQ(192, cpuinfo_get_qos().l3_monitoring.rmids);
+}
+
+TEST(L3_MONITORING, upscaling_factor) {
+	ASSERT_EQ(57344, cpuinfo_get_qos().l3_monitoring.upscaling_factor);
+}
+
+TEST(L3_MONITORING, events) {
+	const cpuinfo_qos qos = cpuinfo_get_qos();
+	ASSERT_TRUE(qos.l3_monitoring.occupancy);
+	ASSERT_TRUE(qos.l3_monitoring.total_bandwidth);
+	ASSERT_TRUE(qos.l3_monitoring.local_bandwidth);
+}
+
+TEST(TSC, frequency) {
+	ASSERT_EQ(UINT64_C(2400000000), cpuinfo_get_tsc().frequency);
+}
+
+TEST(TSC, crystal_frequency) {
+	ASSERT_EQ(UINT64_C(25000000), cpuinfo_get_tsc().crystal_frequency);
+}
+
+TEST(TSC, base_frequency) {
+	ASSERT_EQ(UINT64_C(2400000000), cpuinfo_get_tsc().base_frequency);
+}
+
+TEST(TSC, max_frequency) {
+	ASSERT_EQ(UINT64_C(3700000000), cpuinfo_get_tsc().max_frequency);
+}
+
+TEST(TSC, bus_frequency) {
+	ASSERT_EQ(UINT64_C(100000000), cpuinfo_get_tsc().bus_frequency);
+}
+
+TEST(TSC, invariant) {
+	ASSERT_TRUE(cpuinfo_get_tsc().invariant);
+}
+
+TEST(TSC, not_calibrated) {
+	ASSERT_FALSE(cpuinfo_get_tsc().calibrated);
+}
+
+TEST(TSC, ticks_to_nanoseconds) {
+	ASSERT_EQ(UINT64_C(0), cpuinfo_tsc_ticks_to_nanoseconds(0));
+	ASSERT_EQ(UINT64_C(1000), cpuinfo_tsc_ticks_to_nanoseconds(2400));
+	ASSERT_EQ(UINT64_C(1000000000), cpuinfo_tsc_ticks_to_nanoseconds(UINT64_C(2400000000)));
+	/* One day */
+	ASSERT_EQ(UINT64_C(86400000000000), cpuinfo_tsc_ticks_to_nanoseconds(UINT64_C(207360000000000)));
+}
+
+TEST(XSAVE, enabled_components) {
+	ASSERT_EQ(UINT64_C(0x2FF), cpuinfo_get_xsave().enabled_components);
+}
+
+TEST(XSAVE, supervisor_components) {
+	ASSERT_EQ(UINT64_C(0x100), cpuinfo_get_xsave().supervisor_components);
+}
+
+TEST(XSAVE, enabled_size) {
+	ASSERT_EQ(2696, cpuinfo_get_xsave().enabled_size);
+}
+
+TEST(XSAVE, max_size) {
+	ASSERT_EQ(2696, cpuinfo_get_xsave().max_size);
+}
+
+TEST(XSAVE, compacted_size) {
+	ASSERT_EQ(2568, cpuinfo_get_xsave().compacted_size);
+}
+
+TEST(XSAVE, instructions) {
+	const cpuinfo_xsave xsave = cpuinfo_get_xsave();
+	ASSERT_TRUE(xsave.xsaveopt);
+	ASSERT_TRUE(xsave.xsavec);
+	ASSERT_TRUE(xsave.xgetbv1);
+	ASSERT_TRUE(xsave.xsaves);
+	ASSERT_FALSE(xsave.xfd);
+}
+
+TEST(XSAVE, avx_component) {
+	const cpuinfo_xsave_component avx = cpuinfo_get_xsave_component(2);
+	ASSERT_EQ(256, avx.size);
+	ASSERT_EQ(576, avx.offset);
+	ASSERT_EQ(576, avx.compacted_offset);
+}
+
+TEST(XSAVE, hi16_zmm_component) {
+	const cpuinfo_xsave_component hi16_zmm = cpuinfo_get_xsave_component(7);
+	ASSERT_EQ(1024, hi16_zmm.size);
+	ASSERT_EQ(1664, hi16_zmm.offset);
+	ASSERT_EQ(1536, hi16_zmm.compacted_offset);
+}
+
+TEST(XSAVE, pt_component) {
+	const cpuinfo_xsave_component pt = cpuinfo_get_xsave_component(8);
+	ASSERT_EQ(128, pt.size);
+	ASSERT_TRUE(pt.supervisor);
+	ASSERT_EQ(0, pt.compacted_offset);
+}
+
+TEST(XSAVE, unsupported_component) {
+	ASSERT_EQ(0, cpuinfo_get_xsave_component(10).size);
+	ASSERT_EQ(0, cpuinfo_get_xsave_component(CPUINFO_XSAVE_MAX_COMPONENTS).size);
+}
+
+TEST(ISA_LEVEL, x86_64_v4) {
+	ASSERT_EQ(4, cpuinfo_get_x86_64_level());
+	ASSERT_STREQ("x86-64-v4", cpuinfo_get_isa_level_name());
+}
+
+TEST(UARCH_INFO, sky_lake_server) {
+	const cpuinfo_uarch_info info = cpuinfo_get_uarch_info(cpuinfo_processors[0].uarch);
+	ASSERT_EQ(512, info.vector_width);
+	ASSERT_EQ(2, info.fma_per_cycle);
+	ASSERT_EQ(128, info.l1d_load_bytes_per_cycle);
+	ASSERT_EQ(64, info.l1d_store_bytes_per_cycle);
+	ASSERT_FALSE(info.split_wide_vectors);
+	ASSERT_TRUE(info.wide_vector_throttling);
+}
+
+TEST(UARCH_INFO, sky_lake_client) {
+	/* Client cores are characterized regardless of AVX-512 support of the host */
+	ASSERT_EQ(256, cpuinfo_get_uarch_info(cpuinfo_uarch_sky_lake).vector_width);
+}
+
+TEST(INSTRUCTION_COST, pdep) {
+	const cpuinfo_x86_instruction_cost cost =
+		cpuinfo_get_x86_instruction_cost(cpuinfo_processors[0].uarch, cpuinfo_x86_instruction_pdep_r64);
+	ASSERT_EQ(3, cost.latency);
+	ASSERT_EQ(100, cost.reciprocal_throughput);
+	ASSERT_FALSE(cost.microcoded);
+}
+
+TEST(INSTRUCTION_COST, vfmadd_ps_zmm) {
+	const cpuinfo_x86_instruction_cost cost =
+		cpuinfo_get_x86_instruction_cost(cpuinfo_processors[0].uarch, cpuinfo_x86_instruction_vfmadd_ps_zmm);
+	ASSERT_EQ(4, cost.latency);
+	ASSERT_EQ(50, cost.reciprocal_throughput);
+}
+
+TEST(INSTRUCTION_COST, client_vfmadd_ps_zmm_unknown) {
+	/* Client Sky Lake and Kaby Lake cores do not support AVX-512 */
+	ASSERT_EQ(0, cpuinfo_get_x86_instruction_cost(cpuinfo_uarch_sky_lake, cpuinfo_x86_instruction_vfmadd_ps_zmm).latency);
+	ASSERT_EQ(0, cpuinfo_get_x86_instruction_cost(cpuinfo_uarch_kaby_lake, cpuinfo_x86_instruction_vfmadd_ps_zmm).latency);
+	ASSERT_EQ(4, cpuinfo_get_x86_instruction_cost(cpuinfo_uarch_sky_lake, cpuinfo_x86_instruction_vfmadd_ps_ymm).latency);
+}
+
+TEST(INSTRUCTION_COST, vpermb_not_supported) {
+	/* AVX512 VBMI is not supported on Sky Lake server cores */
+	const cpuinfo_x86_instruction_cost cost =
+		cpuinfo_get_x86_instruction_cost(cpuinfo_processors[0].uarch, cpuinfo_x86_instruction_vpermb_zmm);
+	ASSERT_EQ(0, cost.latency);
+}
+
+int main(int argc, char* argv[]) {
+	cpuinfo_set_cpuid(xeon_gold_6148_cpuid, sizeof(xeon_gold_6148_cpuid) / sizeof(cpuinfo_mock_cpuid));
+	cpuinfo_set_xcr0(XEON_GOLD_6148_XCR0);
+	cpuinfo_set_resctrl_path("test/resctrl/xeon-gold-6148");
+	cpuinfo_initialize();
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
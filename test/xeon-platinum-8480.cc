@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <cpuinfo.h>
+#include <cpuinfo-mock.h>
+
+#include "cpuid/xeon-platinum-8480.h"
+
+
+TEST(PROCESSORS, non_null) {
+	ASSERT_TRUE(cpuinfo_processors);
+}
+
+TEST(PROCESSORS, vendor_intel) {
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		ASSERT_EQ(cpuinfo_vendor_intel, cpuinfo_processors[i].vendor);
+	}
+}
+
+TEST(PROCESSORS, uarch_golden_cove_server) {
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		ASSERT_EQ(cpuinfo_uarch_golden_cove_server, cpuinfo_processors[i].uarch);
+	}
+}
+
+TEST(UARCH_INFO, golden_cove_server) {
+	const cpuinfo_uarch_info info = cpuinfo_get_uarch_info(cpuinfo_processors[0].uarch);
+	ASSERT_EQ(512, info.vector_width);
+	ASSERT_EQ(2, info.fma_per_cycle);
+	ASSERT_TRUE(info.wide_vector_throttling);
+}
+
+TEST(ISA, avx2) {
+	ASSERT_TRUE(cpuinfo_isa.avx2);
+}
+
+TEST(ISA, avx512f) {
+	ASSERT_TRUE(cpuinfo_isa.avx512f);
+}
+
+TEST(ISA, avx512vl) {
+	ASSERT_TRUE(cpuinfo_isa.avx512vl);
+}
+
+TEST(ISA, avx512vbmi) {
+	ASSERT_TRUE(cpuinfo_isa.avx512vbmi);
+}
+
+TEST(ISA, avx512vbmi2) {
+	ASSERT_TRUE(cpuinfo_isa.avx512vbmi2);
+}
+
+TEST(ISA, avx512bitalg) {
+	ASSERT_TRUE(cpuinfo_isa.avx512bitalg);
+}
+
+TEST(ISA, avx512vnni) {
+	ASSERT_TRUE(cpuinfo_isa.avx512vnni);
+}
+
+TEST(ISA, avx512bf16) {
+	ASSERT_TRUE(cpuinfo_isa.avx512bf16);
+}
+
+TEST(ISA, avx_vnni) {
+	ASSERT_TRUE(cpuinfo_isa.avx_vnni);
+}
+
+TEST(ISA, gfni) {
+	ASSERT_TRUE(cpuinfo_isa.gfni);
+}
+
+TEST(ISA, vaes) {
+	ASSERT_TRUE(cpuinfo_isa.vaes);
+}
+
+TEST(ISA, vpclmulqdq) {
+	ASSERT_TRUE(cpuinfo_isa.vpclmulqdq);
+}
+
+TEST(ISA, amx_tile) {
+	ASSERT_TRUE(cpuinfo_isa.amx_tile);
+}
+
+TEST(ISA, amx_int8) {
+	ASSERT_TRUE(cpuinfo_isa.amx_int8);
+}
+
+TEST(ISA, amx_bf16) {
+	ASSERT_TRUE(cpuinfo_isa.amx_bf16);
+}
+
+TEST(AMX, max_palette) {
+	ASSERT_EQ(1, cpuinfo_get_amx().max_palette);
+}
+
+TEST(AMX, tiles) {
+	ASSERT_EQ(8, cpuinfo_get_amx().tiles);
+}
+
+TEST(AMX, max_rows) {
+	ASSERT_EQ(16, cpuinfo_get_amx().max_rows);
+}
+
+TEST(AMX, bytes_per_row) {
+	ASSERT_EQ(64, cpuinfo_get_amx().bytes_per_row);
+}
+
+TEST(AMX, bytes_per_tile) {
+	ASSERT_EQ(1024, cpuinfo_get_amx().bytes_per_tile);
+}
+
+TEST(AMX, total_tile_bytes) {
+	ASSERT_EQ(8192, cpuinfo_get_amx().total_tile_bytes);
+}
+
+TEST(AMX, tmul_max_k) {
+	ASSERT_EQ(16, cpuinfo_get_amx().tmul_max_k);
+}
+
+TEST(AMX, tmul_max_n) {
+	ASSERT_EQ(64, cpuinfo_get_amx().tmul_max_n);
+}
+
+TEST(XSAVE, enabled_size) {
+	ASSERT_EQ(11008, cpuinfo_get_xsave().enabled_size);
+}
+
+TEST(XSAVE, compacted_size) {
+	ASSERT_EQ(10752, cpuinfo_get_xsave().compacted_size);
+}
+
+TEST(XSAVE, xfd) {
+	ASSERT_TRUE(cpuinfo_get_xsave().xfd);
+}
+
+TEST(XSAVE, tile_config_component) {
+	const cpuinfo_xsave_component tilecfg = cpuinfo_get_xsave_component(17);
+	ASSERT_EQ(64, tilecfg.size);
+	ASSERT_EQ(2752, tilecfg.offset);
+	ASSERT_EQ(2496, tilecfg.compacted_offset);
+	ASSERT_TRUE(tilecfg.aligned);
+	ASSERT_FALSE(tilecfg.xfd);
+}
+
+TEST(XSAVE, tile_data_component) {
+	const cpuinfo_xsave_component tiledata = cpuinfo_get_xsave_component(18);
+	ASSERT_EQ(8192, tiledata.size);
+	ASSERT_EQ(2816, tiledata.offset);
+	ASSERT_EQ(2560, tiledata.compacted_offset);
+	ASSERT_TRUE(tiledata.aligned);
+	ASSERT_TRUE(tiledata.xfd);
+}
+
+TEST(ISA_LEVEL, x86_64_v4) {
+	ASSERT_EQ(4, cpuinfo_get_x86_64_level());
+	ASSERT_STREQ("x86-64-v4", cpuinfo_get_isa_level_name());
+}
+
+int main(int argc, char* argv[]) {
+	cpuinfo_set_cpuid(xeon_platinum_8480_cpuid, sizeof(xeon_platinum_8480_cpuid) / sizeof(cpuinfo_mock_cpuid));
+	cpuinfo_set_xcr0(XEON_PLATINUM_8480_XCR0);
+	cpuinfo_initialize();
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
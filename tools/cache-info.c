@@ -26,7 +26,13 @@ void report_cache(
 	if (level == 1) {
 		printf("%"PRIu32" %s, ", size, units);
 	} else {
-		printf("%"PRIu32" %s (%s), ", size, units, (cache->flags & CPUINFO_CACHE_INCLUSIVE) ? "inclusive" : "exclusive");
+		const char* inclusiveness = "non-inclusive";
+		if (cache->flags & CPUINFO_CACHE_INCLUSIVE) {
+			inclusiveness = "inclusive";
+		} else if (cache->flags & CPUINFO_CACHE_EXCLUSIVE) {
+			inclusiveness = "exclusive";
+		}
+		printf("%"PRIu32" %s (%s), ", size, units, inclusiveness);
 	}
 
 	if (cache->associativity * cache->line_size == cache->size) {
@@ -54,6 +60,21 @@ void report_cache(
 	}
 }
 
+void report_cache_allocation(const struct cpuinfo_cache_allocation allocation[restrict static 1], uint32_t level) {
+	printf("L%"PRIu32" allocation: %"PRIu32" classes, %"PRIu32"-bit capacity mask",
+		level, allocation->classes, allocation->bitmask_length);
+	if (allocation->ways_per_bit != 0) {
+		printf(" (%"PRIu32" ways per bit)", allocation->ways_per_bit);
+	}
+	if (allocation->shareable_bits != 0) {
+		printf(", shareable bits 0x%"PRIX32, allocation->shareable_bits);
+	}
+	if (allocation->cdp) {
+		printf(", code and data prioritization");
+	}
+	printf("\n");
+}
+
 int main(int argc, char** argv) {
 	cpuinfo_initialize();
 	if ((cpuinfo_get_l1i_cache().count != 0 && cpuinfo_get_l1i_cache().instances->flags & CPUINFO_CACHE_UNIFIED) == 0) {
@@ -71,4 +92,22 @@ int main(int argc, char** argv) {
 	if (cpuinfo_get_l4_cache().count != 0) {
 		report_cache(cpuinfo_get_l4_cache().count, cpuinfo_get_l4_cache().instances, 4, "data");
 	}
+
+	const struct cpuinfo_qos qos = cpuinfo_get_qos();
+	if (qos.l2.classes != 0) {
+		report_cache_allocation(&qos.l2, 2);
+	}
+	if (qos.l3.classes != 0) {
+		report_cache_allocation(&qos.l3, 3);
+	}
+	if (qos.memory_bandwidth.classes != 0) {
+		printf("Memory bandwidth allocation: %"PRIu32" classes", qos.memory_bandwidth.classes);
+		if (qos.memory_bandwidth.granularity != 0) {
+			printf(", %"PRIu32"%% granularity", qos.memory_bandwidth.granularity);
+		}
+		printf("\n");
+	}
+	if (qos.l3_monitoring.rmids != 0) {
+		printf("L3 monitoring: %"PRIu32" RMIDs\n", qos.l3_monitoring.rmids);
+	}
 }
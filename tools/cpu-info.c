@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <inttypes.h>
 
 #include <cpuinfo.h>
 
@@ -93,6 +94,21 @@ int main(int argc, char** argv) {
 		case cpuinfo_uarch_kaby_lake:
 			printf("uArch: Kaby Lake\n");
 			break;
+		case cpuinfo_uarch_sky_lake_server:
+			printf("uArch: Sky Lake server\n");
+			break;
+		case cpuinfo_uarch_golden_cove_server:
+			printf("uArch: Golden Cove server\n");
+			break;
+		case cpuinfo_uarch_golden_cove:
+			printf("uArch: Golden Cove\n");
+			break;
+		case cpuinfo_uarch_raptor_cove:
+			printf("uArch: Raptor Cove\n");
+			break;
+		case cpuinfo_uarch_redwood_cove:
+			printf("uArch: Redwood Cove\n");
+			break;
 		case cpuinfo_uarch_willamette:
 			printf("uArch: Willamette\n");
 			break;
@@ -111,6 +127,12 @@ int main(int argc, char** argv) {
 		case cpuinfo_uarch_airmont:
 			printf("uArch: Airmont\n");
 			break;
+		case cpuinfo_uarch_gracemont:
+			printf("uArch: Gracemont\n");
+			break;
+		case cpuinfo_uarch_crestmont:
+			printf("uArch: Crestmont\n");
+			break;
 		case cpuinfo_uarch_knights_ferry:
 			printf("uArch: Knights Ferry\n");
 			break;
@@ -156,6 +178,12 @@ int main(int argc, char** argv) {
 		case cpuinfo_uarch_zen:
 			printf("uArch: Zen\n");
 			break;
+		case cpuinfo_uarch_zen3:
+			printf("uArch: Zen 3\n");
+			break;
+		case cpuinfo_uarch_zen4:
+			printf("uArch: Zen 4\n");
+			break;
 		case cpuinfo_uarch_geode:
 			printf("uArch: Geode\n");
 			break;
@@ -252,4 +280,73 @@ int main(int argc, char** argv) {
 		default:
 			printf("uArch: other (0x%08X)\n", cpuinfo_processors[0].uarch);
 	}
+	const uint32_t performance_count = cpuinfo_get_core_type_processors(cpuinfo_core_type_performance, 0, NULL);
+	const uint32_t efficiency_count = cpuinfo_get_core_type_processors(cpuinfo_core_type_efficiency, 0, NULL);
+	if (performance_count + efficiency_count != 0) {
+		printf("Hybrid: %"PRIu32" performance, %"PRIu32" efficiency logical processors\n",
+			performance_count, efficiency_count);
+	}
+	for (uint32_t i = 0; i < cpuinfo_processors_count; i++) {
+		const struct cpuinfo_frequency_domain* domain = cpuinfo_processors[i].frequency_domain;
+		if (domain != NULL) {
+			printf("Processor %"PRIu32": %"PRIu64"-%"PRIu64" MHz", i,
+				domain->min_frequency / UINT64_C(1000000), domain->max_frequency / UINT64_C(1000000));
+			if (domain->base_frequency != 0) {
+				printf(", base %"PRIu64" MHz", domain->base_frequency / UINT64_C(1000000));
+			}
+			printf("\n");
+		}
+	}
+	const struct cpuinfo_hypervisor hypervisor = cpuinfo_get_hypervisor();
+	switch (hypervisor.vendor) {
+		case cpuinfo_hypervisor_vendor_none:
+			break;
+		case cpuinfo_hypervisor_vendor_kvm:
+			printf("Hypervisor: KVM\n");
+			break;
+		case cpuinfo_hypervisor_vendor_hyperv:
+			printf("Hypervisor: Hyper-V\n");
+			break;
+		case cpuinfo_hypervisor_vendor_xen:
+			printf("Hypervisor: Xen\n");
+			break;
+		case cpuinfo_hypervisor_vendor_vmware:
+			printf("Hypervisor: VMware\n");
+			break;
+		case cpuinfo_hypervisor_vendor_virtualbox:
+			printf("Hypervisor: VirtualBox\n");
+			break;
+		case cpuinfo_hypervisor_vendor_qemu:
+			printf("Hypervisor: QEMU (TCG)\n");
+			break;
+		case cpuinfo_hypervisor_vendor_bhyve:
+			printf("Hypervisor: bhyve\n");
+			break;
+		case cpuinfo_hypervisor_vendor_acrn:
+			printf("Hypervisor: ACRN\n");
+			break;
+		case cpuinfo_hypervisor_vendor_parallels:
+			printf("Hypervisor: Parallels\n");
+			break;
+		default:
+			printf("Hypervisor: unknown\n");
+	}
+	if (hypervisor.vendor != cpuinfo_hypervisor_vendor_none) {
+		printf("\tsteal time: %s, dedicated processors: %s\n",
+			hypervisor.steal_time ? "yes" : "no",
+			hypervisor.dedicated_processors ? "yes" : "no");
+	}
+#if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
+	const struct cpuinfo_tsc tsc = cpuinfo_get_tsc();
+	if (tsc.frequency != 0) {
+		printf("TSC: %"PRIu64" Hz (%s%s)\n", tsc.frequency,
+			tsc.invariant ? "invariant" : "variant",
+			tsc.calibrated ? ", calibrated" : "");
+	}
+	const struct cpuinfo_xsave xsave = cpuinfo_get_xsave();
+	if (xsave.enabled_size != 0) {
+		printf("XSAVE area: %"PRIu32" bytes, %"PRIu32" bytes compacted, %"PRIu32" bytes for all components\n",
+			xsave.enabled_size, xsave.compacted_size, xsave.max_size);
+	}
+#endif
 }
@@ -1,10 +1,22 @@
 #include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
 
 #include <cpuinfo.h>
 
 int main(int argc, char** argv) {
 	cpuinfo_initialize();
 
+	/* Single-line output for launchers which choose between builds of a library */
+	if (argc == 2 && strcmp(argv[1], "--level") == 0) {
+		const char* level = cpuinfo_get_isa_level_name();
+		if (level == NULL) {
+			return 1;
+		}
+		printf("%s\n", level);
+		return 0;
+	}
+
 #if CPUINFO_ARCH_X86 || CPUINFO_ARCH_X86_64
 
 	printf("Scalar instructions:\n");
@@ -69,6 +81,14 @@ int main(int argc, char** argv) {
 		printf("\tAVX512VPOPCNTDQ: %s\n", cpuinfo_isa.avx512vpopcntdq ? "yes" : "no");
 		printf("\tAVX512_4VNNIW: %s\n", cpuinfo_isa.avx512_4vnniw ? "yes" : "no");
 		printf("\tAVX512_4FMAPS: %s\n", cpuinfo_isa.avx512_4fmaps ? "yes" : "no");
+		printf("\tAVX512VBMI2: %s\n", cpuinfo_isa.avx512vbmi2 ? "yes" : "no");
+		printf("\tAVX512BITALG: %s\n", cpuinfo_isa.avx512bitalg ? "yes" : "no");
+		printf("\tAVX512VNNI: %s\n", cpuinfo_isa.avx512vnni ? "yes" : "no");
+		printf("\tAVX512BF16: %s\n", cpuinfo_isa.avx512bf16 ? "yes" : "no");
+		printf("\tAVX-VNNI: %s\n", cpuinfo_isa.avx_vnni ? "yes" : "no");
+		printf("\tAMX-TILE: %s\n", cpuinfo_isa.amx_tile ? "yes" : "no");
+		printf("\tAMX-INT8: %s\n", cpuinfo_isa.amx_int8 ? "yes" : "no");
+		printf("\tAMX-BF16: %s\n", cpuinfo_isa.amx_bf16 ? "yes" : "no");
 
 
 	printf("Multi-threading extensions:\n");
@@ -87,6 +107,9 @@ int main(int argc, char** argv) {
 	printf("Cryptography extensions:\n");
 		printf("\tAES: %s\n", cpuinfo_isa.aes ? "yes" : "no");
 		printf("\tPCLMULQDQ: %s\n", cpuinfo_isa.pclmulqdq ? "yes" : "no");
+		printf("\tGFNI: %s\n", cpuinfo_isa.gfni ? "yes" : "no");
+		printf("\tVAES: %s\n", cpuinfo_isa.vaes ? "yes" : "no");
+		printf("\tVPCLMULQDQ: %s\n", cpuinfo_isa.vpclmulqdq ? "yes" : "no");
 		printf("\tRDRAND: %s\n", cpuinfo_isa.rdrand ? "yes" : "no");
 		printf("\tRDSEED: %s\n", cpuinfo_isa.rdseed ? "yes" : "no");
 		printf("\tSHA: %s\n", cpuinfo_isa.sha ? "yes" : "no");
@@ -160,11 +183,41 @@ int main(int argc, char** argv) {
 		printf("\tARM v8.2 FP16 arithmetics: %s\n", cpuinfo_isa.fp16arith ? "yes" : "no");
 		printf("\tARM v8.3 JS conversion: %s\n", cpuinfo_isa.jscvt ? "yes" : "no");
 		printf("\tARM v8.3 complex FMA: %s\n", cpuinfo_isa.fcma ? "yes" : "no");
+		printf("\tARM v8.3 RCpc loads: %s\n", cpuinfo_isa.lrcpc ? "yes" : "no");
+		printf("\tARM v8.4 RCpc unscaled loads/stores: %s\n", cpuinfo_isa.lrcpc2 ? "yes" : "no");
+		printf("\tARM v8.2 DC CVAP: %s\n", cpuinfo_isa.dcpop ? "yes" : "no");
+		printf("\tARM v8.5 DC CVADP: %s\n", cpuinfo_isa.dcpodp ? "yes" : "no");
+		printf("\tARM v8.4 flag manipulation: %s\n", cpuinfo_isa.flagm ? "yes" : "no");
+		printf("\tARM v8.5 flag manipulation: %s\n", cpuinfo_isa.flagm2 ? "yes" : "no");
+		printf("\tARM v8.5 FRINT: %s\n", cpuinfo_isa.frint ? "yes" : "no");
+		printf("\tARM v8.5 speculation barrier: %s\n", cpuinfo_isa.sb ? "yes" : "no");
+
+	printf("SIMD extensions:\n");
+		printf("\tARM v8.2 FP16 multiply-accumulate long: %s\n", cpuinfo_isa.fhm ? "yes" : "no");
+		printf("\tARM v8.2 dot product: %s\n", cpuinfo_isa.dot ? "yes" : "no");
+		printf("\tARM v8.6 INT8 matrix multiply: %s\n", cpuinfo_isa.i8mm ? "yes" : "no");
+		printf("\tARM v8.6 BF16: %s\n", cpuinfo_isa.bf16 ? "yes" : "no");
+		printf("\tSVE: %s\n", cpuinfo_isa.sve ? "yes" : "no");
+		printf("\tSVE 2: %s\n", cpuinfo_isa.sve2 ? "yes" : "no");
+		printf("\tSVE BF16: %s\n", cpuinfo_isa.svebf16 ? "yes" : "no");
+		printf("\tSVE INT8 matrix multiply: %s\n", cpuinfo_isa.svei8mm ? "yes" : "no");
+		printf("\tSME: %s\n", cpuinfo_isa.sme ? "yes" : "no");
+#if defined(__linux__)
+		if (cpuinfo_isa.sve) {
+			const struct cpuinfo_arm_sve sve = cpuinfo_get_sve();
+			printf("\tSVE vector length: %"PRIu32" bytes (default %"PRIu32", max %"PRIu32")\n",
+				sve.vector_length, sve.default_vector_length, cpuinfo_probe_sve_max_vector_length());
+		}
+#endif
 
 	printf("Cryptography extensions:\n");
 		printf("\tAES: %s\n", cpuinfo_isa.aes ? "yes" : "no");
 		printf("\tSHA1: %s\n", cpuinfo_isa.sha1 ? "yes" : "no");
 		printf("\tSHA2: %s\n", cpuinfo_isa.sha2 ? "yes" : "no");
+		printf("\tSHA3: %s\n", cpuinfo_isa.sha3 ? "yes" : "no");
+		printf("\tSHA512: %s\n", cpuinfo_isa.sha512 ? "yes" : "no");
+		printf("\tSM3: %s\n", cpuinfo_isa.sm3 ? "yes" : "no");
+		printf("\tSM4: %s\n", cpuinfo_isa.sm4 ? "yes" : "no");
 		printf("\tPMULL: %s\n", cpuinfo_isa.pmull ? "yes" : "no");
 		printf("\tCRC32: %s\n", cpuinfo_isa.crc32 ? "yes" : "no");
 #endif